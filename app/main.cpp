@@ -1,15 +1,47 @@
-#include "alphabets.hpp"       // itsp3::asciiAlphabet
+#include "alphabets.hpp"       // itsp3::printableAlphabet, itsp3::asciiAlphabet
 #include "bcrypt.hpp"          // itsp3::Bcrypt
-#include "bruteforce.hpp"      // itsp3::bruteforce
+#include "bcrypt_kernel.hpp"   // itsp3::laneCount, itsp3::bestBcryptIsa
+#include "bruteforce.hpp" // itsp3::NoMatchInBruteforceAlgorithmException
+#include "candidate_batch.hpp" // itsp3::CandidateBatch
+#include "check_password.hpp" // itsp3::PasswordPolicy
+#include "checkpoint.hpp" // itsp3::Checkpoint, itsp3::Checkpointer
+#include "crack_target.hpp"    // itsp3::CrackTarget
+#include "dictionary_attack.hpp" // itsp3::dictionaryAttack
 #include "log.hpp"             // ITSP3_LOG
+#include "mapped_file.hpp"     // itsp3::MappedFile
+#include "mask.hpp"            // itsp3::Mask, itsp3::maskAttack
+#include "parallel_bruteforce.hpp" // itsp3::parallelBatchBruteforce, ...
+#include "progress.hpp" // itsp3::ProgressCounters, itsp3::ProgressReporter
+#include "rules.hpp"           // itsp3::RuleSet
+#include "replication.hpp" // itsp3::ReplicationPrimary, itsp3::ReplicationFollower
 #include "string_scrubber.hpp" // itsp3::StringScrubber
-#include <ciso646>             // not, and
+#include "target_set.hpp"      // itsp3::TargetSet
+#include <algorithm>           // std::find, std::max
+#include <ciso646>             // not, and, or
 #include <cstddef>             // std::size_t
-#include <cstdlib>             // EXIT_SUCCESS
+#include <cstdio>              // std::remove
+#include <cstdlib>             // EXIT_SUCCESS, EXIT_FAILURE
 #include <iostream>            // std::cout
+#include <optional>            // std::optional
+#include <sstream>             // std::istringstream
+#include <thread>              // std::thread
+#include <string_view>         // std::string_view
+#include <utility>             // std::move
+#include <vector>              // std::vector
 
 namespace itsp3 {
 namespace {
+/*!
+ * \brief The file the progress of cracking a password is saved to.
+ **/
+constexpr char checkpointFilePath[]{"./crack_checkpoint.bin"};
+
+/*!
+ * \brief The file the throughput and progress of cracking a password are
+ *        written to while cracking, for monitoring.
+ **/
+constexpr char statsFilePath[]{"./crack_stats.json"};
+
 void addUser(Bcrypt& bcrypt)
 {
   std::string username{};
@@ -33,6 +65,10 @@ void addUser(Bcrypt& bcrypt)
   }
 
   std::cout << "Added user \"" << username << "\"\n";
+
+  if (const std::optional<std::string>& warning{retVal.getWarning()}) {
+    std::cout << "Warning: " << *warning << '\n';
+  }
 }
 
 void checkPasswordValidity(Bcrypt& bcrypt)
@@ -60,46 +96,429 @@ void checkPasswordValidity(Bcrypt& bcrypt)
   std::cout << "Password ok.\n";
 }
 
+/*!
+ * \brief Prepares cracking the password of a user, reports failures.
+ * \param bcrypt The Bcrypt object to look the user up in.
+ * \param username The username whose password to crack.
+ * \return The CrackTarget or a nullopt on failure.
+ **/
+std::optional<CrackTarget> prepareCrackTarget(
+  Bcrypt&            bcrypt,
+  const std::string& username)
+{
+  try {
+    std::optional<CrackTarget> target{bcrypt.prepareCrackTarget(username)};
+
+    if (not target) {
+      std::cerr << "There is no user \"" << username << "\"\n";
+    }
+
+    return target;
+  }
+  catch (const CrackTargetException& ex) {
+    std::cerr << "Can't crack the password of \"" << username
+              << "\": " << ex.what() << '\n';
+    return std::nullopt;
+  }
+}
+
+/*!
+ * \brief Checks a candidate of a mask or a wordlist against a target.
+ * \param target The target.
+ * \param policy The policy the password of the target satisfies.
+ * \param candidate The candidate password.
+ * \return true if 'candidate' is the password of 'target'.
+ * \note Candidates longer than target.getMaxPasswordLength() are hashed
+ *       as they are, rather than skipped like CrackTarget::isWorthChecking
+ *       would. Their prefix that stands in for them need not be among the
+ *       candidates of a mask or a wordlist.
+ **/
+bool isPasswordOf(
+  const CrackTarget&    target,
+  const PasswordPolicy& policy,
+  std::string_view      candidate)
+{
+  return (candidate.size() > target.getMaxPasswordLength()
+          or target.isWorthChecking(candidate, policy))
+         and target.check(candidate);
+}
+
+void crackPassword(Bcrypt& bcrypt, Checkpoint checkpoint)
+{
+  const std::string username{checkpoint.getTarget()};
+  std::string       password{};
+
+  const std::optional<CrackTarget> target{
+    prepareCrackTarget(bcrypt, username)};
+
+  if (not target) {
+    return;
+  }
+
+  try {
+    std::cout << "Cracking password of user \"" << username << '"' << '\n'
+              << "This will take a long time, be patient...\n"
+              << "The progress is saved to \"" << checkpointFilePath
+              << "\", restart with --resume to continue.\n"
+              << "Statistics are written to \"" << statsFilePath << "\".\n";
+
+    // checkpoints saved before the printable alphabet became the default
+    // are resumed with the alphabet they were saved with.
+    const bool isAsciiCheckpoint{
+      checkpoint.getAlphabet()
+      == std::string_view{asciiAlphabet.data(), asciiAlphabet.size()}};
+
+    Checkpointer checkpointer{checkpointFilePath, std::move(checkpoint)};
+
+    // passwords the policy rejects could never have been set, so they
+    // are skipped without paying for the hash.
+    const PasswordPolicy policy{PasswordPolicy::active()};
+
+    // longer candidates have the hash of a shorter one, see
+    // CrackTarget::isWorthChecking.
+    ParallelBruteforceOptions options{};
+    options.minLength = policy.minLength;
+    options.maxLength
+      = std::max(policy.minLength, target->getMaxPasswordLength());
+    options.threadCount  = std::thread::hardware_concurrency();
+    options.checkpointer = &checkpointer;
+
+    // the candidates are hashed as many at a time as the CPU supports.
+    options.batchSize = laneCount(bestBcryptIsa());
+
+    ProgressCounters progress{options.threadCount};
+    options.progress = &progress;
+
+    // reports until cracking has finished.
+    const ProgressReporter reporter{progress, std::cerr, statsFilePath};
+
+    // CrackTarget::findIn may be called from several threads at once.
+    const auto findMatch = [&target, &policy](const CandidateBatch& batch) {
+      return target->findIn(batch, policy);
+    };
+
+    password
+      = isAsciiCheckpoint
+          ? parallelBatchBruteforce(findMatch, asciiAlphabet, options)
+          : parallelBatchBruteforce(findMatch, printableAlphabet, options);
+  }
+  catch (const NoMatchInBruteforceAlgorithmException& ex) {
+    std::cerr << "Failed to crack password for user: \"" << username << '"'
+              << ": " << ex.what() << '\n';
+    std::remove(checkpointFilePath);
+    return;
+  }
+  catch (const CheckpointException& ex) {
+    std::cerr << "Failed to save the progress: " << ex.what() << '\n';
+    return;
+  }
+
+  std::remove(checkpointFilePath);
+
+  std::cout << "The password of \"" << username << "\" is: \"" << password
+            << "\"\n";
+}
+
 void crackPassword(Bcrypt& bcrypt)
 {
   std::string username{};
 
   std::cout << "Enter the username to crack the password of: ";
   std::getline(std::cin, username);
-  std::string password{};
 
+  crackPassword(
+    bcrypt,
+    Checkpoint{
+      username,
+      std::string{printableAlphabet.begin(), printableAlphabet.end()}});
+}
+
+void resumeCrackingPassword(Bcrypt& bcrypt)
+{
   try {
-    std::cout << "Cracking password of user \"" << username << '"' << '\n'
-              << "This will take a long time, be patient...\n";
+    Checkpoint checkpoint{Checkpoint::load(checkpointFilePath)};
+
+    std::cout << "Resuming at password length " << checkpoint.getWordLength()
+              << '\n';
+
+    crackPassword(bcrypt, std::move(checkpoint));
+  }
+  catch (const CheckpointException& ex) {
+    std::cerr << "Failed to resume: " << ex.what() << '\n';
+  }
+}
+
+void crackPasswordWithMask(Bcrypt& bcrypt)
+{
+  std::string username{};
+  std::string maskString{};
+
+  std::cout << "Enter the username to crack the password of: ";
+  std::getline(std::cin, username);
+  std::cout << "Enter the mask (e.g. ?u?l?l?l?l?l?l?d?d?s): ";
+  std::getline(std::cin, maskString);
+
+  const std::optional<CrackTarget> target{
+    prepareCrackTarget(bcrypt, username)};
+
+  if (not target) {
+    return;
+  }
+
+  try {
+    const Mask parsedMask{Mask::parse(maskString)};
+
+    // the words of the mask that only differ beyond the characters bcrypt
+    // uses have the same hash, so one of them is enough.
+    const Mask mask{parsedMask.prefix(target->getMaxPasswordLength())};
+
+    if (mask.getLength() < parsedMask.getLength()) {
+      std::cout << "Only the first " << mask.getLength()
+                << " characters of the mask affect the hash\n";
+    }
+
+    std::cout << "Trying the " << static_cast<long double>(mask.size())
+              << " passwords of the mask for user \"" << username
+              << "\"\n";
+
+    const PasswordPolicy policy{PasswordPolicy::active()};
 
-    password = bruteforce(
-      [&username, &bcrypt](std::string_view test) {
-        return bcrypt.checkPasswordValidity(username, test);
+    const std::string password{maskAttack(
+      [&target, &policy](std::string_view test) {
+        return isPasswordOf(*target, policy, test);
       },
-      asciiAlphabet);
+      mask)};
+
+    std::cout << "The password of \"" << username << "\" is: \"" << password
+              << "\"\n";
+  }
+  catch (const InvalidMaskException& ex) {
+    std::cerr << "Invalid mask: " << ex.what() << '\n';
+  }
+  catch (const KeyspaceTooLargeException& ex) {
+    std::cerr << "The mask is too large: " << ex.what() << '\n';
   }
   catch (const NoMatchInBruteforceAlgorithmException& ex) {
     std::cerr << "Failed to crack password for user: \"" << username << '"'
               << ": " << ex.what() << '\n';
+  }
+}
+
+void crackPasswordWithWordlist(Bcrypt& bcrypt)
+{
+  std::string username{};
+  std::string wordlistFilePath{};
+  std::string rulesFilePath{};
+
+  std::cout << "Enter the username to crack the password of: ";
+  std::getline(std::cin, username);
+  std::cout << "Enter the path of the wordlist: ";
+  std::getline(std::cin, wordlistFilePath);
+  std::cout << "Enter the path of the rules (empty for none): ";
+  std::getline(std::cin, rulesFilePath);
+
+  const std::optional<CrackTarget> target{
+    prepareCrackTarget(bcrypt, username)};
+
+  if (not target) {
     return;
   }
 
-  std::cout << "The password of \"" << username << "\" is: \"" << password
-            << "\"\n";
+  try {
+    const MappedFile wordlist{wordlistFilePath};
+
+    std::optional<RuleSet> rules{};
+
+    if (not rulesFilePath.empty()) {
+      rules = RuleSet::parse(MappedFile{rulesFilePath}.getContents());
+    }
+
+    DictionaryAttackOptions options{};
+    options.rules = rules ? &*rules : nullptr;
+    options.onProgress = [](const DictionaryProgress& progress) {
+      std::cerr << "\r" << progress.byteOffset << " / " << progress.totalBytes
+                << " bytes, " << progress.candidateCount << " words tried"
+                << std::flush;
+    };
+
+    const PasswordPolicy policy{PasswordPolicy::active()};
+
+    const std::string password{dictionaryAttack(
+      [&target, &policy](std::string_view test) {
+        return isPasswordOf(*target, policy, test);
+      },
+      wordlist.getContents(),
+      options)};
+
+    std::cout << "\nThe password of \"" << username << "\" is: \""
+              << password << "\"\n";
+  }
+  catch (const MappedFileException& ex) {
+    std::cerr << "Could not read the file: " << ex.what() << '\n';
+  }
+  catch (const RuleParseException& ex) {
+    std::cerr << "Invalid rules: " << ex.what() << '\n';
+  }
+  catch (const NoMatchInBruteforceAlgorithmException& ex) {
+    std::cerr << "\nFailed to crack password for user: \"" << username
+              << '"' << ": " << ex.what() << '\n';
+  }
+}
+
+void crackAllPasswords(Bcrypt& bcrypt)
+{
+  std::string usernamesLine{};
+
+  std::cout << "Enter the usernames to crack, separated by spaces "
+               "(empty for all): ";
+  std::getline(std::cin, usernamesLine);
+
+  std::vector<std::string> usernames{};
+  std::istringstream       iss{usernamesLine};
+
+  for (std::string username{}; iss >> username;) {
+    usernames.push_back(std::move(username));
+  }
+
+  try {
+    std::vector<CrackTarget> targets{bcrypt.prepareCrackTargets(
+      [&usernames](std::string_view username) {
+        return usernames.empty()
+               or std::find(usernames.begin(), usernames.end(), username)
+                    != usernames.end();
+      })};
+
+    if (targets.empty()) {
+      std::cerr << "There are no users to crack.\n";
+      return;
+    }
+
+    const PasswordPolicy policy{PasswordPolicy::active()};
+
+    std::cout << "Cracking the passwords of " << targets.size()
+              << " users\n";
+
+    TargetSet targetSet{
+      std::move(targets),
+      [](const CrackTarget& target, std::string_view password) {
+        std::cout << "The password of \"" << target.getUsername()
+                  << "\" is: \"" << password << '"' << std::endl;
+      },
+      policy};
+
+    ParallelBruteforceOptions options{};
+    options.minLength = policy.minLength;
+    options.maxLength = targetSet.getMaxPasswordLength();
+    options.batchSize = laneCount(bestBcryptIsa());
+
+    try {
+      parallelBatchBruteforce(
+        [&targetSet](const CandidateBatch& batch) {
+          return targetSet.checkBatch(batch);
+        },
+        printableAlphabet,
+        options);
+    }
+    catch (const NoMatchInBruteforceAlgorithmException& ex) {
+      std::cerr << "Failed to crack the passwords of "
+                << targetSet.getRemainingCount() << " users: " << ex.what()
+                << '\n';
+    }
+  }
+  catch (const CrackTargetException& ex) {
+    std::cerr << "Can't crack the passwords: " << ex.what() << '\n';
+  }
+}
+
+void runReplicationPrimary()
+{
+  std::string socketPath{};
+
+  std::cout << "Enter the socket path to listen on: ";
+  std::getline(std::cin, socketPath);
+
+  try {
+    ReplicationPrimary primary{"./data.bin", socketPath};
+    primary.start();
+
+    std::cout << "Replicating \"./data.bin\", press enter to stop.\n";
+    std::string dummy{};
+    std::getline(std::cin, dummy);
+  }
+  catch (const ReplicationException& ex) {
+    std::cerr << "Replication failed: " << ex.what() << '\n';
+  }
+}
+
+void runReplicationFollower()
+{
+  std::string socketPath{};
+  std::string localFilePath{};
+
+  std::cout << "Enter the socket path of the primary: ";
+  std::getline(std::cin, socketPath);
+  std::cout << "Enter the path of the local copy: ";
+  std::getline(std::cin, localFilePath);
+
+  try {
+    ReplicationFollower follower{localFilePath, socketPath};
+    follower.start();
+
+    for (;;) {
+      std::string username{};
+      std::string password{};
+
+      StringScrubber pwScrubber{password};
+
+      std::cout << "Enter username (empty to stop): ";
+      std::getline(std::cin, username);
+
+      if (username.empty()) {
+        return;
+      }
+
+      std::cout << "Enter password: ";
+      std::getline(std::cin, password);
+
+      std::cout << (follower.checkPasswordValidity(username, password)
+                      ? "Password ok.\n"
+                      : "Password invalid\n")
+                << "Replication lag: " << follower.getLagBytes() << " bytes"
+                << (follower.isConnected() ? "" : " (disconnected)") << '\n';
+    }
+  }
+  catch (const ReplicationException& ex) {
+    std::cerr << "Replication failed: " << ex.what() << '\n';
+  }
 }
 } // anonymous namespace
 } // namespace itsp3a
 
-int main()
+int main(int argc, char* argv[])
 {
   itsp3::Bcrypt bcrypt{"./data.bin"};
 
+  if (argc == 2 and std::string_view{argv[1]} == "--resume") {
+    itsp3::resumeCrackingPassword(bcrypt);
+    return EXIT_SUCCESS;
+  }
+
+  if (argc != 1) {
+    std::cerr << "Usage: " << argv[0] << " [--resume]\n";
+    return EXIT_FAILURE;
+  }
+
   std::string input{};
 
   for (;;) {
     std::cout << "[A] Add user\n"
                  "[B] Check password\n"
-                 "[C] Crack password\n";
+                 "[C] Crack password\n"
+                 "[M] Crack password using a mask\n"
+                 "[D] Crack password using a wordlist\n"
+                 "[U] Crack the passwords of all users\n"
+                 "[P] Run as replication primary\n"
+                 "[F] Run as replication follower\n";
     std::getline(std::cin, input);
 
     if (input == "A") {
@@ -114,5 +533,25 @@ int main()
       itsp3::crackPassword(bcrypt);
       return EXIT_SUCCESS;
     }
+    else if (input == "M") {
+      itsp3::crackPasswordWithMask(bcrypt);
+      return EXIT_SUCCESS;
+    }
+    else if (input == "D") {
+      itsp3::crackPasswordWithWordlist(bcrypt);
+      return EXIT_SUCCESS;
+    }
+    else if (input == "U") {
+      itsp3::crackAllPasswords(bcrypt);
+      return EXIT_SUCCESS;
+    }
+    else if (input == "P") {
+      itsp3::runReplicationPrimary();
+      return EXIT_SUCCESS;
+    }
+    else if (input == "F") {
+      itsp3::runReplicationFollower();
+      return EXIT_SUCCESS;
+    }
   }
 }
@@ -0,0 +1,87 @@
+#include "bcrypt_kernel.hpp" // itsp3::bcryptHashBatch, itsp3::BcryptIsa
+#include "benchmark.hpp"     // ITSP3_BENCHMARK, itsp3::bench::report
+#include <bcrypt.h>          // bcrypt_hashpw, BCRYPT_HASHSIZE
+#include <chrono>            // std::chrono::duration
+#include <ciso646>           // not
+#include <cstddef>           // std::size_t
+#include <cstdio>            // std::printf
+#include <sstream>           // std::ostringstream
+#include <string>            // std::string, std::to_string
+#include <string_view>       // std::string_view
+#include <vector>            // std::vector
+
+namespace {
+/*!
+ * \brief The setting to hash with, the minimum cost so that the benchmark
+ *        does not take too long.
+ **/
+constexpr char setting[] = "$2a$04$CCCCCCCCCCCCCCCCCCCCC.";
+
+/*!
+ * \brief The amount of keys to hash, a multiple of all the lane counts.
+ **/
+constexpr std::size_t keyCount{256U};
+
+/*!
+ * \brief Module local function to print a measurement of bcrypt along
+ *        with the hashes per second.
+ * \param label Describes what was measured.
+ * \param duration The duration it took to hash keyCount keys.
+ **/
+void reportHashes(
+  const std::string&            label,
+  itsp3::bench::clock::duration duration)
+{
+  itsp3::bench::report(label, keyCount, duration);
+
+  const double seconds{std::chrono::duration<double>{duration}.count()};
+  std::printf(
+    "  %-40s %14.1f hashes/s\n",
+    label.c_str(),
+    seconds == 0.0 ? 0.0 : static_cast<double>(keyCount) / seconds);
+}
+} // anonymous namespace
+
+ITSP3_BENCHMARK(bcryptKernel)
+{
+  using itsp3::bench::clock;
+
+  std::vector<std::string> keys{};
+
+  for (std::size_t i{0U}; i < keyCount; ++i) {
+    keys.push_back("password" + std::to_string(i));
+  }
+
+  clock::time_point start{clock::now()};
+
+  for (const std::string& key : keys) {
+    char hash[BCRYPT_HASHSIZE];
+    bcrypt_hashpw(key.c_str(), setting, hash);
+    itsp3::bench::doNotOptimize(hash);
+  }
+
+  reportHashes("bcrypt library", clock::now() - start);
+
+  const std::vector<std::string_view> views(keys.begin(), keys.end());
+  const itsp3::BcryptSetting parsed{itsp3::BcryptSetting::parse(setting)};
+  std::vector<itsp3::BcryptDigest> digests(keyCount);
+
+  for (itsp3::BcryptIsa isa :
+       {itsp3::BcryptIsa::Scalar,
+        itsp3::BcryptIsa::Sse41,
+        itsp3::BcryptIsa::Avx2,
+        itsp3::BcryptIsa::Avx512}) {
+    if (not itsp3::isSupported(isa)) {
+      continue;
+    }
+
+    std::ostringstream label{};
+    label << "kernel " << isa;
+
+    start = clock::now();
+    itsp3::bcryptHashBatch(
+      views.data(), views.size(), parsed, digests.data(), isa);
+    itsp3::bench::doNotOptimize(digests);
+    reportHashes(label.str(), clock::now() - start);
+  }
+}
@@ -0,0 +1,70 @@
+/*!
+ * \file benchmark.hpp
+ * \brief Exports a minimal framework for microbenchmarks.
+ **/
+#ifndef INCG_ITSP3_BENCHMARK_HPP
+#define INCG_ITSP3_BENCHMARK_HPP
+#include <chrono>      // std::chrono::steady_clock
+#include <cstdint>     // std::uint64_t
+#include <string>      // std::string
+#include <string_view> // std::string_view
+#include <utility>     // std::pair
+#include <vector>      // std::vector
+
+/*!
+ * \brief Defines a benchmark function that is run by the benchmark
+ *        executable.
+ * \param name The name of the benchmark, must be a valid identifier.
+ **/
+#define ITSP3_BENCHMARK(name)                                          \
+  static void name();                                                  \
+  static const ::itsp3::bench::Registrar name##Registrar{#name, &name}; \
+  static void name()
+
+namespace itsp3 {
+namespace bench {
+using clock             = std::chrono::steady_clock;
+using BenchmarkFunction = void (*)();
+
+/*!
+ * \brief Fetches all the benchmarks registered.
+ * \return The names and functions of the benchmarks.
+ **/
+std::vector<std::pair<std::string, BenchmarkFunction>>& benchmarks();
+
+/*!
+ * \brief Registers a benchmark on construction.
+ * \note Use ITSP3_BENCHMARK rather than using this type directly.
+ **/
+class Registrar {
+public:
+  Registrar(std::string name, BenchmarkFunction function);
+};
+
+/*!
+ * \brief Prints the result of a measurement.
+ * \param label Describes what was measured.
+ * \param itemCount The amount of items processed.
+ * \param duration The duration it took.
+ *
+ * Prints the nanoseconds per item, so that measurements of different
+ * sizes can be compared.
+ **/
+void report(
+  std::string_view  label,
+  std::uint64_t     itemCount,
+  clock::duration   duration);
+
+/*!
+ * \brief Prevents the compiler from optimizing away the computation of
+ *        a value.
+ * \param value The value to keep.
+ **/
+template<typename Type>
+void doNotOptimize(const Type& value)
+{
+  asm volatile("" : : "g"(&value) : "memory");
+}
+} // namespace bench
+} // namespace itsp3
+#endif // INCG_ITSP3_BENCHMARK_HPP
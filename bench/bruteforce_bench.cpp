@@ -0,0 +1,220 @@
+#include "alphabets.hpp"           // itsp3::makeAlphabet
+#include "benchmark.hpp"           // ITSP3_BENCHMARK, itsp3::bench::report
+#include "bruteforce.hpp"          // itsp3::bruteforce, ...
+#include "odometer.hpp"            // itsp3::Odometer
+#include "parallel_bruteforce.hpp" // itsp3::parallelBruteforce, ...
+#include "progress.hpp"            // itsp3::ProgressCounters
+#include "search_limits.hpp"       // itsp3::CancellationToken
+#include <algorithm>               // std::max
+#include <chrono>                  // std::chrono::hours
+#include <cstddef>                 // std::size_t
+#include <cstdint>                 // std::uint64_t
+#include <limits>                  // std::numeric_limits
+#include <string>                  // std::string, std::to_string
+#include <string_view>             // std::string_view
+#include <thread>                  // std::thread
+#include <vector>                  // std::vector
+
+namespace {
+constexpr auto alphabet = itsp3::makeAlphabet<'a', 'k'>();
+
+/*!
+ * \brief The word lengths to measure, the time per candidate should not
+ *        depend on them for an amortized O(1) generator.
+ **/
+constexpr std::size_t wordLengths[]{2U, 4U, 6U, 7U};
+
+/*!
+ * \brief Generates all the words of a length the way bruteforce used to:
+ *        rewriting every character from the indices for every word.
+ * \param wordLength The word length.
+ * \return The amount of words generated.
+ **/
+std::uint64_t generateByRewriting(std::size_t wordLength)
+{
+  std::vector<std::size_t> indices(wordLength, 0U);
+  std::string              word(wordLength, '\0');
+  std::uint64_t            wordCount{0U};
+
+  for (;;) {
+    for (std::size_t i{0U}; i < wordLength; ++i) {
+      word[i] = alphabet[indices[i]];
+    }
+
+    itsp3::bench::doNotOptimize(word);
+    ++wordCount;
+
+    std::size_t i{wordLength};
+
+    for (; i-- > 0U;) {
+      if (++(indices[i]) != alphabet.size()) {
+        break;
+      }
+
+      indices[i] = 0U;
+    }
+
+    if (i == static_cast<std::size_t>(-1)) {
+      return wordCount;
+    }
+  }
+}
+
+/*!
+ * \brief Generates all the words of a length using an Odometer.
+ * \param odometer The Odometer to use.
+ * \param wordLength The word length.
+ * \return The amount of words generated.
+ **/
+std::uint64_t generateWithOdometer(
+  itsp3::Odometer<alphabet.size()>& odometer,
+  std::size_t                       wordLength)
+{
+  std::uint64_t wordCount{0U};
+
+  odometer.reset(wordLength);
+
+  do {
+    itsp3::bench::doNotOptimize(odometer.getWord());
+    ++wordCount;
+  } while (odometer.advance());
+
+  return wordCount;
+}
+} // anonymous namespace
+
+ITSP3_BENCHMARK(candidateGeneration)
+{
+  using itsp3::bench::clock;
+
+  itsp3::Odometer<alphabet.size()> odometer{alphabet, alphabet.size()};
+
+  for (std::size_t wordLength : wordLengths) {
+    const std::string suffix{" (length " + std::to_string(wordLength) + ')'};
+
+    clock::time_point   start{clock::now()};
+    const std::uint64_t rewritten{generateByRewriting(wordLength)};
+    itsp3::bench::report(
+      "rewrite all characters" + suffix, rewritten, clock::now() - start);
+
+    start = clock::now();
+    const std::uint64_t advanced{generateWithOdometer(odometer, wordLength)};
+    itsp3::bench::report(
+      "odometer" + suffix, advanced, clock::now() - start);
+  }
+}
+
+ITSP3_BENCHMARK(fixedLengthGeneration)
+{
+  using itsp3::bench::clock;
+
+  // the same predicate for both, which never matches, so that all the
+  // words of length 7 are generated.
+  std::uint64_t candidateCount{0U};
+  const auto    generate = [&candidateCount](std::string_view candidate) {
+    ++candidateCount;
+    itsp3::bench::doNotOptimize(candidate);
+    return false;
+  };
+
+  itsp3::Odometer<alphabet.size()> odometer{alphabet, 7U};
+  clock::time_point                start{clock::now()};
+  odometer.reset(7U);
+
+  do {
+    generate(odometer.getWord());
+  } while (odometer.advance());
+
+  itsp3::bench::report(
+    "odometer (length 7)", candidateCount, clock::now() - start);
+
+  candidateCount = 0U;
+  start          = clock::now();
+
+  try {
+    itsp3::fixedLengthBruteforce<alphabet, 7U>(generate);
+  }
+  catch (const itsp3::KeyspaceExhaustedException&) {
+  }
+
+  itsp3::bench::report(
+    "fixedLengthBruteforce (length 7)", candidateCount, clock::now() - start);
+}
+
+ITSP3_BENCHMARK(bruteforceWithoutMatch)
+{
+  using itsp3::bench::clock;
+
+  // the last word of length 7, so that all the shorter lengths are
+  // generated, too.
+  const std::string password(7U, alphabet.back());
+  std::uint64_t     candidateCount{0U};
+
+  const clock::time_point start{clock::now()};
+  itsp3::bruteforce(
+    [&password, &candidateCount](const std::string& candidate) {
+      ++candidateCount;
+      return candidate == password;
+    },
+    alphabet);
+  itsp3::bench::report("bruteforce", candidateCount, clock::now() - start);
+}
+
+ITSP3_BENCHMARK(limitedBruteforceWithoutMatch)
+{
+  using itsp3::bench::clock;
+
+  // the same search as bruteforceWithoutMatch with all the limits set, but
+  // none of them hit, to measure what checking them costs.
+  const std::string        password(7U, alphabet.back());
+  itsp3::CancellationToken token{};
+  itsp3::BruteforceOptions options{};
+  options.limits.cancellation    = &token;
+  options.limits.deadline        = clock::now() + std::chrono::hours{1};
+  options.limits.candidateBudget = std::numeric_limits<std::uint64_t>::max();
+
+  const clock::time_point       start{clock::now()};
+  const itsp3::BruteforceResult result{itsp3::limitedBruteforce(
+    [&password](std::string_view candidate) { return candidate == password; },
+    alphabet,
+    options)};
+  itsp3::bench::report(
+    "limitedBruteforce", result.candidateCount, clock::now() - start);
+}
+
+ITSP3_BENCHMARK(parallelBruteforceProgress)
+{
+  using itsp3::bench::clock;
+
+  // a predicate that never matches and costs next to nothing, so that
+  // publishing the progress would show if it cost anything.
+  const auto never = [](std::string_view candidate) {
+    itsp3::bench::doNotOptimize(candidate);
+    return false;
+  };
+
+  itsp3::ParallelBruteforceOptions options{};
+  options.minLength   = 8U;
+  options.maxLength   = 8U;
+  options.threadCount = std::max(std::thread::hardware_concurrency(), 1U);
+
+  itsp3::ProgressCounters counters{options.threadCount};
+
+  for (itsp3::ProgressCounters* progress : {
+         static_cast<itsp3::ProgressCounters*>(nullptr), &counters}) {
+    options.progress = progress;
+
+    const clock::time_point start{clock::now()};
+
+    try {
+      itsp3::parallelBruteforce(never, alphabet, options);
+    }
+    catch (const itsp3::KeyspaceExhaustedException& ex) {
+      itsp3::bench::report(
+        progress == nullptr ? "parallelBruteforce without progress"
+                            : "parallelBruteforce with progress",
+        ex.getCandidateCount(),
+        clock::now() - start);
+    }
+  }
+}
@@ -0,0 +1,71 @@
+#include "benchmark.hpp"         // ITSP3_BENCHMARK, itsp3::bench::report
+#include "dictionary_attack.hpp" // itsp3::dictionaryAttack
+#include "rules.hpp"             // itsp3::RuleSet
+#include <atomic>                // std::atomic
+#include <cstddef>               // std::size_t
+#include <cstdint>               // std::uint64_t
+#include <string>                // std::string, std::to_string
+#include <string_view>           // std::string_view
+
+namespace {
+/*!
+ * \brief Creates a wordlist of about 10 MB.
+ * \return The wordlist.
+ **/
+std::string makeWordlist()
+{
+  std::string wordlist{};
+
+  for (std::size_t i{0U}; i < 1000000U; ++i) {
+    wordlist += "pw" + std::to_string(i * 7919U) + '\n';
+  }
+
+  return wordlist;
+}
+
+/*!
+ * \brief Runs a dictionary attack without a match and reports it.
+ * \param label The label to report.
+ * \param wordlist The wordlist.
+ * \param rules The rules or nullptr.
+ **/
+void measure(
+  const std::string&    label,
+  std::string_view      wordlist,
+  const itsp3::RuleSet* rules)
+{
+  using itsp3::bench::clock;
+
+  std::atomic<std::uint64_t> candidateCount{0U};
+
+  itsp3::DictionaryAttackOptions options{};
+  options.rules = rules;
+
+  const clock::time_point start{clock::now()};
+
+  try {
+    itsp3::dictionaryAttack(
+      [&candidateCount](std::string_view candidate) {
+        itsp3::bench::doNotOptimize(candidate);
+        candidateCount.fetch_add(1U, std::memory_order_relaxed);
+        return false;
+      },
+      wordlist,
+      options);
+  }
+  catch (const itsp3::WordlistExhaustedException&) {
+  }
+
+  itsp3::bench::report(label, candidateCount.load(), clock::now() - start);
+}
+} // anonymous namespace
+
+ITSP3_BENCHMARK(dictionaryAttack)
+{
+  const std::string    wordlist{makeWordlist()};
+  const itsp3::RuleSet rules{
+    itsp3::RuleSet::parse(":\nc\nu\n$1\n$!\nc $1\nc $1 $!\nr\nd\nso0\n")};
+
+  measure("words", wordlist, nullptr);
+  measure("words with 10 rules", wordlist, &rules);
+}
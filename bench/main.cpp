@@ -0,0 +1,59 @@
+#include "benchmark.hpp"
+#include <cstdio>      // std::printf
+#include <cstdlib>     // EXIT_SUCCESS
+#include <iostream>    // std::cout
+#include <string_view> // std::string_view
+
+namespace itsp3 {
+namespace bench {
+std::vector<std::pair<std::string, BenchmarkFunction>>& benchmarks()
+{
+  static std::vector<std::pair<std::string, BenchmarkFunction>> instance{};
+  return instance;
+}
+
+Registrar::Registrar(std::string name, BenchmarkFunction function)
+{
+  benchmarks().emplace_back(std::move(name), function);
+}
+
+void report(
+  std::string_view label,
+  std::uint64_t    itemCount,
+  clock::duration  duration)
+{
+  const double nanoseconds{
+    std::chrono::duration<double, std::nano>{duration}.count()};
+
+  std::printf(
+    "  %-40.*s %14llu items %10.3f ms %8.3f ns/item\n",
+    static_cast<int>(label.size()),
+    label.data(),
+    static_cast<unsigned long long>(itemCount),
+    nanoseconds / 1e6,
+    itemCount == 0U ? 0.0 : nanoseconds / static_cast<double>(itemCount));
+}
+} // namespace bench
+} // namespace itsp3
+
+/*!
+ * \brief Runs the benchmarks.
+ *
+ * Runs all the benchmarks if no command line argument is given, otherwise
+ * only the ones whose names contain the first command line argument.
+ **/
+int main(int argc, char* argv[])
+{
+  const std::string_view filter{argc > 1 ? argv[1] : ""};
+
+  for (const auto& [name, function] : itsp3::bench::benchmarks()) {
+    if (name.find(filter) == std::string::npos) {
+      continue;
+    }
+
+    std::cout << name << ":\n" << std::flush;
+    function();
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,54 @@
+#include "alphabets.hpp" // itsp3::makeAlphabet
+#include "benchmark.hpp" // ITSP3_BENCHMARK, itsp3::bench::report
+#include "markov.hpp"    // itsp3::MarkovModel, itsp3::MarkovOdometer
+#include "odometer.hpp"  // itsp3::Odometer
+#include <cstddef>       // std::size_t
+#include <cstdint>       // std::uint64_t
+#include <string>        // std::string, std::to_string
+
+namespace {
+constexpr auto alphabet = itsp3::makeAlphabet<'a', 'k'>();
+
+/*!
+ * \brief The word lengths to measure.
+ **/
+constexpr std::size_t wordLengths[]{4U, 6U, 7U};
+} // anonymous namespace
+
+ITSP3_BENCHMARK(markovCandidateGeneration)
+{
+  using itsp3::bench::clock;
+
+  const itsp3::MarkovModel model{itsp3::MarkovModel::train(
+    alphabet, "badge\ncabbage\nfaded\nbeaded\ndecade\nhijack\n")};
+
+  itsp3::Odometer<alphabet.size()> odometer{alphabet, alphabet.size()};
+  itsp3::MarkovOdometer            markovOdometer{model, alphabet.size()};
+
+  for (std::size_t wordLength : wordLengths) {
+    const std::string suffix{" (length " + std::to_string(wordLength) + ')'};
+
+    clock::time_point start{clock::now()};
+    std::uint64_t     wordCount{0U};
+    odometer.reset(wordLength);
+
+    do {
+      itsp3::bench::doNotOptimize(odometer.getWord());
+      ++wordCount;
+    } while (odometer.advance());
+
+    itsp3::bench::report("odometer" + suffix, wordCount, clock::now() - start);
+
+    start     = clock::now();
+    wordCount = 0U;
+    markovOdometer.reset(wordLength);
+
+    do {
+      itsp3::bench::doNotOptimize(markovOdometer.getWord());
+      ++wordCount;
+    } while (markovOdometer.advance());
+
+    itsp3::bench::report(
+      "markov odometer" + suffix, wordCount, clock::now() - start);
+  }
+}
@@ -2,6 +2,7 @@
 #define INCG_ITSP3_ADD_USER_RESULT_HPP
 #include "check_password.hpp" // itsp3::PasswordCheckingResult
 #include <iosfwd>             // std::ostream
+#include <optional>           // std::optional
 #include <string>             // std::string
 #include <string_view>        // std::string_view
 
@@ -65,9 +66,26 @@ public:
    **/
   std::string_view getMessage() const noexcept;
 
+  /*!
+   * \brief Attaches a warning, such as about a user having been added in a
+   *        way that may not be what was intended.
+   * \param warning The warning.
+   * \return A reference to this object.
+   **/
+  this_type& setWarning(std::string warning);
+
+  /*!
+   * \brief Read accessor for the warning.
+   * \return The warning or nullopt if there is none.
+   **/
+  const std::optional<std::string>& getWarning() const noexcept;
+
 private:
-  bool        m_ok;      /*!< Whether or not this object indicates success */
-  std::string m_message; /*!< The message of this object */
+  bool                       m_ok; /*!< Whether or not this object
+                                    *   indicates success
+                                    **/
+  std::string                m_message; /*!< The message of this object */
+  std::optional<std::string> m_warning; /*!< The warning, if any */
 };
 
 /*!
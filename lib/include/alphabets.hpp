@@ -1,15 +1,220 @@
 /*!
  * \file alphabets.hpp
  * \brief Exports utilities for creating alphabets as std::arrays from
- *        ranges of ASCII values.
+ *        ranges of ASCII values and from sets of characters as well as
+ *        commonly used alphabets.
  **/
 #ifndef INCG_ITSP3_ALPHABETS_HPP
 #define INCG_ITSP3_ALPHABETS_HPP
-#include <array>                  // std::array
-#include <pl/cont/make_array.hpp> // pl::cont::makeArray
+#include <array>       // std::array
+#include <ciso646>     // not
+#include <cstddef>     // std::size_t
+#include <cstdint>     // std::uint64_t
+#include <string_view> // std::string_view
 #include <type_traits> // std::index_sequence, std::make_index_sequence
 
 namespace itsp3 {
+/*!
+ * \brief A set of characters, usable at compile time.
+ *
+ * Stores one bit per possible char value, so that the union, intersection
+ * and difference of sets are a few bitwise operations and looking up a
+ * character is O(1). Characters added more than once are contained once,
+ * so building a set from overlapping ranges or a string with duplicates
+ * removes the duplicates.
+ * \see toAlphabet
+ **/
+class CharSet {
+public:
+  using this_type = CharSet;
+
+  /*!
+   * \brief Creates an empty CharSet.
+   **/
+  constexpr CharSet() noexcept : m_words{} {}
+
+  /*!
+   * \brief Creates a CharSet from a range of character values.
+   * \param from The first character value.
+   * \param to The character value after the last one, the range
+   *           [from .. to) is half open like the one of makeAlphabet.
+   * \return The CharSet.
+   **/
+  static constexpr this_type fromRange(int from, int to) noexcept
+  {
+    this_type set{};
+
+    for (int c{from}; c < to; ++c) {
+      set.insert(static_cast<char>(c));
+    }
+
+    return set;
+  }
+
+  /*!
+   * \brief Creates a CharSet from characters.
+   * \param characters The characters, may contain duplicates.
+   * \return The CharSet.
+   **/
+  static constexpr this_type fromCharacters(
+    std::string_view characters) noexcept
+  {
+    this_type set{};
+
+    for (char c : characters) {
+      set.insert(c);
+    }
+
+    return set;
+  }
+
+  /*!
+   * \brief Adds a character.
+   * \param c The character to add.
+   * \return A reference to this object.
+   **/
+  constexpr this_type& insert(char c) noexcept
+  {
+    const unsigned char value{static_cast<unsigned char>(c)};
+    m_words[value / s_wordBits] |= std::uint64_t{1U} << (value % s_wordBits);
+    return *this;
+  }
+
+  /*!
+   * \brief Checks whether a character is contained.
+   * \param c The character to look up.
+   * \return true if 'c' is contained, otherwise false.
+   **/
+  constexpr bool contains(char c) const noexcept
+  {
+    const unsigned char value{static_cast<unsigned char>(c)};
+    return ((m_words[value / s_wordBits] >> (value % s_wordBits)) & 1U)
+           != 0U;
+  }
+
+  /*!
+   * \brief Counts the characters.
+   * \return The amount of characters contained.
+   **/
+  constexpr std::size_t size() const noexcept
+  {
+    std::size_t count{0U};
+
+    for (std::uint64_t word : m_words) {
+      for (; word != 0U; word &= word - 1U) {
+        ++count;
+      }
+    }
+
+    return count;
+  }
+
+  /*!
+   * \brief Checks whether no characters are contained.
+   * \return true if size() is 0, otherwise false.
+   **/
+  constexpr bool empty() const noexcept { return size() == 0U; }
+
+  /*!
+   * \brief Creates the union of two CharSets.
+   * \return The characters contained in 'lhs' or 'rhs'.
+   **/
+  friend constexpr this_type operator|(
+    const this_type& lhs,
+    const this_type& rhs) noexcept
+  {
+    this_type result{};
+
+    for (std::size_t i{0U}; i < s_wordCount; ++i) {
+      result.m_words[i] = lhs.m_words[i] | rhs.m_words[i];
+    }
+
+    return result;
+  }
+
+  /*!
+   * \brief Creates the intersection of two CharSets.
+   * \return The characters contained in both 'lhs' and 'rhs'.
+   **/
+  friend constexpr this_type operator&(
+    const this_type& lhs,
+    const this_type& rhs) noexcept
+  {
+    this_type result{};
+
+    for (std::size_t i{0U}; i < s_wordCount; ++i) {
+      result.m_words[i] = lhs.m_words[i] & rhs.m_words[i];
+    }
+
+    return result;
+  }
+
+  /*!
+   * \brief Creates the difference of two CharSets.
+   * \return The characters contained in 'lhs' but not in 'rhs'.
+   **/
+  friend constexpr this_type operator-(
+    const this_type& lhs,
+    const this_type& rhs) noexcept
+  {
+    this_type result{};
+
+    for (std::size_t i{0U}; i < s_wordCount; ++i) {
+      result.m_words[i] = lhs.m_words[i] & ~rhs.m_words[i];
+    }
+
+    return result;
+  }
+
+  friend constexpr bool operator==(
+    const this_type& lhs,
+    const this_type& rhs) noexcept
+  {
+    for (std::size_t i{0U}; i < s_wordCount; ++i) {
+      if (lhs.m_words[i] != rhs.m_words[i]) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  friend constexpr bool operator!=(
+    const this_type& lhs,
+    const this_type& rhs) noexcept
+  {
+    return not(lhs == rhs);
+  }
+
+private:
+  static constexpr std::size_t s_wordBits{64U};
+  static constexpr std::size_t s_wordCount{256U / s_wordBits};
+
+  std::array<std::uint64_t, s_wordCount> m_words;
+};
+
+/*!
+ * \brief Compile time function to create an alphabet from a CharSet.
+ * \return The characters of 'Set' ordered by their unsigned values.
+ *
+ * 'Set' has to be a constexpr CharSet with static storage duration, which
+ * allows the size of the std::array to be calculated at compile time.
+ **/
+template<const CharSet& Set>
+constexpr std::array<char, Set.size()> toAlphabet() noexcept
+{
+  std::array<char, Set.size()> alphabet{};
+  std::size_t                  i{0U};
+
+  for (int value{0}; value < 256; ++value) {
+    if (Set.contains(static_cast<char>(value))) {
+      alphabet[i++] = static_cast<char>(value);
+    }
+  }
+
+  return alphabet;
+}
+
 namespace detail {
 /*!
  * \brief Implementation function of makeAlphabet.
@@ -75,6 +280,80 @@ namespace {
  **/
 constexpr std::array<char, 0x80 - 0x00> asciiAlphabet
   = makeAlphabet<0x00, 0x80>();
+
+/*!
+ * All the lower case character. (Assuming ASCII implementation).
+ * '{' is the character after 'z'. (Note the use of half open ranges typical
+ * in C++).
+ * See an ASCII chart for reference at:
+ * http://en.cppreference.com/w/cpp/language/ascii
+ **/
+constexpr std::array<char, '{' - 'a'> lowerCaseCharacters
+  = makeAlphabet<'a', '{'>();
+
+/*!
+ * The upper case characters.
+ **/
+constexpr std::array<char, '[' - 'A'> upperCaseCharacters
+  = makeAlphabet<'A', '['>();
+
+/*!
+ * The digits '0' - '9' as chars.
+ **/
+constexpr std::array<char, ':' - '0'> digits = makeAlphabet<'0', ':'>();
+
+/*!
+ * The printable ASCII characters, [0x20 .. 0x7F), which are the ones a
+ * password read by std::getline may reasonably consist of. Control
+ * characters can't be typed and a NUL would end the password, as bcrypt
+ * hashes C strings.
+ **/
+constexpr CharSet printableCharacterSet{CharSet::fromRange(0x20, 0x7F)};
+
+/*!
+ * The lower case characters as CharSet.
+ **/
+constexpr CharSet lowerCaseCharacterSet{CharSet::fromRange('a', '{')};
+
+/*!
+ * The upper case characters as CharSet.
+ **/
+constexpr CharSet upperCaseCharacterSet{CharSet::fromRange('A', '[')};
+
+/*!
+ * The digits as CharSet.
+ **/
+constexpr CharSet digitCharacterSet{CharSet::fromRange('0', ':')};
+
+/*!
+ * The letters and digits as CharSet.
+ **/
+constexpr CharSet alnumCharacterSet{
+  lowerCaseCharacterSet | upperCaseCharacterSet | digitCharacterSet};
+
+/*!
+ * The 'special' characters as CharSet: the printable characters that are
+ * neither letters nor digits, including the space.
+ **/
+constexpr CharSet specialCharacterSet{
+  printableCharacterSet - alnumCharacterSet};
+
+/*!
+ * The 'special' characters, in ASCII order.
+ **/
+constexpr auto specialCharacters = toAlphabet<specialCharacterSet>();
+
+/*!
+ * The letters and digits, in ASCII order.
+ **/
+constexpr auto alnumAlphabet = toAlphabet<alnumCharacterSet>();
+
+/*!
+ * The printable ASCII characters, in ASCII order. Used by the cracker by
+ * default, as it is (128 / 95)^n times smaller than asciiAlphabet for
+ * words of length n.
+ **/
+constexpr auto printableAlphabet = toAlphabet<printableCharacterSet>();
 } // anonymous namespace
 } // namespace itsp3
 #endif // INCG_ITSP3_ALPHABETS_HPP
@@ -1,19 +1,29 @@
 #ifndef INCG_ITSP3_BCRYPT_HPP
 #define INCG_ITSP3_BCRYPT_HPP
 #include "add_user_result.hpp" // itsp3::AddUserResult
-#include <array>               // std::array
-#include <bcrypt.h> // BCRYPT_HASHSIZE, bcrypt_gensalt, bcrypt_hashpw, bcrypt_checkpw
-#include <fstream>     // std::fstream
+#include "crack_target.hpp"    // itsp3::CrackTarget
+#include "file_watcher.hpp"    // itsp3::FileWatcher
+#include "hash_cache.hpp"      // itsp3::HashCache
+#include "hashing_backend.hpp" // itsp3::HashingBackend, itsp3::HashBuffer
+#include "record_index.hpp"    // itsp3::RecordIndex
+#include <cstddef>             // std::size_t
+#include <cstdint>             // std::uint64_t
+#include <fstream>             // std::fstream
+#include <functional>          // std::function
+#include <memory>              // std::unique_ptr, std::shared_ptr
+#include <mutex>               // std::mutex
 #include <optional>    // std::optional
 #include <string>      // std::string
 #include <string_view> // std::string_view
+#include <vector>      // std::vector
 
 namespace itsp3 {
 /*!
  * \brief Type used to write usernames with their passwords to a file in an
  *        encrypted manner. May also be used to check a given password with for
  *        validity for a given username.
- * \note Uses the Bcrypt algorithm as its implementation.
+ * \note Uses the Bcrypt algorithm as its implementation by default,
+ *       other implementations may be injected as a HashingBackend.
  * \see https://github.com/rg3/bcrypt for details.
  **/
 class Bcrypt {
@@ -22,8 +32,27 @@ public:
    * \brief Creates a Bcrypt object.
    * \param filePath The path to the file to write the usernames
    *                 and passwords to.
+   * \param hashCacheByteBudget The byte budget of the cache of recently
+   *                            looked up hashes. 0 disables the cache.
+   * \note Uses a BcryptLibraryBackend with the default work factor.
    **/
-  explicit Bcrypt(std::string filePath);
+  explicit Bcrypt(
+    std::string filePath,
+    std::size_t hashCacheByteBudget = HashCache::s_defaultByteBudget);
+
+  /*!
+   * \brief Creates a Bcrypt object using a given HashingBackend.
+   * \param filePath The path to the file to write the usernames
+   *                 and passwords to.
+   * \param hashingBackend The backend used to generate salts as well as
+   *                       to create and check hashes. May not be nullptr!
+   * \param hashCacheByteBudget The byte budget of the cache of recently
+   *                            looked up hashes. 0 disables the cache.
+   **/
+  Bcrypt(
+    std::string                     filePath,
+    std::shared_ptr<HashingBackend> hashingBackend,
+    std::size_t hashCacheByteBudget = HashCache::s_defaultByteBudget);
 
   /*!
    * \brief Adds a username with a given password to the binary file.
@@ -47,12 +76,82 @@ public:
    * \note Fails if the password is incorrect.
    *       Fails if the there was no user with the username 'username'.
    *       Fails if an error occurred in the underlying bcrypt library.
+   *       Unlike addUser, this function may be called from several threads
+   *       at once.
    **/
   bool checkPasswordValidity(
     std::string_view username,
     std::string_view password);
 
+  /*!
+   * \brief Prepares checking many candidate passwords of a user.
+   * \param username The username whose password to crack.
+   * \return A CrackTarget for the hash of 'username' or a nullopt if there
+   *         is no user 'username'.
+   * \throws CrackTargetException if the hash of 'username' is corrupted.
+   * \note Looks the hash up once, unlike checkPasswordValidity which does
+   *       so for every password checked.
+   **/
+  std::optional<CrackTarget> prepareCrackTarget(std::string_view username);
+
+  /*!
+   * \brief Prepares cracking the passwords of many users at once.
+   * \param filter Selects the users by username, all of them if empty.
+   * \return The CrackTargets of the users selected, in the order of the
+   *         binary file. Empty if the binary file could not be opened.
+   * \throws CrackTargetException if the hash of a user selected is
+   *         corrupted.
+   **/
+  std::vector<CrackTarget> prepareCrackTargets(
+    const std::function<bool(std::string_view)>& filter = {});
+
+  /*!
+   * \brief Read accessor for the cache of recently looked up hashes.
+   * \return A reference to the cache.
+   * \note May be used to observe the hit and miss counters.
+   **/
+  const HashCache& getHashCache() const noexcept;
+
+  /*!
+   * \brief Keeps an in memory index of all the records of the binary file
+   *        that is refreshed whenever the binary file is appended to,
+   *        including appends by other processes.
+   * \throws FileWatcherException if the binary file could not be watched.
+   * \note Only the newly appended records are parsed on a refresh.
+   *       Once enabled lookups are served by the index rather than by the
+   *       hash cache and scanning the binary file.
+   *       Does nothing if already enabled.
+   **/
+  void enableTailFollowing();
+
+  /*!
+   * \brief Read accessor for the index enabled by enableTailFollowing.
+   * \return A pointer to the index or nullptr if not enabled.
+   **/
+  const RecordIndex* getRecordIndex() const noexcept;
+
 private:
+  /*!
+   * \brief Identifies the contents of the binary file, as far as the hash
+   *        cache is concerned.
+   **/
+  struct FileIdentity {
+    std::uint64_t device; /*!< The device the file resides on */
+    std::uint64_t inode;  /*!< The inode of the file */
+    std::uint64_t size;   /*!< The size of the file in bytes */
+  };
+
+  /*!
+   * \brief Clears the hash cache if the binary file was replaced, removed
+   *        or shrunk since the last lookup.
+   * \note Records are only ever appended to the binary file, so as long as
+   *       it is the same file and has not shrunk the cached hashes are
+   *       still those of its records. A file rewritten in place without
+   *       shrinking is not detected.
+   *       Costs one stat of the binary file.
+   **/
+  void dropCachedHashesIfReplaced();
+
   /*!
    * \brief Determines if the length of a string is OK or not.
    * \param str The string to check the length of.
@@ -63,13 +162,6 @@ private:
    **/
   static bool isLengthOk(std::string_view str) noexcept;
 
-  static const int s_defaultSaltWorkfactor; /*!< The recommended default
-                                             *   salt work factor of the
-                                             *   bcrypt library. Allowable
-                                             *   values are 4 to 31 (both
-                                             *   inclusive).
-                                             **/
-
   /*!
    * \brief Retrieves the hash for a given username from the binary file.
    * \param username The username to retrieve the associated hash of.
@@ -79,19 +171,56 @@ private:
    *       Fails if none of the records in the binary file was the record of
    *       'username'.
    *       May also fail if the binary file was corrupted.
+   *       Consults the hash cache first, the binary file is only scanned
+   *       on a cache miss. The cache is cleared first if the binary file
+   *       was replaced, see dropCachedHashesIfReplaced. Uses the record
+   *       index instead if tail following is enabled.
    **/
   std::optional<std::string> findHashOfUser(std::string_view username);
 
-  std::string m_filePath;                   /*!< The path to the binary file */
-  std::array<char, BCRYPT_HASHSIZE> m_salt; /*!< Intermediate buffer to write
-                                             *   salts generated by the bcrypt
-                                             *   library to.
-                                             *   Written to from 'addUser'.
-                                             **/
-  std::array<char, BCRYPT_HASHSIZE> m_hash; /*!< Intermediate buffer to write
-                                             *   hashes to.
-                                             *   Written to from 'addUser'.
-                                             **/
+  std::string                     m_filePath; /*!< The path to the binary
+                                              *   file
+                                              **/
+  std::shared_ptr<HashingBackend> m_hashingBackend; /*!< Creates the salts
+                                                     *   and hashes.
+                                                     **/
+  HashCache                       m_hashCache; /*!< Cache of recently looked
+                                                *   up hashes. Records are
+                                                *   never modified once
+                                                *   written, so cached hashes
+                                                *   only go stale if the
+                                                *   binary file is replaced
+                                                *   or shrinks.
+                                                **/
+  std::unique_ptr<std::mutex>     m_fileIdentityMutex; /*!< Guards
+                                                        *   'm_fileIdentity',
+                                                        *   held by pointer
+                                                        *   as std::mutex is
+                                                        *   not movable.
+                                                        **/
+  std::optional<FileIdentity>     m_fileIdentity; /*!< Of the binary file
+                                                   *   at the last lookup,
+                                                   *   nullopt if it did
+                                                   *   not exist.
+                                                   **/
+  std::unique_ptr<RecordIndex>    m_recordIndex; /*!< Set by
+                                                  *   enableTailFollowing.
+                                                  **/
+  std::unique_ptr<FileWatcher>    m_fileWatcher; /*!< Refreshes
+                                                  *   'm_recordIndex'.
+                                                  *   Declared after it so
+                                                  *   that it is destroyed
+                                                  *   first.
+                                                  **/
+  HashBuffer                      m_salt; /*!< Intermediate buffer to write
+                                           *   salts generated by the
+                                           *   hashing backend to.
+                                           *   Written to from 'addUser'.
+                                           **/
+  HashBuffer                      m_hash; /*!< Intermediate buffer to write
+                                           *   hashes to.
+                                           *   Written to from 'addUser'.
+                                           **/
 };
 } // namespace itsp3
 #endif // INCG_ITSP3_BCRYPT_HPP
@@ -0,0 +1,243 @@
+/*!
+ * \file bcrypt_kernel.hpp
+ * \brief Exports an in-tree implementation of bcrypt that computes several
+ *        hashes at once using the SIMD instruction sets of the CPU.
+ **/
+#ifndef INCG_ITSP3_BCRYPT_KERNEL_HPP
+#define INCG_ITSP3_BCRYPT_KERNEL_HPP
+#include <array>         // std::array
+#include <cstddef>       // std::size_t
+#include <cstdint>       // std::uint8_t, std::uint32_t
+#include <iosfwd>        // std::ostream
+#include <optional>      // std::optional
+#include <pl/except.hpp> // PL_DEFINE_EXCEPTION_TYPE
+#include <stdexcept>     // std::invalid_argument
+#include <string>        // std::string
+#include <string_view>   // std::string_view
+
+namespace itsp3 {
+PL_DEFINE_EXCEPTION_TYPE(BcryptSettingException, std::invalid_argument);
+
+/*!
+ * \brief The amount of bytes of a key bcrypt uses at most. Keys that begin
+ *        with the same bcryptKeyLimit bytes have the same digest.
+ **/
+constexpr std::size_t bcryptKeyLimit{72U};
+
+/*!
+ * \brief The raw salt of bcrypt.
+ **/
+using BcryptSalt = std::array<std::uint8_t, 16U>;
+
+/*!
+ * \brief The raw digest of bcrypt, the first 23 of the 24 bytes of
+ *        "OrpheanBeholderScryDoubt" encrypted.
+ **/
+using BcryptDigest = std::array<std::uint8_t, 23U>;
+
+/*!
+ * \brief The parameters of a bcrypt hash, decoded from the beginning of a
+ *        hash such as "$2a$12$R9h/cIPz0gi.URNNX3kh2O".
+ **/
+struct BcryptSetting {
+  /*!
+   * \brief Decodes the setting a hash begins with.
+   * \param hash The setting or a complete hash, anything after the salt
+   *             is ignored.
+   * \return The setting decoded.
+   * \throws BcryptSettingException if 'hash' does not begin with a valid
+   *         setting.
+   * \note The unused low bits of the last character of the salt are
+   *       ignored, like the bcrypt library does.
+   **/
+  static BcryptSetting parse(std::string_view hash);
+
+  char       minor; /*!< The minor version, 'a', 'b', 'x' or 'y' */
+  int        cost;  /*!< The base 2 logarithm of the amount of iterations */
+  BcryptSalt salt;  /*!< The salt */
+};
+
+/*!
+ * \brief A complete bcrypt hash such as
+ *        "$2a$05$CCCCCCCCCCCCCCCCCCCCC.E5YPO9kmyuRGyh0XouQYb4YMJKvyOeW",
+ *        decoded so that keys can be verified against it without
+ *        formatting and comparing strings.
+ **/
+struct BcryptHash {
+  /*!
+   * \brief Decodes a hash.
+   * \param hash The hash, exactly 60 characters.
+   * \return The hash decoded.
+   * \throws BcryptSettingException if 'hash' is not a valid hash or is not
+   *         encoded the way the bcrypt library encodes hashes, as the
+   *         library would never verify a key against such a hash.
+   **/
+  static BcryptHash parse(std::string_view hash);
+
+  BcryptSetting setting; /*!< The setting */
+  BcryptDigest  digest;  /*!< The digest */
+};
+
+/*!
+ * \brief The instruction sets bcrypt can be computed with.
+ **/
+enum class BcryptIsa {
+  Scalar, /*!< Portable code, one hash at a time */
+  Sse41,  /*!< SSE4.1, 4 hashes at a time */
+  Avx2,   /*!< AVX2, 8 hashes at a time */
+  Avx512  /*!< AVX-512F, 16 hashes at a time */
+};
+
+/*!
+ * \brief Prints the name of a BcryptIsa.
+ * \param os The ostream to print to.
+ * \param isa The instruction set to print.
+ * \return A reference to 'os'.
+ **/
+std::ostream& operator<<(std::ostream& os, BcryptIsa isa);
+
+/*!
+ * \brief The maximum amount of lanes of all the instruction sets.
+ **/
+constexpr std::size_t bcryptMaxLaneCount{16U};
+
+/*!
+ * \brief Fetches how many hashes an instruction set computes at once.
+ * \param isa The instruction set.
+ * \return The amount of lanes of 'isa'.
+ **/
+std::size_t laneCount(BcryptIsa isa) noexcept;
+
+/*!
+ * \brief Checks whether the CPU supports an instruction set.
+ * \param isa The instruction set.
+ * \return true if 'isa' may be used, otherwise false.
+ **/
+bool isSupported(BcryptIsa isa) noexcept;
+
+/*!
+ * \brief Determines the widest instruction set the CPU supports.
+ * \return The instruction set to use.
+ **/
+BcryptIsa bestBcryptIsa() noexcept;
+
+/*!
+ * \brief Computes the bcrypt digest of a key.
+ * \param key The key, ends at the first null character if it contains
+ *            one. Only the first bcryptKeyLimit bytes, including the
+ *            terminating null character, are used.
+ * \param setting The setting to use.
+ * \return The digest. Identical to the one the bcrypt library computes
+ *         from 'key' and the same setting.
+ **/
+BcryptDigest bcryptHash(std::string_view key, const BcryptSetting& setting);
+
+/*!
+ * \brief Verifies a key against a hash.
+ * \param key The key, see bcryptHash.
+ * \param hash The hash.
+ * \return true if 'key' hashes to 'hash', otherwise false. The same as
+ *         bcrypt_checkpw with the key and the formatted hash would return.
+ * \note Compares the digests in constant time.
+ **/
+bool bcryptVerify(std::string_view key, const BcryptHash& hash);
+
+/*!
+ * \brief Computes the bcrypt digests of many keys with the same setting.
+ * \param keys The keys, see bcryptHash.
+ * \param count The amount of keys.
+ * \param setting The setting to use.
+ * \param digests The buffer to write the digests of the 'count' keys to.
+ * \param isa The instruction set to use, must be supported by the CPU.
+ * \note Computes laneCount(isa) digests at once, passing a multiple of it
+ *       as 'count' avoids idle lanes.
+ *       May be called from several threads at once.
+ **/
+void bcryptHashBatch(
+  const std::string_view* keys,
+  std::size_t             count,
+  const BcryptSetting&    setting,
+  BcryptDigest*           digests,
+  BcryptIsa               isa = bestBcryptIsa());
+
+/*!
+ * \brief Verifies many keys against a hash.
+ * \param keys The keys, see bcryptHash.
+ * \param count The amount of keys.
+ * \param hash The hash.
+ * \param isa The instruction set to use, must be supported by the CPU.
+ * \return The index of the first key that hashes to 'hash' or nullopt if
+ *         none does.
+ * \note Hashes the keys in groups of up to bcryptMaxLaneCount and stops
+ *       after the group holding the first match. The digests of a group
+ *       are all compared, in constant time. Does not allocate.
+ **/
+std::optional<std::size_t> bcryptVerifyBatch(
+  const std::string_view* keys,
+  std::size_t             count,
+  const BcryptHash&       hash,
+  BcryptIsa               isa = bestBcryptIsa());
+
+/*!
+ * \brief Formats a hash the way the bcrypt library does.
+ * \param setting The setting the digest was computed with.
+ * \param digest The digest.
+ * \return The hash, for instance
+ *         "$2a$05$CCCCCCCCCCCCCCCCCCCCC.E5YPO9kmyuRGyh0XouQYb4YMJKvyOeW".
+ **/
+std::string formatBcryptHash(
+  const BcryptSetting& setting,
+  const BcryptDigest&  digest);
+
+namespace detail {
+/*!
+ * \brief The initial P-array of Blowfish, the hexadecimal digits of pi.
+ **/
+extern const std::uint32_t blowfishInitialP[18];
+
+/*!
+ * \brief The initial S-boxes of Blowfish, the hexadecimal digits of pi
+ *        following the ones of the P-array. Box b begins at index 256 * b.
+ **/
+extern const std::uint32_t blowfishInitialS[1024];
+
+/*!
+ * \brief Computes bcrypt for several keys at once.
+ * \param initialP The P-array of each lane after XORing in its key.
+ * \param expandedKey The key of each lane, cycled to 18 words.
+ * \param salt The salt as 4 big endian words.
+ * \param cost The cost.
+ * \param output The buffer to write the 6 words of the ciphertext of
+ *               each lane to.
+ * \note All the arrays hold word i of lane l at index i * lanes + l.
+ *       Only available if the CPU supports the instruction set.
+ **/
+void bcryptLanesSse41(
+  const std::uint32_t* initialP,
+  const std::uint32_t* expandedKey,
+  const std::uint32_t* salt,
+  int                  cost,
+  std::uint32_t*       output);
+
+/*!
+ * \copydoc bcryptLanesSse41
+ **/
+void bcryptLanesAvx2(
+  const std::uint32_t* initialP,
+  const std::uint32_t* expandedKey,
+  const std::uint32_t* salt,
+  int                  cost,
+  std::uint32_t*       output);
+
+/*!
+ * \copydoc bcryptLanesSse41
+ **/
+void bcryptLanesAvx512(
+  const std::uint32_t* initialP,
+  const std::uint32_t* expandedKey,
+  const std::uint32_t* salt,
+  int                  cost,
+  std::uint32_t*       output);
+} // namespace detail
+} // namespace itsp3
+#endif // INCG_ITSP3_BCRYPT_KERNEL_HPP
@@ -0,0 +1,224 @@
+/*!
+ * \file bcrypt_lanes.hpp
+ * \brief Exports the multi-lane bcrypt kernel shared by the instruction
+ *        set specific translation units.
+ * \warning Only to be included by those translation units, after
+ *          selecting the instruction set with #pragma GCC target, as
+ *          everything is compiled for that instruction set. Everything has
+ *          internal linkage, so that the variants can't be mixed up by the
+ *          linker.
+ **/
+#ifndef INCG_ITSP3_BCRYPT_LANES_HPP
+#define INCG_ITSP3_BCRYPT_LANES_HPP
+#include "bcrypt_kernel.hpp" // itsp3::detail::blowfishInitialS
+#include <cstddef>           // std::size_t
+#include <cstdint>           // std::uint32_t
+#include <cstring>           // std::memcpy
+
+namespace itsp3 {
+namespace {
+/*!
+ * \brief Computes bcrypt for Traits::s_laneCount keys at once.
+ * \tparam Traits Provides the Vector type of Traits::s_laneCount
+ *                std::uint32_t and the static member function
+ *                Vector gather(const std::uint32_t* base, Vector indices).
+ *
+ * Every lane has its own P-array and S-boxes, stored interleaved, so that
+ * entry i of a box of all the lanes forms a Vector. The keys of the lanes
+ * differ, but the salt and thus the order of the blocks encrypted does
+ * not, so only the S-box lookups of the round function need to gather,
+ * all the other loads and stores are plain vector accesses.
+ **/
+template<typename Traits>
+class BlowfishLanes {
+public:
+  using this_type = BlowfishLanes;
+  using Vector    = typename Traits::Vector;
+
+  static constexpr std::size_t s_laneCount{Traits::s_laneCount};
+
+  /*!
+   * \brief Computes bcrypt, see detail::bcryptLanesSse41.
+   **/
+  static void run(
+    const std::uint32_t* initialP,
+    const std::uint32_t* expandedKey,
+    const std::uint32_t* salt,
+    int                  cost,
+    std::uint32_t*       output)
+  {
+    // about 64 KiB for 16 lanes, too much to put on the stack safely.
+    static thread_local BlowfishLanes lanes;
+    lanes.compute(initialP, expandedKey, salt, cost, output);
+  }
+
+private:
+  /*!
+   * \brief Creates a vector whose lanes are all the same value.
+   * \param value The value.
+   * \return The vector.
+   **/
+  static Vector broadcast(std::uint32_t value) noexcept
+  {
+    return Vector{} + value;
+  }
+
+  /*!
+   * \brief Loads a vector.
+   * \param data Pointer to s_laneCount words.
+   * \return The vector.
+   **/
+  static Vector load(const std::uint32_t* data) noexcept
+  {
+    Vector vector;
+    std::memcpy(&vector, data, sizeof(vector));
+    return vector;
+  }
+
+  /*!
+   * \brief Looks an entry up in an S-box in every lane.
+   * \param box The S-box.
+   * \param index The index of the entry of each lane.
+   * \return The entries.
+   **/
+  Vector lookup(std::size_t box, Vector index) const noexcept
+  {
+    // entry i of lane l is at word (box * 256 + i) * s_laneCount + l.
+    return Traits::gather(
+      reinterpret_cast<const std::uint32_t*>(&m_s[box * 0x100U]),
+      index * static_cast<std::uint32_t>(s_laneCount) + m_laneIndices);
+  }
+
+  /*!
+   * \brief Encrypts a block in every lane.
+   * \param l The left halves.
+   * \param r The right halves.
+   **/
+  void encrypt(Vector& l, Vector& r) const noexcept
+  {
+    const auto f = [this](Vector x) {
+      return ((lookup(0U, x >> 24U) + lookup(1U, (x >> 16U) & 0xFFU))
+              ^ lookup(2U, (x >> 8U) & 0xFFU))
+             + lookup(3U, x & 0xFFU);
+    };
+
+    l ^= m_p[0U];
+
+    for (std::size_t i{1U}; i < 17U; i += 2U) {
+      r ^= f(l) ^ m_p[i];
+      l ^= f(r) ^ m_p[i + 1U];
+    }
+
+    const Vector tmp{r};
+    r = l;
+    l = tmp ^ m_p[17U];
+  }
+
+  /*!
+   * \brief Encrypts the P-arrays and S-boxes with themselves.
+   * \param salt The salt words to XOR in between the blocks or nullptr.
+   **/
+  void expandState(const std::uint32_t* salt) noexcept
+  {
+    Vector      l{};
+    Vector      r{};
+    std::size_t saltIndex{0U};
+
+    const auto encryptBlock = [&](Vector* out) {
+      if (salt != nullptr) {
+        l ^= broadcast(salt[saltIndex]);
+        r ^= broadcast(salt[saltIndex + 1U]);
+        saltIndex ^= 2U;
+      }
+
+      encrypt(l, r);
+      out[0U] = l;
+      out[1U] = r;
+    };
+
+    for (std::size_t i{0U}; i < 18U; i += 2U) {
+      encryptBlock(&m_p[i]);
+    }
+
+    for (std::size_t i{0U}; i < 1024U; i += 2U) {
+      encryptBlock(&m_s[i]);
+    }
+  }
+
+  /*!
+   * \brief Computes bcrypt, see run.
+   **/
+  void compute(
+    const std::uint32_t* initialP,
+    const std::uint32_t* expandedKey,
+    const std::uint32_t* salt,
+    int                  cost,
+    std::uint32_t*       output) noexcept
+  {
+    for (std::size_t lane{0U}; lane < s_laneCount; ++lane) {
+      m_laneIndices[lane] = static_cast<std::uint32_t>(lane);
+    }
+
+    Vector key[18];
+
+    for (std::size_t i{0U}; i < 18U; ++i) {
+      m_p[i] = load(&initialP[i * s_laneCount]);
+      key[i] = load(&expandedKey[i * s_laneCount]);
+    }
+
+    for (std::size_t i{0U}; i < 1024U; ++i) {
+      m_s[i] = broadcast(detail::blowfishInitialS[i]);
+    }
+
+    expandState(salt);
+
+    Vector saltVectors[4];
+
+    for (std::size_t i{0U}; i < 4U; ++i) {
+      saltVectors[i] = broadcast(salt[i]);
+    }
+
+    for (std::uint64_t round{0U}; round < (std::uint64_t{1U} << cost);
+         ++round) {
+      for (std::size_t i{0U}; i < 18U; ++i) {
+        m_p[i] ^= key[i];
+      }
+
+      expandState(nullptr);
+
+      for (std::size_t i{0U}; i < 18U; ++i) {
+        m_p[i] ^= saltVectors[i & 3U];
+      }
+
+      expandState(nullptr);
+    }
+
+    // "OrpheanBeholderScryDoubt"
+    static constexpr std::uint32_t magicWords[6]{
+      0x4F727068U,
+      0x65616E42U,
+      0x65686F6CU,
+      0x64657253U,
+      0x63727944U,
+      0x6F756274U};
+
+    for (std::size_t i{0U}; i < 6U; i += 2U) {
+      Vector l{broadcast(magicWords[i])};
+      Vector r{broadcast(magicWords[i + 1U])};
+
+      for (int j{0}; j < 64; ++j) {
+        encrypt(l, r);
+      }
+
+      std::memcpy(&output[i * s_laneCount], &l, sizeof(l));
+      std::memcpy(&output[(i + 1U) * s_laneCount], &r, sizeof(r));
+    }
+  }
+
+  Vector m_p[18];        /*!< The P-arrays */
+  Vector m_s[1024];      /*!< The S-boxes, box b begins at 256 * b */
+  Vector m_laneIndices;  /*!< 0, 1, 2, ... */
+};
+} // anonymous namespace
+} // namespace itsp3
+#endif // INCG_ITSP3_BCRYPT_LANES_HPP
@@ -1,22 +1,89 @@
 #ifndef INCG_ITSP3_BRUTEFORCE_HPP
 #define INCG_ITSP3_BRUTEFORCE_HPP
-#include <array>         // std::array
-#include <cstddef>       // std::size_t
-#include <pl/except.hpp> // PL_DEFINE_EXCEPTION_TYPE, PL_THROW_WITH_SOURCE_INFO
-#include <stdexcept>     // std::logic_error
-#include <string>        // std::string
-#include <vector>        // std::vector
+#include "odometer.hpp"      // itsp3::Odometer
+#include "search_limits.hpp" // itsp3::SearchLimits, itsp3::SearchLimiter
+#include <array>             // std::array
+#include <chrono>            // std::chrono::steady_clock
+#include <ciso646>           // and
+#include <cstddef>           // std::size_t
+#include <cstdint>           // std::uint64_t
+#include <optional>          // std::optional
+#include <pl/except.hpp>     // PL_DEFINE_EXCEPTION_TYPE
+#include <stdexcept>         // std::logic_error
+#include <string>            // std::string
+#include <string_view>       // std::string_view
 
 namespace itsp3 {
 PL_DEFINE_EXCEPTION_TYPE(
   NoMatchInBruteforceAlgorithmException,
   std::logic_error);
 
+/*!
+ * \brief Thrown by the bruteforce algorithms if none of the words of the
+ *        lengths to search matched.
+ * \note Derives from NoMatchInBruteforceAlgorithmException, so that it
+ *       may be caught as such.
+ **/
+class KeyspaceExhaustedException
+  : public NoMatchInBruteforceAlgorithmException {
+public:
+  using this_type = KeyspaceExhaustedException;
+  using base_type = NoMatchInBruteforceAlgorithmException;
+  using clock     = std::chrono::steady_clock;
+
+  /*!
+   * \brief Creates a KeyspaceExhaustedException.
+   * \param minLength The minimum word length searched.
+   * \param maxLength The maximum word length searched.
+   * \param candidateCount The amount of words that were tried.
+   * \param duration The duration the search took.
+   * \note The statistics are part of the message returned by what().
+   **/
+  KeyspaceExhaustedException(
+    std::size_t     minLength,
+    std::size_t     maxLength,
+    std::uint64_t   candidateCount,
+    clock::duration duration);
+
+  /*!
+   * \brief Read accessor for the minimum word length searched.
+   * \return The minimum word length.
+   **/
+  std::size_t getMinLength() const noexcept;
+
+  /*!
+   * \brief Read accessor for the maximum word length searched.
+   * \return The maximum word length.
+   **/
+  std::size_t getMaxLength() const noexcept;
+
+  /*!
+   * \brief Read accessor for the amount of words that were tried.
+   * \return The amount of candidates.
+   **/
+  std::uint64_t getCandidateCount() const noexcept;
+
+  /*!
+   * \brief Read accessor for the duration the search took.
+   * \return The duration.
+   **/
+  clock::duration getDuration() const noexcept;
+
+private:
+  std::size_t     m_minLength;
+  std::size_t     m_maxLength;
+  std::uint64_t   m_candidateCount;
+  clock::duration m_duration;
+};
+
 /*!
  * \brief Bruteforce algorithm.
  * \param doesMatch Callable to determine if the current string matches.
  * \param alphabet The alphabet to use.
- * \throws NoMatchInBruteforceAlgorithmException
+ * \param minLength The length of the shortest words to try.
+ * \param maxLength The length of the longest words to try.
+ * \throws KeyspaceExhaustedException if none of the words of the lengths
+ *         [minLength .. maxLength] matched.
  * \note Can easily take a very long time to crack a password, depending on
  *       the length of the password and the length of the alphabet.
  *
@@ -26,57 +93,262 @@ PL_DEFINE_EXCEPTION_TYPE(
 template<std::size_t AlphabetSize, typename Callable>
 std::string bruteforce(
   const Callable&                       doesMatch,
-  const std::array<char, AlphabetSize>& alphabet)
+  const std::array<char, AlphabetSize>& alphabet,
+  std::size_t                           minLength = 0U,
+  std::size_t                           maxLength = AlphabetSize)
 {
-  // iterate over the alphabet
-  for (std::size_t curWordLen{0U}; curWordLen <= alphabet.size();
+  const KeyspaceExhaustedException::clock::time_point start{
+    KeyspaceExhaustedException::clock::now()};
+  std::uint64_t candidateCount{0U};
+
+  // generates the words in place, the buffers are allocated only once.
+  Odometer<AlphabetSize> odometer{alphabet, maxLength};
+
+  // iterate over the word lengths
+  for (std::size_t curWordLen{minLength}; curWordLen <= maxLength;
        ++curWordLen) {
-    // will contain the current indices into the alphabet
-    std::vector<std::size_t> indices(curWordLen, 0U);
+    odometer.reset(curWordLen);
 
-    // will contain the current word generated
-    std::string curWord(curWordLen, '\0');
+    // try all the words of the current length, advance() returns false
+    // once they have all been generated.
+    do {
+      ++candidateCount;
 
-  newIndices:
+      // if it matches -> return the match.
+      if (doesMatch(odometer.getWord())) {
+        return odometer.getWord();
+      }
+    } while (odometer.advance());
+  }
 
-    // fill the current word with the characters from the alphabet
-    // according to the current indices
-    for (std::size_t i{0U}; i < curWordLen; ++i) {
-      curWord[i] = alphabet[indices[i]];
-    }
+  throw KeyspaceExhaustedException{
+    minLength,
+    maxLength,
+    candidateCount,
+    KeyspaceExhaustedException::clock::now() - start};
+}
 
-    // if it matches -> return the match.
-    if (doesMatch(curWord)) {
-      return curWord;
+namespace detail {
+/*!
+ * \brief Implementation function of fixedLengthBruteforce.
+ * \param word The word, whose characters before 'Position' are set.
+ * \param doesMatch The callable passed to fixedLengthBruteforce.
+ * \return true if a word matched, in which case 'word' is that word.
+ * \note Not to be used directly.
+ *
+ * Every position is a loop over the alphabet whose body is the loop of the
+ * next position, so that the loops are nested at compile time with trip
+ * counts the compiler knows, rather than driven by a digit vector.
+ **/
+template<
+  const auto& Alphabet,
+  std::size_t Length,
+  std::size_t Position,
+  typename Callable>
+bool fixedLengthBruteforceImpl(
+  std::array<char, Length>& word,
+  const Callable&           doesMatch)
+{
+  if constexpr (Position == Length) {
+    return static_cast<bool>(
+      doesMatch(std::string_view{word.data(), word.size()}));
+  }
+  else {
+    for (char c : Alphabet) {
+      word[Position] = c;
+
+      if (fixedLengthBruteforceImpl<Alphabet, Length, Position + 1U>(
+            word, doesMatch)) {
+        return true;
+      }
     }
 
-    // iterate backwards over the indices.
-    for (std::size_t i{curWordLen}; i-- > 0U;) {
-      // advance the current index by 1 so the next character
-      // will be selected.
-      ++(indices[i]);
+    return false;
+  }
+}
+} // namespace detail
 
-      // if it reached the end of the alphabet -> reset
-      // and go increase the next index to the left.
-      if (indices[i] == alphabet.size()) {
-        indices[i] = 0U;
+/*!
+ * \brief Bruteforce algorithm for a word length known at compile time.
+ * \param doesMatch Callable that takes a std::string_view and determines if
+ *                  it matches.
+ * \return The first word that matched.
+ * \throws KeyspaceExhaustedException if none of the words of length
+ *         'Length' matched.
+ *
+ * Tries the words of length 'Length' over 'Alphabet', which has to be a
+ * constexpr std::array<char, N> with static storage duration, in the order
+ * of bruteforce. As both are template parameters the words are generated
+ * into a std::array<char, Length> by 'Length' nested loops over a constant
+ * alphabet, which the compiler unrolls and keeps in registers.
+ **/
+template<const auto& Alphabet, std::size_t Length, typename Callable>
+std::string fixedLengthBruteforce(const Callable& doesMatch)
+{
+  const KeyspaceExhaustedException::clock::time_point start{
+    KeyspaceExhaustedException::clock::now()};
+  std::uint64_t            candidateCount{0U};
+  std::array<char, Length> word{};
+
+  const auto countingDoesMatch
+    = [&doesMatch, &candidateCount](std::string_view candidate) {
+        ++candidateCount;
+        return doesMatch(candidate);
+      };
+
+  if (detail::fixedLengthBruteforceImpl<Alphabet, Length, 0U>(
+        word, countingDoesMatch)) {
+    return std::string{word.data(), word.size()};
+  }
+
+  throw KeyspaceExhaustedException{
+    Length,
+    Length,
+    candidateCount,
+    KeyspaceExhaustedException::clock::now() - start};
+}
+
+/*!
+ * \brief The position of a word among the words of an alphabet in the
+ *        order of bruteforce.
+ **/
+struct ResumePoint {
+  std::size_t   wordLength; /*!< The length of the word */
+  KeyspaceIndex index;      /*!< The index of the word among the words of
+                             *   its length, see Odometer::seek.
+                             **/
+};
+
+/*!
+ * \brief The options of limitedBruteforce.
+ **/
+struct BruteforceOptions {
+  std::size_t minLength{0U}; /*!< The length of the shortest words */
+
+  /*!
+   * \brief The length of the longest words, nullopt for the size of the
+   *        alphabet.
+   **/
+  std::optional<std::size_t> maxLength{};
+
+  SearchLimits limits{}; /*!< When to stop early */
+
+  /*!
+   * \brief The word to begin with, nullopt for the first word of
+   *        minLength. Usually the resumePoint of a previous
+   *        BruteforceResult. Words shorter than minLength are skipped, the
+   *        index must be less than the amount of words of its length.
+   **/
+  std::optional<ResumePoint> resumeFrom{};
+};
+
+/*!
+ * \brief The outcome of limitedBruteforce.
+ **/
+struct BruteforceResult {
+  using clock = SearchLimits::clock;
+
+  /*!
+   * \brief How the search ended.
+   **/
+  enum class Status {
+    Found,     /*!< A word matched */
+    Exhausted, /*!< None of the words matched */
+    Stopped    /*!< A limit was hit before all the words were tried */
+  };
+
+  Status                     status;
+  std::optional<std::string> match; /*!< The match if status is Found */
+
+  /*!
+   * \brief Why the search was stopped if status is Stopped.
+   **/
+  std::optional<StopReason> stopReason;
+
+  std::uint64_t   candidateCount; /*!< The amount of words tried */
+  clock::duration duration;       /*!< The duration the search took */
+
+  /*!
+   * \brief The first word not tried if status is Stopped, to be passed as
+   *        BruteforceOptions::resumeFrom to continue the search.
+   **/
+  std::optional<ResumePoint> resumePoint;
+};
+
+/*!
+ * \brief Bruteforce algorithm that may be stopped early.
+ * \param doesMatch Callable to determine if the current string matches.
+ * \param alphabet The alphabet to use.
+ * \param options The options, see BruteforceOptions.
+ * \return The BruteforceResult.
+ *
+ * Tries the same words in the same order as bruteforce, but returns rather
+ * than throwing if none of them matched and stops as soon as one of the
+ * options.limits is hit. A stopped search is continued by passing its
+ * resumePoint as options.resumeFrom, so time boxed searches can be spread
+ * over several runs.
+ **/
+template<std::size_t AlphabetSize, typename Callable>
+BruteforceResult limitedBruteforce(
+  const Callable&                       doesMatch,
+  const std::array<char, AlphabetSize>& alphabet,
+  const BruteforceOptions&              options)
+{
+  using clock = BruteforceResult::clock;
+
+  const clock::time_point start{clock::now()};
+  const std::size_t       maxLength{options.maxLength.value_or(AlphabetSize)};
+  SearchLimiter           limiter{options.limits};
+
+  std::size_t   firstLength{options.minLength};
+  KeyspaceIndex firstIndex{0U};
+
+  if (
+    options.resumeFrom
+    and options.resumeFrom->wordLength >= options.minLength) {
+    firstLength = options.resumeFrom->wordLength;
+    firstIndex  = options.resumeFrom->index;
+  }
+
+  Odometer<AlphabetSize> odometer{alphabet, maxLength};
+
+  for (std::size_t curWordLen{firstLength}; curWordLen <= maxLength;
+       ++curWordLen) {
+    KeyspaceIndex index{curWordLen == firstLength ? firstIndex : 0U};
+    odometer.seek(curWordLen, index);
+
+    do {
+      if (const std::optional<StopReason> reason{limiter.next()}) {
+        return BruteforceResult{
+          BruteforceResult::Status::Stopped,
+          std::nullopt,
+          reason,
+          limiter.getCandidateCount(),
+          clock::now() - start,
+          ResumePoint{curWordLen, index}};
       }
-      else {
-        // if the current index didn't reach the end
-        // create the new word from the new indices.
-        goto newIndices;
+
+      if (doesMatch(odometer.getWord())) {
+        return BruteforceResult{
+          BruteforceResult::Status::Found,
+          odometer.getWord(),
+          std::nullopt,
+          limiter.getCandidateCount(),
+          clock::now() - start,
+          std::nullopt};
       }
-    }
 
-    // if the above for loop exits and control flow reaches here
-    // -> advance to the next word length.
+      ++index;
+    } while (odometer.advance());
   }
 
-  // the algorithm should always find a match.
-  PL_THROW_WITH_SOURCE_INFO(
-    NoMatchInBruteforceAlgorithmException,
-    "Bruteforce algorithm found no match");
-  return "";
+  return BruteforceResult{
+    BruteforceResult::Status::Exhausted,
+    std::nullopt,
+    std::nullopt,
+    limiter.getCandidateCount(),
+    clock::now() - start,
+    std::nullopt};
 }
 } // namespace itsp3
 #endif // INCG_ITSP3_BRUTEFORCE_HPP
@@ -0,0 +1,528 @@
+/*!
+ * \file candidate_batch.hpp
+ * \brief Exports the CandidateBatch type as well as lazy sources of
+ *        candidates that fill CandidateBatches and adapters that filter
+ *        and transform the candidates of other sources.
+ *
+ * A source is any type with a member function bool next(CandidateBatch&)
+ * that replaces the contents of the batch with the candidates that follow
+ * the ones of the previous call and returns false once it has none left.
+ * Sources and adapters are templates that are composed at compile time,
+ * so pulling a batch through a pipeline involves neither virtual calls nor
+ * allocations.
+ **/
+#ifndef INCG_ITSP3_CANDIDATE_BATCH_HPP
+#define INCG_ITSP3_CANDIDATE_BATCH_HPP
+#include "keyspace_index.hpp" // itsp3::KeyspaceIndex
+#include "odometer.hpp"       // itsp3::Odometer
+#include "work_stealing.hpp"  // itsp3::KeyspaceRange
+#include <algorithm>          // std::min, std::max
+#include <array>              // std::array
+#include <ciso646>            // not
+#include <cstddef>            // std::size_t
+#include <optional>           // std::optional
+#include <string>             // std::string
+#include <string_view>        // std::string_view
+#include <utility>            // std::move
+#include <vector>             // std::vector
+
+namespace itsp3 {
+/*!
+ * \brief A batch of candidates stored in a single contiguous buffer.
+ *
+ * Holds up to a fixed amount of candidates of up to a fixed length. Both
+ * buffers are allocated once on construction, so refilling a batch never
+ * allocates. The candidates are accessible as an array of
+ * std::string_view, which is what batch hashing functions such as
+ * bcryptHashBatch take.
+ **/
+class CandidateBatch {
+public:
+  using this_type = CandidateBatch;
+
+  /*!
+   * \brief Creates an empty CandidateBatch.
+   * \param capacity The maximum amount of candidates, 0 is treated as 1.
+   * \param maxLength The maximum length of a candidate.
+   **/
+  CandidateBatch(std::size_t capacity, std::size_t maxLength);
+
+  CandidateBatch(const this_type&) = delete;
+
+  this_type& operator=(const this_type&) = delete;
+
+  CandidateBatch(this_type&&) noexcept = default;
+
+  this_type& operator=(this_type&&) noexcept = default;
+
+  /*!
+   * \brief Read accessor for the maximum amount of candidates.
+   * \return The capacity.
+   **/
+  std::size_t getCapacity() const noexcept;
+
+  /*!
+   * \brief Read accessor for the maximum length of a candidate.
+   * \return The maximum length.
+   **/
+  std::size_t getMaxLength() const noexcept;
+
+  /*!
+   * \brief Read accessor for the amount of candidates.
+   * \return The amount of candidates.
+   **/
+  std::size_t size() const noexcept;
+
+  /*!
+   * \brief Checks whether this batch holds no candidates.
+   * \return true if size() is 0, otherwise false.
+   **/
+  bool empty() const noexcept;
+
+  /*!
+   * \brief Checks whether this batch can't take another candidate.
+   * \return true if size() is getCapacity(), otherwise false.
+   **/
+  bool isFull() const noexcept;
+
+  /*!
+   * \brief Removes all the candidates.
+   **/
+  void clear() noexcept;
+
+  /*!
+   * \brief Appends a candidate.
+   * \param candidate The candidate, is copied into this batch.
+   * \return true if 'candidate' was appended, false if it is longer than
+   *         getMaxLength().
+   * \warning This batch may not be full.
+   **/
+  bool push(std::string_view candidate) noexcept;
+
+  /*!
+   * \brief Accesses a candidate.
+   * \param index The index of the candidate, less than size().
+   * \return A view of the candidate, valid until this batch is modified.
+   **/
+  std::string_view operator[](std::size_t index) const noexcept;
+
+  /*!
+   * \brief Accesses the views of all the candidates.
+   * \return Pointer to the size() views.
+   **/
+  const std::string_view* data() const noexcept;
+
+  const std::string_view* begin() const noexcept;
+
+  const std::string_view* end() const noexcept;
+
+private:
+  std::size_t                   m_maxLength;
+  std::vector<char>             m_buffer; /*!< Candidate i begins at
+                                           *   i * m_maxLength.
+                                           **/
+  std::vector<std::string_view> m_views;  /*!< Capacity many, the first
+                                           *   m_size are used.
+                                           **/
+  std::size_t                   m_size;
+};
+
+/*!
+ * \brief Source of the words over an alphabet in the order of bruteforce.
+ * \note The batches filled must take words of up to the maximum length.
+ **/
+template<std::size_t AlphabetSize>
+class OdometerSource {
+public:
+  using this_type     = OdometerSource;
+  using alphabet_type = std::array<char, AlphabetSize>;
+
+  /*!
+   * \brief Creates an OdometerSource.
+   * \param alphabet The alphabet to use.
+   * \param minLength The length of the shortest words.
+   * \param maxLength The length of the longest words.
+   **/
+  OdometerSource(
+    const alphabet_type& alphabet,
+    std::size_t          minLength,
+    std::size_t          maxLength)
+    : m_odometer{alphabet, maxLength}
+    , m_maxLength{maxLength}
+    , m_isExhausted{minLength > maxLength}
+  {
+    if (not m_isExhausted) {
+      m_odometer.reset(minLength);
+    }
+  }
+
+  /*!
+   * \brief Fills a batch with the next words.
+   * \param batch The batch to fill.
+   * \return false if there were no words left, otherwise true.
+   **/
+  bool next(CandidateBatch& batch)
+  {
+    batch.clear();
+
+    while (not m_isExhausted and not batch.isFull()) {
+      batch.push(m_odometer.getWord());
+
+      if (not m_odometer.advance()) {
+        const std::size_t nextLength{m_odometer.getWordLength() + 1U};
+
+        if (nextLength > m_maxLength) {
+          m_isExhausted = true;
+        }
+        else {
+          m_odometer.reset(nextLength);
+        }
+      }
+    }
+
+    return not batch.empty();
+  }
+
+private:
+  Odometer<AlphabetSize> m_odometer;
+  std::size_t            m_maxLength;
+  bool                   m_isExhausted;
+};
+
+/*!
+ * \brief Source of the words at a range of indices among the words of one
+ *        length over an alphabet, in the order of bruteforce.
+ *
+ * Lets the workers of parallelBruteforce pull the chunks handed out by the
+ * WorkStealingScheduler in batches. The range may be cut short while it is
+ * being pulled from, for instance once another worker found a match at a
+ * lower index.
+ * \note The batches filled must take words of up to the maximum length.
+ **/
+template<std::size_t AlphabetSize>
+class KeyspaceRangeSource {
+public:
+  using this_type     = KeyspaceRangeSource;
+  using alphabet_type = std::array<char, AlphabetSize>;
+
+  /*!
+   * \brief Creates a KeyspaceRangeSource whose range is empty.
+   * \param alphabet The alphabet to use.
+   * \param maxLength The length of the longest words that will be used.
+   **/
+  KeyspaceRangeSource(const alphabet_type& alphabet, std::size_t maxLength)
+    : m_odometer{alphabet, maxLength}, m_range{0U, 0U}
+  {
+  }
+
+  /*!
+   * \brief Sets the range of words to generate.
+   * \param wordLength The length of the words, may not exceed the
+   *                   maximum length.
+   * \param range The indices of the words among the words of length
+   *              'wordLength', see Odometer::seek.
+   **/
+  void seek(std::size_t wordLength, KeyspaceRange range)
+  {
+    m_range = range;
+
+    if (m_range.begin < m_range.end) {
+      m_odometer.seek(wordLength, m_range.begin);
+    }
+  }
+
+  /*!
+   * \brief Cuts the range short.
+   * \param end The index one past the last word to generate at most.
+   * \note Has no effect if 'end' is past the end of the range, the words
+   *       already generated are not taken back.
+   **/
+  void truncate(KeyspaceIndex end) noexcept
+  {
+    m_range.end = std::max(m_range.begin, std::min(m_range.end, end));
+  }
+
+  /*!
+   * \brief Read accessor for the index of the next word.
+   * \return The index of the word the next batch begins with, the end of
+   *         the range if there are no words left.
+   **/
+  KeyspaceIndex getIndex() const noexcept { return m_range.begin; }
+
+  /*!
+   * \brief Checks whether all the words of the range have been generated.
+   * \return true if there are no words left, otherwise false.
+   **/
+  bool isExhausted() const noexcept { return m_range.begin == m_range.end; }
+
+  /*!
+   * \brief Fills a batch with the next words.
+   * \param batch The batch to fill.
+   * \return false if there were no words left, otherwise true.
+   **/
+  bool next(CandidateBatch& batch)
+  {
+    batch.clear();
+
+    while (not isExhausted() and not batch.isFull()) {
+      batch.push(m_odometer.getWord());
+      ++m_range.begin;
+      m_odometer.advance();
+    }
+
+    return not batch.empty();
+  }
+
+  /*!
+   * \brief Checks the next words in place, without copying them into a
+   *        batch.
+   * \param doesMatch Callable that takes a std::string_view and determines
+   *                  if it matches.
+   * \param maxCount The amount of words to check at most.
+   * \return The index of the first word that matched or nullopt if none
+   *         did. The words up to and including the match are consumed.
+   * \note For callables so cheap that copying the words would dominate.
+   **/
+  template<typename Callable>
+  std::optional<KeyspaceIndex> find(
+    const Callable& doesMatch,
+    std::size_t     maxCount)
+  {
+    for (; maxCount != 0U and not isExhausted(); --maxCount) {
+      const KeyspaceIndex index{m_range.begin};
+      const bool isMatch{static_cast<bool>(
+        doesMatch(std::string_view{m_odometer.getWord()}))};
+      ++m_range.begin;
+      m_odometer.advance();
+
+      if (isMatch) {
+        return index;
+      }
+    }
+
+    return std::nullopt;
+  }
+
+private:
+  Odometer<AlphabetSize> m_odometer;
+  KeyspaceRange          m_range; /*!< The words not yet generated */
+};
+
+/*!
+ * \brief Source of the words of a wordlist, in order.
+ * \note Trailing carriage returns are stripped and empty lines are
+ *       skipped, like dictionaryAttack does. Words longer than the
+ *       batches can take are skipped.
+ **/
+class WordlistSource {
+public:
+  using this_type = WordlistSource;
+
+  /*!
+   * \brief Creates a WordlistSource.
+   * \param wordlist The newline separated words, usually the contents of
+   *                 a MappedFile. Must outlive the WordlistSource.
+   **/
+  explicit WordlistSource(std::string_view wordlist) noexcept;
+
+  /*!
+   * \brief Fills a batch with the next words.
+   * \param batch The batch to fill.
+   * \return false if there were no words left, otherwise true.
+   **/
+  bool next(CandidateBatch& batch);
+
+private:
+  std::string_view m_wordlist;
+  std::size_t      m_offset; /*!< The offset of the next line */
+};
+
+/*!
+ * \brief Adapter that passes on the candidates of a source for which a
+ *        predicate returns true.
+ * \see filterCandidates
+ **/
+template<typename Source, typename Predicate>
+class FilterSource {
+public:
+  using this_type = FilterSource;
+
+  /*!
+   * \brief Creates a FilterSource.
+   * \param source The source to filter.
+   * \param predicate Callable that takes a std::string_view and returns
+   *                  whether to keep it.
+   **/
+  FilterSource(Source source, Predicate predicate)
+    : m_source{std::move(source)}
+    , m_predicate{std::move(predicate)}
+    , m_pending{}
+    , m_pendingIndex{0U}
+  {
+  }
+
+  /*!
+   * \brief Fills a batch with the next candidates that are kept.
+   * \param batch The batch to fill.
+   * \return false if there were no candidates left, otherwise true.
+   * \note The candidates are pulled from the source in batches the size
+   *       of 'batch'.
+   **/
+  bool next(CandidateBatch& batch)
+  {
+    batch.clear();
+
+    if (not m_pending) {
+      m_pending.emplace(batch.getCapacity(), batch.getMaxLength());
+    }
+
+    while (not batch.isFull()) {
+      if (m_pendingIndex == m_pending->size()) {
+        m_pendingIndex = 0U;
+
+        if (not m_source.next(*m_pending)) {
+          break;
+        }
+      }
+
+      const std::string_view candidate{(*m_pending)[m_pendingIndex++]};
+
+      if (m_predicate(candidate)) {
+        batch.push(candidate);
+      }
+    }
+
+    return not batch.empty();
+  }
+
+private:
+  Source                        m_source;
+  Predicate                     m_predicate;
+  std::optional<CandidateBatch> m_pending; /*!< From m_source */
+  std::size_t                   m_pendingIndex;
+};
+
+/*!
+ * \brief Adapter that passes on the candidates of a source transformed.
+ * \see transformCandidates
+ **/
+template<typename Source, typename Transform>
+class TransformSource {
+public:
+  using this_type = TransformSource;
+
+  /*!
+   * \brief Creates a TransformSource.
+   * \param source The source to transform.
+   * \param transform Callable that takes a std::string_view and a
+   *                  std::string& to write the transformed candidate to.
+   *                  The std::string is reused, so its capacity is
+   *                  retained.
+   **/
+  TransformSource(Source source, Transform transform)
+    : m_source{std::move(source)}
+    , m_transform{std::move(transform)}
+    , m_pending{}
+    , m_pendingIndex{0U}
+    , m_buffer{}
+  {
+  }
+
+  /*!
+   * \brief Fills a batch with the next candidates transformed.
+   * \param batch The batch to fill.
+   * \return false if there were no candidates left, otherwise true.
+   * \note Transformed candidates longer than 'batch' can take are
+   *       skipped.
+   **/
+  bool next(CandidateBatch& batch)
+  {
+    batch.clear();
+
+    if (not m_pending) {
+      m_pending.emplace(batch.getCapacity(), batch.getMaxLength());
+      m_buffer.reserve(batch.getMaxLength());
+    }
+
+    while (not batch.isFull()) {
+      if (m_pendingIndex == m_pending->size()) {
+        m_pendingIndex = 0U;
+
+        if (not m_source.next(*m_pending)) {
+          break;
+        }
+      }
+
+      m_buffer.clear();
+      m_transform((*m_pending)[m_pendingIndex++], m_buffer);
+      batch.push(m_buffer);
+    }
+
+    return not batch.empty();
+  }
+
+private:
+  Source                        m_source;
+  Transform                     m_transform;
+  std::optional<CandidateBatch> m_pending; /*!< From m_source */
+  std::size_t                   m_pendingIndex;
+  std::string                   m_buffer; /*!< Transformed candidate */
+};
+
+/*!
+ * \brief Creates a FilterSource.
+ * \param source The source to filter.
+ * \param predicate The predicate, see FilterSource.
+ * \return The FilterSource.
+ **/
+template<typename Source, typename Predicate>
+FilterSource<Source, Predicate> filterCandidates(
+  Source    source,
+  Predicate predicate)
+{
+  return FilterSource<Source, Predicate>{
+    std::move(source), std::move(predicate)};
+}
+
+/*!
+ * \brief Creates a TransformSource.
+ * \param source The source to transform.
+ * \param transform The transformation, see TransformSource.
+ * \return The TransformSource.
+ **/
+template<typename Source, typename Transform>
+TransformSource<Source, Transform> transformCandidates(
+  Source    source,
+  Transform transform)
+{
+  return TransformSource<Source, Transform>{
+    std::move(source), std::move(transform)};
+}
+
+/*!
+ * \brief Pulls batches from a source until a batch verifier finds a match.
+ * \param source The source to pull the candidates from.
+ * \param batch The batch to pull the candidates into, determines how many
+ *              candidates the verifier is given at once.
+ * \param findMatch Callable that takes a const CandidateBatch& and returns
+ *                  a std::optional<std::size_t> with the index of the
+ *                  first candidate that matches or nullopt if none does.
+ * \return The first candidate that matched or nullopt if the source ran
+ *         out of candidates.
+ **/
+template<typename Source, typename BatchVerifier>
+std::optional<std::string> findInBatches(
+  Source&              source,
+  CandidateBatch&      batch,
+  const BatchVerifier& findMatch)
+{
+  while (source.next(batch)) {
+    if (const std::optional<std::size_t> index{findMatch(batch)}) {
+      return std::string{batch[*index]};
+    }
+  }
+
+  return std::nullopt;
+}
+} // namespace itsp3
+#endif // INCG_ITSP3_CANDIDATE_BATCH_HPP
@@ -4,11 +4,19 @@
  **/
 #ifndef INCG_ITSP3_CHECK_PASSWORD_HPP
 #define INCG_ITSP3_CHECK_PASSWORD_HPP
+#include <cstddef>     // std::size_t
 #include <iosfwd>      // std::ostream
 #include <string>      // std::string
 #include <string_view> // std::string_view
 
 namespace itsp3 {
+/*!
+ * \brief The minimum length of an acceptable password.
+ * \note Shorter passwords are rejected with PasswordCheckingResult::TooShort,
+ *       so there is no point in trying them when cracking passwords.
+ **/
+inline constexpr std::size_t minimumPasswordLength{8U};
+
 /*!
  * \brief Scoped enum type used as the result of the checkPassword function.
  **/
@@ -28,6 +36,86 @@ enum class PasswordCheckingResult {
   Ok               /*!< The password was determined to be acceptable */
 };
 
+/*!
+ * \brief Checks if 'c' is a lower case character.
+ * \param c The character to check.
+ * \return true if 'c' is considered a lower case character, otherwise false.
+ * \note These function are used in place of the (C) functions exported by the
+ *       <cctype> header, as those include some (stupid) assertions on some
+ *       implementations if the character supplied is outside of the range
+ *       of ASCII characters 0x00 through 0x7F (both inclusive) as chars
+ *       being byte sized object can hold values of the range 0x00 through
+ *       0xFF (both inclusive) (assuming CHAR_BIT == 8, that is bytes being
+ *       8 bit large). These funny assertion cause the application to crash
+ *       on bad input, which is just ridiculous.
+ **/
+bool isLowerCase(char c) noexcept;
+
+/*!
+ * \brief Checks if 'c' is an upper case character.
+ * \param c The character to check.
+ * \return true if 'c' is an upper case character, false otherwise.
+ **/
+bool isUpperCase(char c) noexcept;
+
+/*!
+ * \brief Checks if 'c' is a 'number', that is 'c' compares equal to '0',
+ *        '1', '2', '3', '4', '5', '6', '7', '8', or '9'.
+ * \param c The characeter to check.
+ * \return true if 'c' is considered to be a 'number', false otherwise.
+ **/
+bool isNumber(char c) noexcept;
+
+/*!
+ * \brief Checks if 'c' is a 'special' character, that is 'c' compares
+ *        equal to either ' ', '!', '"', '#', '$', '%',
+ *        '&', '\'', '(', ')', '*', '+', ',', '-', '.', '/', ':', ';',
+ *        '<', '=', '>', '?', '@', '[', '\\', ']', '^', '_', '`', '{',
+ *        '|', '}', or '~'
+ * \param c The character to check.
+ * \return true if 'c' is considered to be a special character, otherwise
+ *         false.
+ **/
+bool isSpecialCharacter(char c) noexcept;
+
+/*!
+ * \brief The rules a password has to satisfy to be accepted.
+ *
+ * Describes the checks of checkPassword, so that crackers can avoid
+ * trying passwords that could never have been set.
+ **/
+struct PasswordPolicy {
+  /*!
+   * \brief The policy that accepts any password.
+   * \return The policy.
+   **/
+  static PasswordPolicy none() noexcept;
+
+  /*!
+   * \brief The policy addUser enforces.
+   * \return The policy of checkPassword if the password checks are enabled
+   *         (ENABLE_PW_CHECKS), otherwise none().
+   **/
+  static PasswordPolicy active() noexcept;
+
+  /*!
+   * \brief Checks whether a password satisfies this policy.
+   * \param username The username the password belongs to.
+   * \param password The password to check.
+   * \return true if 'password' is acceptable, otherwise false.
+   **/
+  bool isSatisfiedBy(
+    std::string_view username,
+    std::string_view password) const noexcept;
+
+  std::size_t minLength{minimumPasswordLength}; /*!< The minimum length */
+  bool requiresLowerCase{true};        /*!< Needs a lower case character */
+  bool requiresUpperCase{true};        /*!< Needs an upper case character */
+  bool requiresNumber{true};           /*!< Needs a number */
+  bool requiresSpecialCharacter{true}; /*!< Needs a special character */
+  bool rejectsUsername{true}; /*!< May not be equal to the username */
+};
+
 /*!
  * \brief Prints extended information for a PasswordCheckingResult enumerator
  *        to an ostream.
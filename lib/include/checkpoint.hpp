@@ -0,0 +1,190 @@
+/*!
+ * \file checkpoint.hpp
+ * \brief Exports types to save the progress of a bruteforce run to a file
+ *        so that it can be resumed later on.
+ **/
+#ifndef INCG_ITSP3_CHECKPOINT_HPP
+#define INCG_ITSP3_CHECKPOINT_HPP
+#include "keyspace_index.hpp" // itsp3::KeyspaceIndex
+#include "work_stealing.hpp"  // itsp3::KeyspaceRange
+#include <chrono>             // std::chrono::steady_clock
+#include <cstddef>            // std::size_t
+#include <mutex>              // std::mutex
+#include <pl/except.hpp>      // PL_DEFINE_EXCEPTION_TYPE
+#include <stdexcept>          // std::runtime_error
+#include <string>             // std::string
+#include <vector>             // std::vector
+
+namespace itsp3 {
+PL_DEFINE_EXCEPTION_TYPE(CheckpointException, std::runtime_error);
+
+/*!
+ * \brief The progress of a bruteforce run.
+ *
+ * Holds the word length currently being searched and the ranges of the
+ * keyspace of that word length that have been searched completely.
+ * All the shorter word lengths have been searched completely.
+ **/
+class Checkpoint {
+public:
+  using this_type = Checkpoint;
+
+  /*!
+   * \brief Loads a Checkpoint from a file.
+   * \param filePath The path to the file to load from.
+   * \return The Checkpoint loaded.
+   * \throws CheckpointException if the file could not be read or is
+   *         not a valid checkpoint file.
+   **/
+  static Checkpoint load(const std::string& filePath);
+
+  /*!
+   * \brief Creates a Checkpoint without any progress.
+   * \param target Identifies what is being bruteforced, e.g. the username
+   *               whose password is being cracked.
+   * \param alphabet The characters of the alphabet used, in order.
+   **/
+  Checkpoint(std::string target, std::string alphabet);
+
+  /*!
+   * \brief Saves this Checkpoint to a file.
+   * \param filePath The path to the file to save to.
+   * \throws CheckpointException on failure.
+   * \note Writes to a temporary file that is then renamed to 'filePath',
+   *       so that 'filePath' always holds a complete checkpoint, even if
+   *       the application is killed while saving.
+   **/
+  void save(const std::string& filePath) const;
+
+  /*!
+   * \brief Read accessor for what is being bruteforced.
+   * \return The target.
+   **/
+  const std::string& getTarget() const noexcept;
+
+  /*!
+   * \brief Read accessor for the alphabet used.
+   * \return The characters of the alphabet.
+   **/
+  const std::string& getAlphabet() const noexcept;
+
+  /*!
+   * \brief Read accessor for the word length currently being searched.
+   * \return The word length.
+   **/
+  std::size_t getWordLength() const noexcept;
+
+  /*!
+   * \brief Read accessor for the ranges searched completely.
+   * \return The ranges, sorted and merged so that no two of them overlap
+   *         or touch.
+   **/
+  const std::vector<KeyspaceRange>& getCompletedRanges() const noexcept;
+
+  /*!
+   * \brief Advances to a word length.
+   * \param wordLength The word length to search next.
+   * \note Forgets the completed ranges if 'wordLength' differs from the
+   *       current word length.
+   **/
+  void setWordLength(std::size_t wordLength);
+
+  /*!
+   * \brief Records that a range of the current word length has been
+   *        searched completely.
+   * \param range The range searched. Empty ranges are ignored.
+   **/
+  void markCompleted(KeyspaceRange range);
+
+  /*!
+   * \brief Calculates the ranges of the current word length that still
+   *        have to be searched.
+   * \param wordCount The amount of words of the current word length.
+   * \return The ranges not yet searched, in ascending order.
+   **/
+  std::vector<KeyspaceRange> getRemainingRanges(KeyspaceIndex wordCount) const;
+
+  /*!
+   * \brief Calculates the amount of words of the current word length that
+   *        have been searched.
+   * \return The amount of words searched.
+   **/
+  KeyspaceIndex getCompletedCount() const noexcept;
+
+private:
+  std::string                m_target;
+  std::string                m_alphabet;
+  std::size_t                m_wordLength;
+  std::vector<KeyspaceRange> m_completedRanges;
+};
+
+/*!
+ * \brief Records the progress of a bruteforce run in a Checkpoint and
+ *        periodically saves it to a file.
+ * \note Thread safe.
+ **/
+class Checkpointer {
+public:
+  using this_type = Checkpointer;
+  using clock     = std::chrono::steady_clock;
+
+  static const clock::duration s_defaultSaveInterval; /*!< 30 seconds */
+
+  /*!
+   * \brief Creates a Checkpointer.
+   * \param filePath The path of the file to save the checkpoint to.
+   * \param checkpoint The checkpoint to continue from.
+   * \param saveInterval The minimum duration between two saves.
+   **/
+  Checkpointer(
+    std::string     filePath,
+    Checkpoint      checkpoint,
+    clock::duration saveInterval = s_defaultSaveInterval);
+
+  Checkpointer(const this_type&) = delete;
+
+  this_type& operator=(const this_type&) = delete;
+
+  /*!
+   * \brief Fetches a copy of the current checkpoint.
+   * \return The current checkpoint.
+   **/
+  Checkpoint getCheckpoint() const;
+
+  /*!
+   * \brief Advances to a word length and saves the checkpoint.
+   * \param wordLength The word length to search next.
+   * \throws CheckpointException if saving failed.
+   * \see Checkpoint::setWordLength
+   **/
+  void beginWordLength(std::size_t wordLength);
+
+  /*!
+   * \brief Records that a range has been searched completely, saves the
+   *        checkpoint if the save interval has elapsed since the last save.
+   * \param range The range searched.
+   * \throws CheckpointException if saving failed.
+   **/
+  void markCompleted(KeyspaceRange range);
+
+  /*!
+   * \brief Saves the checkpoint.
+   * \throws CheckpointException if saving failed.
+   **/
+  void save();
+
+private:
+  /*!
+   * \brief Saves the checkpoint.
+   * \warning m_mutex must be locked by the caller.
+   **/
+  void saveLocked();
+
+  const std::string     m_filePath;
+  const clock::duration m_saveInterval;
+  mutable std::mutex    m_mutex;
+  Checkpoint            m_checkpoint;
+  clock::time_point     m_lastSave;
+};
+} // namespace itsp3
+#endif // INCG_ITSP3_CHECKPOINT_HPP
@@ -0,0 +1,171 @@
+/*!
+ * \file crack_target.hpp
+ * \brief Exports the CrackTarget type that checks candidate passwords of
+ *        a user against a hash resolved ahead of time.
+ **/
+#ifndef INCG_ITSP3_CRACK_TARGET_HPP
+#define INCG_ITSP3_CRACK_TARGET_HPP
+#include "bcrypt_kernel.hpp"   // itsp3::BcryptHash, itsp3::bcryptKeyLimit
+#include "candidate_batch.hpp" // itsp3::CandidateBatch
+#include "check_password.hpp"  // itsp3::PasswordPolicy
+#include "hashing_backend.hpp" // itsp3::HashBuffer, BCRYPT_HASHSIZE
+#include <cstddef>             // std::size_t
+#include <optional>            // std::optional
+#include <pl/except.hpp>       // PL_DEFINE_EXCEPTION_TYPE
+#include <stdexcept>           // std::runtime_error
+#include <string>              // std::string
+#include <string_view>         // std::string_view
+
+namespace itsp3 {
+PL_DEFINE_EXCEPTION_TYPE(CrackTargetException, std::runtime_error);
+
+/*!
+ * \brief Calculates how many characters of the passwords of a user affect
+ *        their hash.
+ * \param usernameLength The length of the username.
+ * \return The length beyond which the characters of a password are
+ *         ignored, as bcrypt only uses the first bcryptKeyLimit bytes of
+ *         the username followed by the password.
+ **/
+constexpr std::size_t significantPasswordLength(
+  std::size_t usernameLength) noexcept
+{
+  return usernameLength >= bcryptKeyLimit ? 0U
+                                          : bcryptKeyLimit - usernameLength;
+}
+
+/*!
+ * \brief The password hash of a user prepared for checking many candidate
+ *        passwords against it.
+ *
+ * Decodes the salt, cost and digest once, so that checking a candidate is
+ * nothing but hashing with the in-tree bcrypt kernel and comparing the raw
+ * digests: no file I/O, no allocations, no logging and no formatting or
+ * parsing of crypt strings.
+ * \note check may be called from several threads at once.
+ * \see Bcrypt::prepareCrackTarget
+ **/
+class CrackTarget {
+public:
+  using this_type = CrackTarget;
+
+  /*!
+   * \brief The length of the salt part of a hash, that is "$2a$",
+   *        the two digit cost, '$' and the 22 characters of the salt.
+   **/
+  static constexpr std::size_t s_saltLength{29U};
+
+  /*!
+   * \brief The length of a complete hash, the salt followed by the 31
+   *        characters of the digest.
+   **/
+  static constexpr std::size_t s_hashLength{s_saltLength + 31U};
+
+  /*!
+   * \brief Creates a CrackTarget.
+   * \param username The username whose password to crack.
+   * \param hash The hash of the user as stored in the binary file,
+   *             may be followed by null characters.
+   * \throws CrackTargetException if 'hash' is not a valid bcrypt hash or
+   *         'username' is longer than BCRYPT_HASHSIZE.
+   **/
+  CrackTarget(std::string_view username, std::string_view hash);
+
+  /*!
+   * \brief Checks whether a candidate is the password of the user.
+   * \param password The candidate password.
+   * \return true if 'password' is the password of the user, otherwise
+   *         false. Also false for candidates longer than BCRYPT_HASHSIZE,
+   *         which could never have been added.
+   * \note Compares the digests in constant time.
+   **/
+  bool check(std::string_view password) const;
+
+  /*!
+   * \brief Checks a batch of candidates at once.
+   * \param batch The candidates.
+   * \return The index of the first candidate in 'batch' that is the
+   *         password of the user or nullopt if none is.
+   * \note Hashes the candidates with bcryptVerifyBatch, so that they are
+   *       computed as many at a time as the CPU supports. Stops after the
+   *       group of bcryptMaxLaneCount candidates holding the first match.
+   *       The inputs are built on the stack, so checking does not
+   *       allocate.
+   **/
+  std::optional<std::size_t> findIn(const CandidateBatch& batch) const;
+
+  /*!
+   * \brief Checks the candidates of a batch that are worth checking.
+   * \param batch The candidates.
+   * \param policy The policy the password of the user satisfies.
+   * \return The index of the first candidate in 'batch' that is the
+   *         password of the user or nullopt if none is.
+   * \note Like findIn(batch), but the candidates for which
+   *       isWorthChecking returns false are not hashed.
+   **/
+  std::optional<std::size_t> findIn(
+    const CandidateBatch& batch,
+    const PasswordPolicy& policy) const;
+
+  /*!
+   * \brief Calculates the length of the longest candidates worth checking.
+   * \return The smaller of significantPasswordLength of the username and
+   *         BCRYPT_HASHSIZE. Longer candidates either have the same hash
+   *         as their prefix of this length or could never have been added.
+   **/
+  std::size_t getMaxPasswordLength() const noexcept;
+
+  /*!
+   * \brief Determines whether checking a candidate could find a password
+   *        not found by checking the shorter candidates.
+   * \param candidate The candidate password.
+   * \param policy The policy the password of the user satisfies.
+   * \return false if 'candidate' is longer than the greater of
+   *         getMaxPasswordLength() and the minimum length of 'policy', as
+   *         it then has the hash of a candidate of that length. Otherwise
+   *         whether 'candidate' satisfies 'policy'.
+   * \note A candidate of exactly that length stands in for the longer
+   *       passwords beginning with it when they are truncated, which may
+   *       satisfy 'policy' even though the candidate does not. Such
+   *       candidates are always worth checking.
+   **/
+  bool isWorthChecking(
+    std::string_view      candidate,
+    const PasswordPolicy& policy) const noexcept;
+
+  /*!
+   * \brief Read accessor for the username.
+   * \return The username.
+   **/
+  const std::string& getUsername() const noexcept;
+
+  /*!
+   * \brief Read accessor for the cost.
+   * \return The base 2 logarithm of the amount of iterations.
+   **/
+  int getCost() const noexcept;
+
+  /*!
+   * \brief Read accessor for the salt.
+   * \return The salt part of the hash, including the cost.
+   **/
+  std::string_view getSalt() const noexcept;
+
+private:
+  /*!
+   * \brief Implementation function of findIn.
+   * \param batch The candidates.
+   * \param policy The policy to skip the candidates not worth checking
+   *               with, nullptr to check all of them.
+   * \return The index of the first match or nullopt.
+   **/
+  std::optional<std::size_t> findInImpl(
+    const CandidateBatch& batch,
+    const PasswordPolicy* policy) const;
+
+  std::string m_username;
+  HashBuffer  m_salt; /*!< The null-terminated salt. */
+  BcryptHash  m_hash; /*!< The hash decoded. */
+};
+} // namespace itsp3
+#endif // INCG_ITSP3_CRACK_TARGET_HPP
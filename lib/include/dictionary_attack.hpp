@@ -0,0 +1,332 @@
+/*!
+ * \file dictionary_attack.hpp
+ * \brief Exports the multi-threaded dictionary attack, which tries the
+ *        words of a wordlist.
+ **/
+#ifndef INCG_ITSP3_DICTIONARY_ATTACK_HPP
+#define INCG_ITSP3_DICTIONARY_ATTACK_HPP
+#include "bruteforce.hpp"     // itsp3::NoMatchInBruteforceAlgorithmException
+#include "rules.hpp"          // itsp3::RuleSet, itsp3::Rule
+#include "work_stealing.hpp"  // itsp3::ChunkSizeTuner
+#include <algorithm>          // std::min, std::max
+#include <atomic>             // std::atomic
+#include <chrono>             // std::chrono::milliseconds
+#include <ciso646>            // not, and
+#include <condition_variable> // std::condition_variable
+#include <cstddef>            // std::size_t
+#include <cstdint>            // std::uint64_t
+#include <exception>          // std::exception_ptr, std::current_exception
+#include <functional>         // std::function
+#include <limits>             // std::numeric_limits
+#include <mutex>              // std::mutex, std::unique_lock
+#include <optional>           // std::optional
+#include <pl/except.hpp>      // PL_DEFINE_EXCEPTION_TYPE
+#include <string>             // std::string, std::to_string
+#include <string_view>        // std::string_view
+#include <thread>             // std::thread
+#include <utility>            // std::move
+#include <vector>             // std::vector
+
+namespace itsp3 {
+/*!
+ * \brief Thrown by dictionaryAttack if none of the words of the wordlist
+ *        matched.
+ * \note Derives from NoMatchInBruteforceAlgorithmException, so that it
+ *       may be caught as such.
+ **/
+PL_DEFINE_EXCEPTION_TYPE(
+  WordlistExhaustedException,
+  NoMatchInBruteforceAlgorithmException);
+
+/*!
+ * \brief The progress of a dictionary attack.
+ **/
+struct DictionaryProgress {
+  std::uint64_t byteOffset; /*!< All the words that begin before this
+                             *   offset into the wordlist have been tried.
+                             **/
+  std::uint64_t totalBytes;     /*!< The size of the wordlist. */
+  std::uint64_t candidateCount; /*!< The amount of candidates tried. */
+};
+
+/*!
+ * \brief The options of dictionaryAttack.
+ **/
+struct DictionaryAttackOptions {
+  /*!
+   * \brief The amount of worker threads to use, 0 is treated as 1.
+   **/
+  std::size_t threadCount{std::thread::hardware_concurrency()};
+
+  /*!
+   * \brief Invoked on the calling thread with the progress every
+   *        progressInterval and once more when the attack finishes.
+   *        Not invoked if empty.
+   **/
+  std::function<void(const DictionaryProgress&)> onProgress{};
+
+  /*!
+   * \brief The duration between two invocations of onProgress.
+   **/
+  std::chrono::milliseconds progressInterval{1000};
+
+  /*!
+   * \brief The rules to derive the candidates from each word with, nullptr
+   *        to try the words themselves.
+   **/
+  const RuleSet* rules{nullptr};
+};
+
+namespace detail {
+/*!
+ * \brief Finds the offset of the first line of a wordlist that begins at
+ *        or after an offset.
+ * \param wordlist The wordlist.
+ * \param offset The offset.
+ * \return The offset of the line or the size of 'wordlist' if there is
+ *         none.
+ * \note Not to be used directly.
+ **/
+inline std::size_t findLineBegin(
+  std::string_view wordlist,
+  std::size_t      offset) noexcept
+{
+  if (offset == 0U or offset >= wordlist.size()) {
+    return std::min(offset, wordlist.size());
+  }
+
+  if (wordlist[offset - 1U] == '\n') {
+    return offset;
+  }
+
+  const std::size_t newline{wordlist.find('\n', offset)};
+  return newline == std::string_view::npos ? wordlist.size() : newline + 1U;
+}
+} // namespace detail
+
+/*!
+ * \brief Multi-threaded dictionary attack.
+ * \param doesMatch Callable to determine if a word matches, takes a
+ *                  std::string_view like the one of parallelBruteforce.
+ *                  Will be called from several threads at once!
+ * \param wordlist The newline separated words to try, usually the
+ *                 contents of a MappedFile. Trailing carriage returns are
+ *                 stripped, empty lines are skipped.
+ * \param options The options.
+ * \return A candidate for which 'doesMatch' returned true, the first one
+ *         found.
+ * \throws WordlistExhaustedException if none of the candidates matched.
+ * \note Exceptions thrown by 'doesMatch' stop all the workers and are
+ *       rethrown.
+ *
+ * The workers claim chunks of bytes of the wordlist one after another,
+ * a worker tries the words that begin in its chunk, so that each word is
+ * tried exactly once, no matter where the chunk boundaries fall. The
+ * words are passed as views into 'wordlist', nothing is copied. The chunk
+ * sizes are tuned from the throughput measured by each worker, so that
+ * fast matchers are not slowed down by claiming chunks and slow ones,
+ * such as bcrypt, still stop shortly after a match was found.
+ * If rules are given, each rule is applied to each word in turn, into a
+ * buffer per worker that is reused for all the candidates.
+ **/
+template<typename Callable>
+std::string dictionaryAttack(
+  const Callable&                doesMatch,
+  std::string_view               wordlist,
+  const DictionaryAttackOptions& options = DictionaryAttackOptions{})
+{
+  static constexpr std::uint64_t noOffset{
+    std::numeric_limits<std::uint64_t>::max()};
+
+  // enough for the candidates derived from any sensible password, the
+  // buffers only grow if a longer one comes along.
+  static constexpr std::size_t initialBufferCapacity{256U};
+
+  const std::size_t workerCount{std::max<std::size_t>(options.threadCount, 1U)};
+  const RuleSet* const rules{options.rules};
+
+  std::atomic<std::uint64_t> nextOffset{0U};
+  std::atomic<std::uint64_t> candidateCount{0U};
+  std::atomic<bool>          hasFailed{false};
+
+  // the match is written at most once, so a mutex is fine.
+  std::mutex                 matchMutex{};
+  std::optional<std::string> match{};
+  std::atomic<bool>          hasMatch{false};
+
+  // the offset of the chunk each worker is working on, noOffset once it
+  // has finished.
+  std::vector<std::atomic<std::uint64_t>> chunkOffsets(workerCount);
+
+  for (std::atomic<std::uint64_t>& chunkOffset : chunkOffsets) {
+    chunkOffset.store(0U);
+  }
+
+  std::mutex                      finishedMutex{};
+  std::condition_variable         finishedCondition{};
+  std::size_t                     finishedCount{0U};
+  std::vector<std::exception_ptr> exceptions(workerCount);
+  std::vector<std::thread>        workers{};
+  workers.reserve(workerCount);
+
+  const auto work = [&](std::size_t worker) {
+    ChunkSizeTuner tuner{};
+    std::string    buffer{};
+    std::uint64_t  chunkCandidateCount{0U};
+
+    // returns whether the search is over.
+    const auto tryCandidate = [&](std::string_view candidate) {
+      ++chunkCandidateCount;
+
+      if (doesMatch(candidate)) {
+        std::lock_guard<std::mutex> lock{matchMutex};
+
+        if (not match) {
+          match = std::string{candidate};
+          hasMatch.store(true);
+        }
+
+        return true;
+      }
+
+      return hasMatch.load(std::memory_order_relaxed);
+    };
+
+    try {
+      if (rules != nullptr) {
+        buffer.reserve(initialBufferCapacity);
+      }
+
+      for (;;) {
+        if (
+          hasFailed.load(std::memory_order_relaxed)
+          or hasMatch.load(std::memory_order_relaxed)) {
+          break;
+        }
+
+        // claim the chunk before publishing its offset, so that the
+        // published offsets only ever grow.
+        const std::uint64_t chunkSize{tuner.getChunkSize()};
+        const std::uint64_t chunkBegin{nextOffset.fetch_add(chunkSize)};
+
+        if (chunkBegin >= wordlist.size()) {
+          break;
+        }
+
+        chunkOffsets[worker].store(chunkBegin);
+
+        const std::size_t chunkEnd{static_cast<std::size_t>(
+          std::min<std::uint64_t>(chunkBegin + chunkSize, wordlist.size()))};
+        const ChunkSizeTuner::clock::time_point chunkStart{
+          ChunkSizeTuner::clock::now()};
+        chunkCandidateCount = 0U;
+        bool isOver{false};
+
+        for (std::size_t lineBegin{detail::findLineBegin(
+               wordlist, static_cast<std::size_t>(chunkBegin))};
+             lineBegin < chunkEnd and not isOver;) {
+          const std::size_t newline{wordlist.find('\n', lineBegin)};
+          const std::size_t lineEnd{
+            newline == std::string_view::npos ? wordlist.size() : newline};
+          std::string_view word{
+            wordlist.substr(lineBegin, lineEnd - lineBegin)};
+
+          if (not word.empty() and word.back() == '\r') {
+            word.remove_suffix(1U);
+          }
+
+          // empty lines are skipped.
+          if (not word.empty() and rules == nullptr) {
+            isOver = tryCandidate(word);
+          }
+          else if (not word.empty()) {
+            for (const Rule& rule : rules->getRules()) {
+              rule.apply(word, buffer);
+
+              if (tryCandidate(buffer)) {
+                isOver = true;
+                break;
+              }
+            }
+          }
+
+          lineBegin = lineEnd + 1U;
+        }
+
+        candidateCount.fetch_add(
+          chunkCandidateCount, std::memory_order_relaxed);
+        tuner.update(
+          chunkEnd - chunkBegin, ChunkSizeTuner::clock::now() - chunkStart);
+      }
+    }
+    catch (...) {
+      exceptions[worker] = std::current_exception();
+      hasFailed.store(true);
+    }
+
+    chunkOffsets[worker].store(noOffset);
+
+    {
+      std::lock_guard<std::mutex> lock{finishedMutex};
+      ++finishedCount;
+    }
+
+    finishedCondition.notify_one();
+  };
+
+  const auto reportProgress = [&] {
+    if (not options.onProgress) {
+      return;
+    }
+
+    std::uint64_t byteOffset{std::min<std::uint64_t>(
+      nextOffset.load(), wordlist.size())};
+
+    for (const std::atomic<std::uint64_t>& chunkOffset : chunkOffsets) {
+      byteOffset = std::min(byteOffset, chunkOffset.load());
+    }
+
+    options.onProgress(
+      DictionaryProgress{byteOffset, wordlist.size(), candidateCount.load()});
+  };
+
+  for (std::size_t worker{0U}; worker < workerCount; ++worker) {
+    workers.emplace_back(work, worker);
+  }
+
+  {
+    std::unique_lock<std::mutex> lock{finishedMutex};
+
+    while (not finishedCondition.wait_for(
+      lock, options.progressInterval, [&finishedCount, workerCount] {
+        return finishedCount == workerCount;
+      })) {
+      lock.unlock();
+      reportProgress();
+      lock.lock();
+    }
+  }
+
+  for (std::thread& thread : workers) {
+    thread.join();
+  }
+
+  reportProgress();
+
+  for (const std::exception_ptr& exception : exceptions) {
+    if (exception) {
+      std::rethrow_exception(exception);
+    }
+  }
+
+  if (not match) {
+    PL_THROW_WITH_SOURCE_INFO(
+      WordlistExhaustedException,
+      "None of the " + std::to_string(candidateCount.load())
+        + " candidates of the wordlist matched");
+  }
+
+  return std::move(*match);
+}
+} // namespace itsp3
+#endif // INCG_ITSP3_DICTIONARY_ATTACK_HPP
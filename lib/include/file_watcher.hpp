@@ -0,0 +1,61 @@
+/*!
+ * \file file_watcher.hpp
+ * \brief Exports the FileWatcher type that invokes a callback whenever
+ *        a file is modified.
+ **/
+#ifndef INCG_ITSP3_FILE_WATCHER_HPP
+#define INCG_ITSP3_FILE_WATCHER_HPP
+#include <atomic>        // std::atomic
+#include <functional>    // std::function
+#include <pl/except.hpp> // PL_DEFINE_EXCEPTION_TYPE, PL_THROW_WITH_SOURCE_INFO
+#include <stdexcept>     // std::runtime_error
+#include <string>        // std::string
+#include <thread>        // std::thread
+
+namespace itsp3 {
+PL_DEFINE_EXCEPTION_TYPE(FileWatcherException, std::runtime_error);
+
+/*!
+ * \brief Watches a file using inotify and invokes a callback on a
+ *        background thread whenever the file is created, written to or
+ *        replaced.
+ * \note Watches the directory containing the file, so the file does not
+ *       have to exist yet.
+ **/
+class FileWatcher {
+public:
+  using this_type = FileWatcher;
+
+  /*!
+   * \brief Starts watching a file.
+   * \param filePath The path of the file to watch.
+   * \param onChange The callback to invoke on the background thread.
+   *                 Several events that arrive at once only result in a
+   *                 single invocation.
+   * \throws FileWatcherException if the watch could not be set up.
+   **/
+  FileWatcher(std::string filePath, std::function<void()> onChange);
+
+  FileWatcher(const this_type&) = delete;
+
+  this_type& operator=(const this_type&) = delete;
+
+  /*!
+   * \brief Stops watching and joins the background thread.
+   **/
+  ~FileWatcher();
+
+private:
+  /*!
+   * \brief Waits for inotify events until stopped.
+   **/
+  void watchLoop();
+
+  std::string           m_fileName; /*!< File name without the directory */
+  std::function<void()> m_onChange;
+  int                   m_inotifyFd;
+  std::atomic<bool>     m_isRunning;
+  std::thread           m_thread;
+};
+} // namespace itsp3
+#endif // INCG_ITSP3_FILE_WATCHER_HPP
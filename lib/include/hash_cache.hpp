@@ -0,0 +1,157 @@
+/*!
+ * \file hash_cache.hpp
+ * \brief Exports the HashCache type, a bounded least recently used cache of
+ *        username to hash lookups.
+ **/
+#ifndef INCG_ITSP3_HASH_CACHE_HPP
+#define INCG_ITSP3_HASH_CACHE_HPP
+#include <cstddef>       // std::size_t
+#include <cstdint>       // std::uint64_t
+#include <list>          // std::list
+#include <memory>        // std::unique_ptr
+#include <mutex>         // std::mutex
+#include <optional>      // std::optional
+#include <string>        // std::string
+#include <string_view>   // std::string_view
+#include <unordered_map> // std::unordered_map
+#include <vector>        // std::vector
+
+namespace itsp3 {
+/*!
+ * \brief Fixed size cache of recently used username to hash entries.
+ * \note Thread safe. The entries are distributed over several shards
+ *       each guarded by its own mutex, so that concurrent lookups of
+ *       different usernames rarely contend on the same mutex.
+ *
+ * Each shard evicts its least recently used entries once the bytes
+ * occupied by its entries would exceed its share of the byte budget.
+ **/
+class HashCache {
+public:
+  using this_type = HashCache;
+
+  static const std::size_t s_defaultByteBudget; /*!< The byte budget used
+                                                 *   if none is given.
+                                                 **/
+  static const std::size_t s_defaultShardCount; /*!< The amount of shards
+                                                 *   used if none is given.
+                                                 **/
+
+  /*!
+   * \brief Creates an empty HashCache.
+   * \param byteBudget The maximum amount of bytes the entries of the cache
+   *                   may occupy. A byte budget of 0 disables the cache.
+   * \param shardCount The amount of shards to distribute the entries over.
+   *                   May not be 0.
+   **/
+  explicit HashCache(
+    std::size_t byteBudget = s_defaultByteBudget,
+    std::size_t shardCount = s_defaultShardCount);
+
+  /*!
+   * \brief Looks up the hash of a username.
+   * \param username The username to look up the hash of.
+   * \return The hash of 'username' if it was cached, otherwise a nullopt.
+   * \note Counts as a hit or as a miss respectively.
+   *       A hit marks the entry as the most recently used one.
+   **/
+  std::optional<std::string> find(std::string_view username);
+
+  /*!
+   * \brief Inserts or updates the hash of a username.
+   * \param username The username to insert.
+   * \param hash The hash associated with 'username'.
+   * \note Entries that are larger than the byte budget of a shard are not
+   *       cached at all.
+   **/
+  void insert(std::string_view username, std::string_view hash);
+
+  /*!
+   * \brief Removes all the entries from the cache.
+   * \note Does not reset the hit and miss counters.
+   **/
+  void clear();
+
+  /*!
+   * \brief Read accessor for the amount of lookups that found an entry.
+   * \return The amount of hits.
+   **/
+  std::uint64_t getHitCount() const;
+
+  /*!
+   * \brief Read accessor for the amount of lookups that found no entry.
+   * \return The amount of misses.
+   **/
+  std::uint64_t getMissCount() const;
+
+  /*!
+   * \brief Read accessor for the amount of entries currently cached.
+   * \return The amount of entries.
+   **/
+  std::size_t getEntryCount() const;
+
+  /*!
+   * \brief Read accessor for the amount of bytes currently accounted for
+   *        by the cached entries.
+   * \return The amount of bytes used.
+   **/
+  std::size_t getByteSize() const;
+
+  /*!
+   * \brief Read accessor for the byte budget.
+   * \return The byte budget.
+   **/
+  std::size_t getByteBudget() const noexcept;
+
+private:
+  /*!
+   * \brief A cached username to hash association.
+   **/
+  struct Entry {
+    std::string username;
+    std::string hash;
+  };
+
+  /*!
+   * \brief An independently locked part of the cache.
+   * \note The front of 'lru' is the most recently used entry.
+   *       The keys of 'index' refer to the usernames stored in 'lru'.
+   **/
+  struct Shard {
+    using Lru   = std::list<Entry>;
+    using Index = std::unordered_map<std::string_view, Lru::iterator>;
+
+    std::mutex    mutex;
+    Lru           lru;
+    Index         index;
+    std::size_t   byteSize{0U};
+    std::uint64_t hits{0U};
+    std::uint64_t misses{0U};
+  };
+
+  /*!
+   * \brief Calculates the amount of bytes an entry is accounted for.
+   * \param username The username of the entry.
+   * \param hash The hash of the entry.
+   * \return The byte cost of the entry including the bookkeeping overhead.
+   **/
+  static std::size_t entryByteSize(
+    std::string_view username,
+    std::string_view hash) noexcept;
+
+  /*!
+   * \brief Selects the shard responsible for a username.
+   * \param username The username to select the shard for.
+   * \return A reference to the shard.
+   **/
+  Shard& shardOf(std::string_view username) const;
+
+  std::size_t                         m_byteBudget;      /*!< Total budget */
+  std::size_t                         m_shardByteBudget; /*!< Per shard */
+  std::vector<std::unique_ptr<Shard>> m_shards; /*!< Shards are held by
+                                                 *   pointer as std::mutex
+                                                 *   is not movable.
+                                                 **/
+};
+} // namespace itsp3
+#endif // INCG_ITSP3_HASH_CACHE_HPP
@@ -0,0 +1,109 @@
+/*!
+ * \file hashing_backend.hpp
+ * \brief Exports the HashingBackend interface used by Bcrypt to generate
+ *        salts as well as to create and check hashes, and its default
+ *        implementation.
+ **/
+#ifndef INCG_ITSP3_HASHING_BACKEND_HPP
+#define INCG_ITSP3_HASHING_BACKEND_HPP
+#include <array>    // std::array
+#include <bcrypt.h> // BCRYPT_HASHSIZE
+
+namespace itsp3 {
+/*!
+ * \brief Buffer type for salts and hashes, large enough for the
+ *        null-terminated crypt strings of the bcrypt library.
+ **/
+using HashBuffer = std::array<char, BCRYPT_HASHSIZE>;
+
+/*!
+ * \brief Interface of the password hashing algorithms used by Bcrypt.
+ * \note Implementations may be injected into Bcrypt, for instance to
+ *       use a lower cost in tests or to count the hashes calculated.
+ *       The non-static member functions may be called from several threads
+ *       at once.
+ **/
+class HashingBackend {
+public:
+  using this_type = HashingBackend;
+
+  /*!
+   * \brief Virtual destructor so that derived types may be destroyed
+   *        through a pointer to HashingBackend.
+   **/
+  virtual ~HashingBackend();
+
+  /*!
+   * \brief Generates a random salt that encodes the cost parameters.
+   * \param salt The buffer to write the null-terminated salt to.
+   * \return true on success, false on failure.
+   **/
+  virtual bool generateSalt(HashBuffer& salt) = 0;
+
+  /*!
+   * \brief Hashes an input using a salt.
+   * \param input The null-terminated input to hash.
+   *              May not be nullptr or otherwise be invalid!
+   * \param salt The null-terminated salt as created by generateSalt.
+   * \param hash The buffer to write the null-terminated hash to.
+   * \return true on success, false on failure.
+   **/
+  virtual bool hash(const char* input, const HashBuffer& salt, HashBuffer& hash)
+    = 0;
+
+  /*!
+   * \brief Checks whether hashing an input results in a given hash.
+   * \param input The null-terminated input to check.
+   *              May not be nullptr or otherwise be invalid!
+   * \param hash The null-terminated hash to check against as created
+   *             by the hash non-static member function.
+   *             May not be nullptr or otherwise be invalid!
+   * \return true if 'input' matches 'hash', otherwise false.
+   *         Also returns false if an error occurred.
+   **/
+  virtual bool check(const char* input, const char* hash) = 0;
+};
+
+/*!
+ * \brief HashingBackend implemented using the bundled bcrypt library.
+ * \see https://github.com/rg3/bcrypt for details.
+ **/
+class BcryptLibraryBackend final : public HashingBackend {
+public:
+  using this_type = BcryptLibraryBackend;
+
+  static const int s_defaultWorkFactor; /*!< The recommended default
+                                         *   work factor.
+                                         **/
+  static const int s_minimumWorkFactor; /*!< The lowest work factor
+                                         *   supported by the bcrypt
+                                         *   library.
+                                         **/
+
+  /*!
+   * \brief Creates a BcryptLibraryBackend.
+   * \param workFactor The base 2 logarithm of the amount of iterations
+   *                   used for the salts generated. Allowable values are
+   *                   4 to 31 (both inclusive), generating salts fails
+   *                   otherwise.
+   **/
+  explicit BcryptLibraryBackend(int workFactor = s_defaultWorkFactor) noexcept;
+
+  bool generateSalt(HashBuffer& salt) override;
+
+  bool hash(const char* input, const HashBuffer& salt, HashBuffer& hash)
+    override;
+
+  bool check(const char* input, const char* hash) override;
+
+  /*!
+   * \brief Read accessor for the work factor.
+   * \return The work factor.
+   **/
+  int getWorkFactor() const noexcept;
+
+private:
+  int m_workFactor;
+};
+} // namespace itsp3
+#endif // INCG_ITSP3_HASHING_BACKEND_HPP
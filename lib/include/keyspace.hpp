@@ -0,0 +1,369 @@
+/*!
+ * \file keyspace.hpp
+ * \brief Exports the Keyspace type that allows random access into the set
+ *        of all the words over an alphabet.
+ **/
+#ifndef INCG_ITSP3_KEYSPACE_HPP
+#define INCG_ITSP3_KEYSPACE_HPP
+#include "keyspace_index.hpp" // itsp3::KeyspaceIndex, itsp3::keyspaceSize
+#include "odometer.hpp"       // itsp3::Odometer
+#include <algorithm>          // std::upper_bound
+#include <array>              // std::array
+#include <ciso646>            // not, or
+#include <climits>            // UCHAR_MAX
+#include <cstddef>            // std::size_t, std::ptrdiff_t
+#include <iterator>           // std::forward_iterator_tag
+#include <limits>             // std::numeric_limits
+#include <pl/assert.hpp>      // PL_DBG_CHECK_PRE
+#include <pl/except.hpp>      // PL_THROW_WITH_SOURCE_INFO, ...
+#include <stdexcept>          // std::invalid_argument
+#include <string>             // std::string, std::to_string
+#include <string_view>        // std::string_view
+#include <vector>             // std::vector
+
+namespace itsp3 {
+PL_DEFINE_EXCEPTION_TYPE(NotInKeyspaceException, std::invalid_argument);
+
+/*!
+ * \brief The set of all the words over an alphabet whose lengths are
+ *        within a given range.
+ * \note The characters of the alphabet must be unique.
+ *
+ * The words are numbered in the order generated by bruteforce, that is
+ * shorter words come first and words of the same length are ordered by
+ * the positions of their characters in the alphabet. The index of a word
+ * is its digits written in base 'AlphabetSize', offset by the amount of
+ * words that are shorter than it.
+ * This allows to jump to any word in O(length) rather than having to
+ * generate all the words that precede it.
+ **/
+template<std::size_t AlphabetSize>
+class Keyspace {
+public:
+  using this_type     = Keyspace;
+  using alphabet_type = std::array<char, AlphabetSize>;
+
+  /*!
+   * \brief Iterates over the words of a Keyspace in order.
+   * \note Advancing costs O(1) amortized, see Odometer.
+   * \warning Refers to the Keyspace it was created from, which must
+   *          outlive it.
+   **/
+  class Iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = std::string;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = const std::string*;
+    using reference         = const std::string&;
+
+    /*!
+     * \brief Creates an Iterator.
+     * \param keyspace The Keyspace to iterate over.
+     * \param index The index of the word to start at,
+     *              keyspace.size() for the end.
+     **/
+    Iterator(const Keyspace& keyspace, KeyspaceIndex index)
+      : m_keyspace{&keyspace}
+      , m_index{index}
+      , m_odometer{keyspace.m_alphabet, keyspace.m_maxLength}
+    {
+      if (m_index != m_keyspace->size()) {
+        const std::size_t wordLength{m_keyspace->lengthOf(m_index)};
+
+        m_odometer.seek(
+          wordLength, m_index - m_keyspace->getLengthOffset(wordLength));
+      }
+    }
+
+    reference operator*() const noexcept { return m_odometer.getWord(); }
+
+    pointer operator->() const noexcept { return &m_odometer.getWord(); }
+
+    Iterator& operator++()
+    {
+      PL_DBG_CHECK_PRE(m_index != m_keyspace->size());
+
+      ++m_index;
+
+      // all the words of the current length have been generated.
+      if (not m_odometer.advance() and m_index != m_keyspace->size()) {
+        m_odometer.reset(m_odometer.getWordLength() + 1U);
+      }
+
+      return *this;
+    }
+
+    Iterator operator++(int)
+    {
+      Iterator result{*this};
+      ++(*this);
+      return result;
+    }
+
+    /*!
+     * \brief Read accessor for the index of the current word.
+     * \return The index.
+     **/
+    KeyspaceIndex getIndex() const noexcept { return m_index; }
+
+    friend bool operator==(const Iterator& lhs, const Iterator& rhs) noexcept
+    {
+      return lhs.m_index == rhs.m_index;
+    }
+
+    friend bool operator!=(const Iterator& lhs, const Iterator& rhs) noexcept
+    {
+      return not(lhs == rhs);
+    }
+
+  private:
+    const Keyspace*        m_keyspace;
+    KeyspaceIndex          m_index;
+    Odometer<AlphabetSize> m_odometer;
+  };
+
+  /*!
+   * \brief A half open range of words of a Keyspace that can be iterated
+   *        over using a range based for loop.
+   **/
+  class Range {
+  public:
+    Range(Iterator first, Iterator last) : m_first{first}, m_last{last} {}
+
+    Iterator begin() const { return m_first; }
+
+    Iterator end() const { return m_last; }
+
+  private:
+    Iterator m_first;
+    Iterator m_last;
+  };
+
+  /*!
+   * \brief Creates a Keyspace of all the words of a single length.
+   * \param alphabet The alphabet to use.
+   * \param wordLength The length of the words.
+   * \throws KeyspaceTooLargeException if the size does not fit into a
+   *         KeyspaceIndex.
+   **/
+  Keyspace(const alphabet_type& alphabet, std::size_t wordLength)
+    : this_type{alphabet, wordLength, wordLength}
+  {
+  }
+
+  /*!
+   * \brief Creates a Keyspace of all the words with lengths within
+   *        [minLength .. maxLength].
+   * \param alphabet The alphabet to use.
+   * \param minLength The minimum length of the words.
+   * \param maxLength The maximum length of the words.
+   *                  May not be less than minLength.
+   * \throws KeyspaceTooLargeException if the size does not fit into a
+   *         KeyspaceIndex.
+   **/
+  Keyspace(
+    const alphabet_type& alphabet,
+    std::size_t          minLength,
+    std::size_t          maxLength)
+    : m_alphabet{alphabet}
+    , m_digitOf{}
+    , m_minLength{minLength}
+    , m_maxLength{maxLength}
+    , m_lengthOffsets{}
+  {
+    PL_DBG_CHECK_PRE(minLength <= maxLength);
+
+    m_digitOf.fill(AlphabetSize);
+
+    for (std::size_t i{0U}; i < AlphabetSize; ++i) {
+      m_digitOf[static_cast<unsigned char>(m_alphabet[i])] = i;
+    }
+
+    // m_lengthOffsets[i] is the index of the first word of length
+    // m_minLength + i, the last element is the size.
+    m_lengthOffsets.reserve(m_maxLength - m_minLength + 2U);
+    m_lengthOffsets.push_back(0U);
+
+    for (std::size_t length{m_minLength}; length <= m_maxLength; ++length) {
+      const KeyspaceIndex wordCount{keyspaceSize(AlphabetSize, length)};
+
+      if (
+        m_lengthOffsets.back()
+        > std::numeric_limits<KeyspaceIndex>::max() - wordCount) {
+        PL_THROW_WITH_SOURCE_INFO(
+          KeyspaceTooLargeException,
+          "The keyspace of words of lengths " + std::to_string(m_minLength)
+            + " to " + std::to_string(m_maxLength) + " is too large");
+      }
+
+      m_lengthOffsets.push_back(m_lengthOffsets.back() + wordCount);
+    }
+  }
+
+  /*!
+   * \brief Calculates the amount of words.
+   * \return The amount of words in this Keyspace.
+   **/
+  KeyspaceIndex size() const noexcept { return m_lengthOffsets.back(); }
+
+  std::size_t getMinLength() const noexcept { return m_minLength; }
+
+  std::size_t getMaxLength() const noexcept { return m_maxLength; }
+
+  const alphabet_type& getAlphabet() const noexcept { return m_alphabet; }
+
+  /*!
+   * \brief Calculates the index of the first word of a given length.
+   * \param wordLength The length, within [minLength .. maxLength + 1].
+   * \return The index, size() if 'wordLength' is maxLength + 1.
+   **/
+  KeyspaceIndex getLengthOffset(std::size_t wordLength) const noexcept
+  {
+    PL_DBG_CHECK_PRE(wordLength >= m_minLength);
+    PL_DBG_CHECK_PRE(wordLength <= m_maxLength + 1U);
+
+    return m_lengthOffsets[wordLength - m_minLength];
+  }
+
+  /*!
+   * \brief Fetches the word at a given index.
+   * \param index The index, must be less than size().
+   * \param word The string to write the word to, its capacity is reused.
+   **/
+  void unrank(KeyspaceIndex index, std::string& word) const
+  {
+    PL_DBG_CHECK_PRE(index < size());
+
+    const std::size_t wordLength{lengthOf(index)};
+
+    index -= getLengthOffset(wordLength);
+    word.resize(wordLength);
+
+    // the last character is the least significant digit.
+    for (std::size_t i{word.size()}; i-- > 0U;) {
+      word[i] = m_alphabet[static_cast<std::size_t>(index % AlphabetSize)];
+      index /= AlphabetSize;
+    }
+  }
+
+  /*!
+   * \brief Fetches the word at a given index.
+   * \param index The index, must be less than size().
+   * \return The word.
+   **/
+  std::string unrank(KeyspaceIndex index) const
+  {
+    std::string word{};
+    unrank(index, word);
+    return word;
+  }
+
+  /*!
+   * \brief Calculates the index of a word.
+   * \param word The word.
+   * \return The index of 'word'.
+   * \throws NotInKeyspaceException if 'word' is not in this Keyspace.
+   **/
+  KeyspaceIndex rank(std::string_view word) const
+  {
+    if (not contains(word)) {
+      PL_THROW_WITH_SOURCE_INFO(
+        NotInKeyspaceException, "The word is not in the keyspace");
+    }
+
+    KeyspaceIndex index{0U};
+
+    for (char character : word) {
+      index = index * AlphabetSize + digitOf(character);
+    }
+
+    return getLengthOffset(word.size()) + index;
+  }
+
+  /*!
+   * \brief Determines whether a word is in this Keyspace.
+   * \param word The word.
+   * \return true if the length of 'word' is within the length range and
+   *         it is made up of characters of the alphabet only.
+   **/
+  bool contains(std::string_view word) const noexcept
+  {
+    if (word.size() < m_minLength or word.size() > m_maxLength) {
+      return false;
+    }
+
+    for (char character : word) {
+      if (digitOf(character) == AlphabetSize) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  Iterator begin() const { return Iterator{*this, 0U}; }
+
+  Iterator end() const { return Iterator{*this, size()}; }
+
+  /*!
+   * \brief Creates an Iterator at a given index.
+   * \param index The index, within [0 .. size()].
+   * \return The Iterator.
+   **/
+  Iterator iteratorAt(KeyspaceIndex index) const
+  {
+    PL_DBG_CHECK_PRE(index <= size());
+
+    return Iterator{*this, index};
+  }
+
+  /*!
+   * \brief Creates a Range of the words at the indices [first .. last).
+   * \param first The index of the first word.
+   * \param last The index one past the last word.
+   *             May not be less than 'first' or greater than size().
+   * \return The Range.
+   **/
+  Range range(KeyspaceIndex first, KeyspaceIndex last) const
+  {
+    PL_DBG_CHECK_PRE(first <= last);
+
+    return Range{iteratorAt(first), iteratorAt(last)};
+  }
+
+private:
+  /*!
+   * \brief Determines the length of the word at a given index.
+   * \param index The index, must be less than size().
+   * \return The length of the word.
+   **/
+  std::size_t lengthOf(KeyspaceIndex index) const noexcept
+  {
+    // the first length whose offset is greater than 'index' follows the
+    // length of the word.
+    const auto it = std::upper_bound(
+      m_lengthOffsets.begin(), m_lengthOffsets.end(), index);
+
+    return m_minLength + static_cast<std::size_t>(it - m_lengthOffsets.begin())
+           - 1U;
+  }
+
+  /*!
+   * \brief Looks up the position of a character in the alphabet.
+   * \param character The character.
+   * \return Its position or AlphabetSize if it is not in the alphabet.
+   **/
+  std::size_t digitOf(char character) const noexcept
+  {
+    return m_digitOf[static_cast<unsigned char>(character)];
+  }
+
+  alphabet_type                           m_alphabet;
+  std::array<std::size_t, UCHAR_MAX + 1U> m_digitOf;
+  std::size_t                             m_minLength;
+  std::size_t                             m_maxLength;
+  std::vector<KeyspaceIndex>              m_lengthOffsets;
+};
+} // namespace itsp3
+#endif // INCG_ITSP3_KEYSPACE_HPP
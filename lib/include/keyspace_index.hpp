@@ -0,0 +1,54 @@
+/*!
+ * \file keyspace_index.hpp
+ * \brief Exports the type used to index into keyspaces.
+ **/
+#ifndef INCG_ITSP3_KEYSPACE_INDEX_HPP
+#define INCG_ITSP3_KEYSPACE_INDEX_HPP
+#include <ciso646>       // and
+#include <cstddef>       // std::size_t
+#include <limits>        // std::numeric_limits
+#include <pl/except.hpp> // PL_DEFINE_EXCEPTION_TYPE, PL_THROW_WITH_SOURCE_INFO
+#include <stdexcept>     // std::overflow_error
+#include <string>        // std::to_string
+
+namespace itsp3 {
+PL_DEFINE_EXCEPTION_TYPE(KeyspaceTooLargeException, std::overflow_error);
+
+/*!
+ * \brief Unsigned 128 bit integer type used to index into keyspaces.
+ * \note Uses a GCC extension, which is fine as only GCC on x64 is
+ *       supported.
+ **/
+__extension__ typedef unsigned __int128 KeyspaceIndex;
+
+/*!
+ * \brief Calculates the amount of words of a given length over an alphabet.
+ * \param alphabetSize The size of the alphabet.
+ * \param wordLength The length of the words.
+ * \return alphabetSize to the power of wordLength.
+ * \throws KeyspaceTooLargeException if the result does not fit into a
+ *         KeyspaceIndex.
+ **/
+inline KeyspaceIndex keyspaceSize(
+  std::size_t alphabetSize,
+  std::size_t wordLength)
+{
+  KeyspaceIndex size{1U};
+
+  for (std::size_t i{0U}; i < wordLength; ++i) {
+    if (
+      alphabetSize != 0U
+      and size > std::numeric_limits<KeyspaceIndex>::max() / alphabetSize) {
+      PL_THROW_WITH_SOURCE_INFO(
+        KeyspaceTooLargeException,
+        "The keyspace of words of length " + std::to_string(wordLength)
+          + " is too large");
+    }
+
+    size *= alphabetSize;
+  }
+
+  return size;
+}
+} // namespace itsp3
+#endif // INCG_ITSP3_KEYSPACE_INDEX_HPP
@@ -0,0 +1,60 @@
+/*!
+ * \file mapped_file.hpp
+ * \brief Exports the MappedFile type that maps a file into memory.
+ **/
+#ifndef INCG_ITSP3_MAPPED_FILE_HPP
+#define INCG_ITSP3_MAPPED_FILE_HPP
+#include <cstddef>       // std::size_t
+#include <pl/except.hpp> // PL_DEFINE_EXCEPTION_TYPE
+#include <stdexcept>     // std::runtime_error
+#include <string>        // std::string
+#include <string_view>   // std::string_view
+
+namespace itsp3 {
+PL_DEFINE_EXCEPTION_TYPE(MappedFileException, std::runtime_error);
+
+/*!
+ * \brief Maps a file read only into memory for as long as it lives.
+ *
+ * The contents are paged in by the operating system as they are accessed,
+ * so files much larger than the main memory can be read without copying
+ * them.
+ **/
+class MappedFile {
+public:
+  using this_type = MappedFile;
+
+  /*!
+   * \brief Maps a file.
+   * \param filePath The path of the file to map.
+   * \throws MappedFileException if the file could not be opened or mapped.
+   **/
+  explicit MappedFile(const std::string& filePath);
+
+  MappedFile(const this_type&) = delete;
+
+  this_type& operator=(const this_type&) = delete;
+
+  /*!
+   * \brief Unmaps the file.
+   **/
+  ~MappedFile();
+
+  /*!
+   * \brief Read accessor for the contents of the file.
+   * \return A view of the contents, valid as long as this object lives.
+   **/
+  std::string_view getContents() const noexcept;
+
+  /*!
+   * \brief Read accessor for the size of the file.
+   * \return The size in bytes.
+   **/
+  std::size_t getSize() const noexcept;
+
+private:
+  const char* m_data; /*!< nullptr if the file is empty */
+  std::size_t m_size;
+};
+} // namespace itsp3
+#endif // INCG_ITSP3_MAPPED_FILE_HPP
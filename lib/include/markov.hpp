@@ -0,0 +1,274 @@
+/*!
+ * \file markov.hpp
+ * \brief Exports a first order Markov model of passwords and a bruteforce
+ *        algorithm that tries the more likely words first.
+ **/
+#ifndef INCG_ITSP3_MARKOV_HPP
+#define INCG_ITSP3_MARKOV_HPP
+#include "bruteforce.hpp"     // itsp3::KeyspaceExhaustedException
+#include "keyspace_index.hpp" // itsp3::KeyspaceIndex
+#include <array>              // std::array
+#include <cstddef>            // std::size_t
+#include <cstdint>            // std::uint64_t
+#include <pl/except.hpp>      // PL_DEFINE_EXCEPTION_TYPE
+#include <stdexcept>          // std::runtime_error
+#include <string>             // std::string
+#include <string_view>        // std::string_view
+#include <vector>             // std::vector
+
+namespace itsp3 {
+PL_DEFINE_EXCEPTION_TYPE(MarkovModelException, std::runtime_error);
+
+/*!
+ * \brief First order Markov model over an alphabet.
+ *
+ * Holds for the beginning of a word and for each character of the
+ * alphabet the characters of the alphabet ordered by how often they
+ * followed it in the corpus trained from, the most frequent first.
+ * Only the order is kept, not the frequencies, so the table has
+ * (n + 1) * n bytes for an alphabet of n characters.
+ **/
+class MarkovModel {
+public:
+  using this_type = MarkovModel;
+
+  /*!
+   * \brief The state of the beginning of a word.
+   **/
+  static constexpr std::size_t s_startState{0U};
+
+  /*!
+   * \brief Trains a MarkovModel from a corpus.
+   * \param alphabet The characters of the alphabet, without duplicates.
+   * \param corpus Newline separated passwords. Characters not in the
+   *               alphabet are not counted and restart the context as if
+   *               a new word began.
+   * \return The MarkovModel trained.
+   * \throws MarkovModelException if 'alphabet' is empty or contains
+   *         duplicates.
+   * \note Characters that never followed a context keep the order of the
+   *       alphabet behind the ones that did.
+   **/
+  static MarkovModel train(std::string_view alphabet, std::string_view corpus);
+
+  /*!
+   * \brief Trains a MarkovModel from a corpus.
+   * \param alphabet The alphabet.
+   * \param corpus Newline separated passwords.
+   * \return The MarkovModel trained.
+   * \see train
+   **/
+  template<std::size_t AlphabetSize>
+  static MarkovModel train(
+    const std::array<char, AlphabetSize>& alphabet,
+    std::string_view                      corpus)
+  {
+    return train(std::string_view{alphabet.data(), alphabet.size()}, corpus);
+  }
+
+  /*!
+   * \brief Loads a MarkovModel from a file.
+   * \param filePath The path to the file to load from.
+   * \return The MarkovModel loaded.
+   * \throws MarkovModelException if the file could not be read or is not
+   *         a valid model file.
+   **/
+  static MarkovModel load(const std::string& filePath);
+
+  /*!
+   * \brief Saves this MarkovModel to a file.
+   * \param filePath The path to the file to save to.
+   * \throws MarkovModelException on failure.
+   **/
+  void save(const std::string& filePath) const;
+
+  /*!
+   * \brief Read accessor for the alphabet.
+   * \return The characters of the alphabet.
+   **/
+  const std::string& getAlphabet() const noexcept;
+
+  /*!
+   * \brief Fetches the state a character leads to.
+   * \param c The character, must be in the alphabet.
+   * \return The state that follows 'c'.
+   **/
+  std::size_t stateAfter(char c) const noexcept
+  {
+    return m_states[static_cast<unsigned char>(c)];
+  }
+
+  /*!
+   * \brief Fetches the characters that may follow a state.
+   * \param state The state.
+   * \return The alphabet ordered by how likely its characters follow
+   *         'state', the most likely one first.
+   **/
+  const char* successors(std::size_t state) const noexcept
+  {
+    return m_successors.data() + state * m_alphabet.size();
+  }
+
+private:
+  /*!
+   * \brief Creates a MarkovModel.
+   * \param alphabet The alphabet, must not contain duplicates.
+   * \param successors The successor table.
+   **/
+  MarkovModel(std::string alphabet, std::string successors);
+
+  std::string m_alphabet;
+  std::string m_successors; /*!< The successors of each state, one row of
+                             *   m_alphabet.size() characters per state.
+                             **/
+  std::array<std::size_t, 0x100> m_states; /*!< The state after each
+                                            *   character.
+                                            **/
+};
+
+/*!
+ * \brief Generates the words of a given length in the order of a
+ *        MarkovModel, one after another.
+ *
+ * Works like the Odometer, except that the digits are ranks among the
+ * successors of the previous character rather than positions in the
+ * alphabet. As the successors of every state are a permutation of the
+ * alphabet all the words of the length are generated exactly once, words
+ * made up of likely transitions first. When a digit changes the
+ * characters to its right are recomputed, as their predecessors changed,
+ * which happens for every n-th word only, so advancing still costs O(1)
+ * amortized.
+ * \warning The MarkovModel must outlive this object.
+ **/
+class MarkovOdometer {
+public:
+  using this_type = MarkovOdometer;
+
+  /*!
+   * \brief Creates a MarkovOdometer whose word is the empty word.
+   * \param model The model to use.
+   * \param maxLength The maximum word length that will be used.
+   **/
+  MarkovOdometer(const MarkovModel& model, std::size_t maxLength);
+
+  /*!
+   * \brief Sets the word to the most likely word of a given length.
+   * \param wordLength The word length, may not exceed the maxLength.
+   **/
+  void reset(std::size_t wordLength);
+
+  /*!
+   * \brief Sets the word to the word at a given index among the words of
+   *        a given length, in the order of the model.
+   * \param wordLength The word length, may not exceed the maxLength.
+   * \param index The index, must be less than the amount of words of
+   *              length 'wordLength'.
+   **/
+  void seek(std::size_t wordLength, KeyspaceIndex index);
+
+  /*!
+   * \brief Advances to the next word of the current length.
+   * \return false if the current word was the last one of its length,
+   *         in that case the word wraps around to the first word of its
+   *         length. Otherwise true.
+   **/
+  bool advance() noexcept
+  {
+    for (std::size_t i{m_digits.size()}; i-- > 0U;) {
+      if (++(m_digits[i]) != m_alphabetSize) {
+        m_word[i] = m_rows[i][m_digits[i]];
+        recompute(i + 1U);
+        return true;
+      }
+
+      m_digits[i] = 0U;
+    }
+
+    recompute(0U);
+    return false;
+  }
+
+  /*!
+   * \brief Read accessor for the current word.
+   * \return The current word.
+   **/
+  const std::string& getWord() const noexcept { return m_word; }
+
+  /*!
+   * \brief Read accessor for the length of the current word.
+   * \return The word length.
+   **/
+  std::size_t getWordLength() const noexcept { return m_word.size(); }
+
+private:
+  /*!
+   * \brief Recomputes the rows and characters from a position on.
+   * \param first The first position to recompute.
+   **/
+  void recompute(std::size_t first) noexcept
+  {
+    for (std::size_t i{first}; i < m_word.size(); ++i) {
+      m_rows[i] = m_model->successors(
+        i == 0U ? MarkovModel::s_startState
+                : m_model->stateAfter(m_word[i - 1U]));
+      m_word[i] = m_rows[i][m_digits[i]];
+    }
+  }
+
+  const MarkovModel*       m_model;
+  std::size_t              m_alphabetSize;
+  std::size_t              m_maxLength;
+  std::string              m_word;
+  std::vector<std::size_t> m_digits; /*!< The ranks of the characters. */
+  std::vector<const char*> m_rows;   /*!< The successors used for each
+                                      *   position.
+                                      **/
+};
+
+/*!
+ * \brief Bruteforce algorithm that tries the words of each length in the
+ *        order of a MarkovModel.
+ * \param doesMatch Callable to determine if the current string matches.
+ * \param model The model whose alphabet and order to use.
+ * \param minLength The length of the shortest words to try.
+ * \param maxLength The length of the longest words to try.
+ * \return The match found.
+ * \throws KeyspaceExhaustedException if none of the words of the lengths
+ *         [minLength .. maxLength] matched.
+ * \note Tries the same words as bruteforce with the alphabet of the model,
+ *       just in a different order within each length.
+ **/
+template<typename Callable>
+std::string markovBruteforce(
+  const Callable&    doesMatch,
+  const MarkovModel& model,
+  std::size_t        minLength,
+  std::size_t        maxLength)
+{
+  const KeyspaceExhaustedException::clock::time_point start{
+    KeyspaceExhaustedException::clock::now()};
+  std::uint64_t candidateCount{0U};
+
+  MarkovOdometer odometer{model, maxLength};
+
+  for (std::size_t curWordLen{minLength}; curWordLen <= maxLength;
+       ++curWordLen) {
+    odometer.reset(curWordLen);
+
+    do {
+      ++candidateCount;
+
+      if (doesMatch(odometer.getWord())) {
+        return odometer.getWord();
+      }
+    } while (odometer.advance());
+  }
+
+  throw KeyspaceExhaustedException{
+    minLength,
+    maxLength,
+    candidateCount,
+    KeyspaceExhaustedException::clock::now() - start};
+}
+} // namespace itsp3
+#endif // INCG_ITSP3_MARKOV_HPP
@@ -0,0 +1,291 @@
+/*!
+ * \file mask.hpp
+ * \brief Exports the mask attack, which only tries the words that match a
+ *        pattern of per position alphabets.
+ **/
+#ifndef INCG_ITSP3_MASK_HPP
+#define INCG_ITSP3_MASK_HPP
+#include "bruteforce.hpp"     // itsp3::KeyspaceExhaustedException
+#include "keyspace_index.hpp" // itsp3::KeyspaceIndex
+#include "odometer.hpp"       // itsp3::BasicOdometer
+#include <array>              // std::array
+#include <ciso646>            // and
+#include <cstddef>            // std::size_t
+#include <cstdint>            // std::uint64_t
+#include <pl/except.hpp>      // PL_DEFINE_EXCEPTION_TYPE
+#include <stdexcept>          // std::invalid_argument
+#include <string>             // std::string
+#include <string_view>        // std::string_view
+#include <tuple>              // std::tuple, std::apply
+#include <utility>            // std::move
+#include <vector>             // std::vector
+
+namespace itsp3 {
+PL_DEFINE_EXCEPTION_TYPE(InvalidMaskException, std::invalid_argument);
+
+/*!
+ * \brief A pattern of per position alphabets, e.g. an upper case character
+ *        followed by 6 lower case characters and 2 digits.
+ *
+ * The words of a Mask are the words of the length of the Mask whose
+ * characters are all taken from the alphabet of their position.
+ **/
+class Mask {
+public:
+  using this_type = Mask;
+
+  /*!
+   * \brief Parses a Mask from the hashcat mask syntax.
+   * \param mask The mask to parse, e.g. "?u?l?l?l?l?l?l?d?d?s".
+   * \return The Mask parsed.
+   * \throws InvalidMaskException if 'mask' is not a valid mask.
+   *
+   * The placeholders are:
+   * ?l the lower case characters.
+   * ?u the upper case characters.
+   * ?d the digits.
+   * ?s the special characters.
+   * ?a all of the above.
+   * ?? a literal '?'.
+   * Every other character stands for itself.
+   **/
+  static Mask parse(std::string_view mask);
+
+  /*!
+   * \brief Creates a Mask from a tuple of alphabets.
+   * \param alphabets The alphabets of the positions, in order,
+   *                  e.g. created by makeAlphabet.
+   * \return The Mask created.
+   **/
+  template<std::size_t... AlphabetSizes>
+  static Mask fromAlphabets(
+    const std::tuple<std::array<char, AlphabetSizes>...>& alphabets)
+  {
+    return std::apply(
+      [](const auto&... alphabet) {
+        return Mask{std::vector<std::string>{
+          std::string{alphabet.begin(), alphabet.end()}...}};
+      },
+      alphabets);
+  }
+
+  /*!
+   * \brief Creates a Mask.
+   * \param alphabets The alphabets of the positions, in order.
+   * \throws InvalidMaskException if one of the alphabets is empty.
+   **/
+  explicit Mask(std::vector<std::string> alphabets);
+
+  /*!
+   * \brief Read accessor for the length of the words of this Mask.
+   * \return The amount of positions.
+   **/
+  std::size_t getLength() const noexcept;
+
+  /*!
+   * \brief Read accessor for the alphabet of a position.
+   * \param position The position, must be less than getLength().
+   * \return The alphabet of 'position'.
+   **/
+  const std::string& getAlphabet(std::size_t position) const noexcept;
+
+  /*!
+   * \brief Calculates the amount of words of this Mask.
+   * \return The product of the sizes of the alphabets.
+   * \throws KeyspaceTooLargeException if the result does not fit into a
+   *         KeyspaceIndex.
+   **/
+  KeyspaceIndex size() const;
+
+  /*!
+   * \brief Creates the Mask of the first positions of this Mask.
+   * \param length The amount of positions to keep.
+   * \return The Mask of the first 'length' alphabets, a copy of this Mask
+   *         if 'length' is not less than getLength().
+   **/
+  Mask prefix(std::size_t length) const;
+
+  /*!
+   * \brief Checks whether a word is one of the words of this Mask.
+   * \param word The word to check.
+   * \return true if 'word' matches this Mask, otherwise false.
+   **/
+  bool matches(std::string_view word) const noexcept;
+
+private:
+  std::vector<std::string> m_alphabets;
+};
+
+/*!
+ * \brief Alphabets type for BasicOdometer that uses the alphabets of a
+ *        Mask.
+ * \warning The Mask must outlive this object.
+ **/
+class MaskAlphabets {
+public:
+  using this_type = MaskAlphabets;
+
+  /*!
+   * \brief Creates a MaskAlphabets object.
+   * \param mask The Mask to use the alphabets of.
+   **/
+  explicit MaskAlphabets(const Mask& mask) noexcept : m_mask{&mask} {}
+
+  /*!
+   * \brief Fetches the size of the alphabet at a position.
+   * \param position The position.
+   * \return The size of the alphabet.
+   **/
+  std::size_t sizeAt(std::size_t position) const noexcept
+  {
+    return m_mask->getAlphabet(position).size();
+  }
+
+  /*!
+   * \brief Fetches a character of the alphabet at a position.
+   * \param position The position.
+   * \param digit The position of the character in the alphabet.
+   * \return The character.
+   **/
+  char at(std::size_t position, std::size_t digit) const noexcept
+  {
+    return m_mask->getAlphabet(position)[digit];
+  }
+
+private:
+  const Mask* m_mask;
+};
+
+/*!
+ * \brief Alphabets type for BasicOdometer that uses a tuple of alphabets,
+ *        whose sizes are known at compile time.
+ * \warning The alphabets must outlive this object.
+ **/
+template<std::size_t... AlphabetSizes>
+class FixedMaskAlphabets {
+public:
+  using this_type = FixedMaskAlphabets;
+
+  static_assert(
+    ((AlphabetSizes != 0U) and ...),
+    "The alphabets of a mask may not be empty!");
+
+  /*!
+   * \brief Creates a FixedMaskAlphabets object.
+   * \param alphabets The alphabets of the positions, in order.
+   **/
+  explicit FixedMaskAlphabets(
+    const std::tuple<std::array<char, AlphabetSizes>...>& alphabets) noexcept
+    : m_alphabets{std::apply(
+      [](const auto&... alphabet) {
+        return std::array<const char*, sizeof...(AlphabetSizes)>{
+          {alphabet.data()...}};
+      },
+      alphabets)}
+  {
+  }
+
+  /*!
+   * \brief Fetches the size of the alphabet at a position.
+   * \param position The position.
+   * \return The size of the alphabet.
+   **/
+  constexpr std::size_t sizeAt(std::size_t position) const noexcept
+  {
+    return s_sizes[position];
+  }
+
+  /*!
+   * \brief Fetches a character of the alphabet at a position.
+   * \param position The position.
+   * \param digit The position of the character in the alphabet.
+   * \return The character.
+   **/
+  char at(std::size_t position, std::size_t digit) const noexcept
+  {
+    return m_alphabets[position][digit];
+  }
+
+private:
+  static constexpr std::array<std::size_t, sizeof...(AlphabetSizes)>
+    s_sizes{{AlphabetSizes...}};
+
+  std::array<const char*, sizeof...(AlphabetSizes)> m_alphabets;
+};
+
+namespace detail {
+/*!
+ * \brief Implementation function of maskAttack.
+ * \note Not to be used directly.
+ **/
+template<typename Alphabets, typename Callable>
+std::string maskAttackImpl(
+  const Callable& doesMatch,
+  Alphabets       alphabets,
+  std::size_t     length)
+{
+  const KeyspaceExhaustedException::clock::time_point start{
+    KeyspaceExhaustedException::clock::now()};
+  std::uint64_t candidateCount{0U};
+
+  BasicOdometer<Alphabets> odometer{std::move(alphabets), length};
+  odometer.reset(length);
+
+  do {
+    ++candidateCount;
+
+    if (doesMatch(odometer.getWord())) {
+      return odometer.getWord();
+    }
+  } while (odometer.advance());
+
+  throw KeyspaceExhaustedException{
+    length,
+    length,
+    candidateCount,
+    KeyspaceExhaustedException::clock::now() - start};
+}
+} // namespace detail
+
+/*!
+ * \brief Mask attack algorithm.
+ * \param doesMatch Callable to determine if the current string matches,
+ *                  the same as for bruteforce.
+ * \param mask The mask whose words to try.
+ * \return The first word of 'mask' that matched.
+ * \throws KeyspaceExhaustedException if none of the words of 'mask'
+ *         matched.
+ *
+ * Generates the words of 'mask' in the order of bruteforce, the last
+ * position changing the fastest.
+ **/
+template<typename Callable>
+std::string maskAttack(const Callable& doesMatch, const Mask& mask)
+{
+  return detail::maskAttackImpl(
+    doesMatch, MaskAlphabets{mask}, mask.getLength());
+}
+
+/*!
+ * \brief Mask attack algorithm for masks known at compile time.
+ * \param doesMatch Callable to determine if the current string matches,
+ *                  the same as for bruteforce.
+ * \param alphabets The alphabets of the positions, in order,
+ *                  e.g. created by makeAlphabet.
+ * \return The first word that matched.
+ * \throws KeyspaceExhaustedException if none of the words matched.
+ * \note The sizes of the alphabets are compile time constants, which saves
+ *       loading them when advancing.
+ **/
+template<typename Callable, std::size_t... AlphabetSizes>
+std::string maskAttack(
+  const Callable&                                       doesMatch,
+  const std::tuple<std::array<char, AlphabetSizes>...>& alphabets)
+{
+  return detail::maskAttackImpl(
+    doesMatch,
+    FixedMaskAlphabets<AlphabetSizes...>{alphabets},
+    sizeof...(AlphabetSizes));
+}
+} // namespace itsp3
+#endif // INCG_ITSP3_MASK_HPP
@@ -0,0 +1,186 @@
+/*!
+ * \file odometer.hpp
+ * \brief Exports the Odometer types that generate the words of a given
+ *        length over alphabets in place.
+ **/
+#ifndef INCG_ITSP3_ODOMETER_HPP
+#define INCG_ITSP3_ODOMETER_HPP
+#include "keyspace_index.hpp" // itsp3::KeyspaceIndex
+#include <array>              // std::array
+#include <cstddef>            // std::size_t
+#include <pl/assert.hpp>      // PL_DBG_CHECK_PRE
+#include <string>             // std::string
+#include <utility>            // std::move
+#include <vector>             // std::vector
+
+namespace itsp3 {
+/*!
+ * \brief Alphabets type for BasicOdometer that uses the same alphabet at
+ *        every position.
+ **/
+template<std::size_t AlphabetSize>
+class UniformAlphabets {
+public:
+  using this_type     = UniformAlphabets;
+  using alphabet_type = std::array<char, AlphabetSize>;
+
+  /*!
+   * \brief Creates a UniformAlphabets object.
+   * \param alphabet The alphabet to use at every position.
+   **/
+  UniformAlphabets(const alphabet_type& alphabet) : m_alphabet{alphabet} {}
+
+  /*!
+   * \brief Fetches the size of the alphabet at a position.
+   * \return AlphabetSize.
+   **/
+  constexpr std::size_t sizeAt(std::size_t) const noexcept
+  {
+    return AlphabetSize;
+  }
+
+  /*!
+   * \brief Fetches a character of the alphabet at a position.
+   * \param digit The position of the character in the alphabet.
+   * \return The character.
+   **/
+  char at(std::size_t, std::size_t digit) const noexcept
+  {
+    return m_alphabet[digit];
+  }
+
+private:
+  alphabet_type m_alphabet;
+};
+
+/*!
+ * \brief Generates the words of a given length over per position
+ *        alphabets in the order of bruteforce, one after another.
+ * \tparam Alphabets Type that provides the alphabet of every position
+ *                   through the member functions sizeAt(position) and
+ *                   at(position, digit), see UniformAlphabets.
+ *
+ * Works like the odometer of a car: advancing increments the last digit,
+ * a digit that runs past the end of its alphabet wraps around and carries
+ * over to the digit to its left. Only the characters of the digits that
+ * changed are written, which is a single one for all but every n-th word,
+ * n being the size of the last alphabet, so advancing costs O(1)
+ * amortized.
+ * The buffers for the word and the digits are allocated once, when the
+ * BasicOdometer is created, no matter how often the word length changes.
+ **/
+template<typename Alphabets>
+class BasicOdometer {
+public:
+  using this_type = BasicOdometer;
+
+  /*!
+   * \brief Creates a BasicOdometer whose word is the empty word.
+   * \param alphabets The alphabets to use.
+   * \param maxLength The maximum word length that will be used.
+   **/
+  BasicOdometer(Alphabets alphabets, std::size_t maxLength)
+    : m_alphabets{std::move(alphabets)}
+    , m_maxLength{maxLength}
+    , m_word{}
+    , m_digits{}
+  {
+    m_word.reserve(m_maxLength);
+    m_digits.reserve(m_maxLength);
+  }
+
+  /*!
+   * \brief Sets the word to the first word of a given length.
+   * \param wordLength The word length, may not exceed the maxLength.
+   * \warning None of the first 'wordLength' alphabets may be empty.
+   **/
+  void reset(std::size_t wordLength)
+  {
+    PL_DBG_CHECK_PRE(wordLength <= m_maxLength);
+
+    // stays within the capacity reserved -> never allocates.
+    m_word.resize(wordLength);
+    m_digits.assign(wordLength, 0U);
+
+    for (std::size_t i{0U}; i < wordLength; ++i) {
+      m_word[i] = m_alphabets.at(i, 0U);
+    }
+  }
+
+  /*!
+   * \brief Sets the word to the word at a given index among the words of
+   *        a given length.
+   * \param wordLength The word length, may not exceed the maxLength.
+   * \param index The index, must be less than the amount of words of
+   *              length 'wordLength'.
+   **/
+  void seek(std::size_t wordLength, KeyspaceIndex index)
+  {
+    reset(wordLength);
+
+    // the last character is the least significant digit.
+    for (std::size_t i{wordLength}; i-- > 0U;) {
+      const std::size_t radix{m_alphabets.sizeAt(i)};
+
+      m_digits[i] = static_cast<std::size_t>(index % radix);
+      m_word[i]   = m_alphabets.at(i, m_digits[i]);
+      index /= radix;
+    }
+  }
+
+  /*!
+   * \brief Advances to the next word of the current length.
+   * \return false if the current word was the last one of its length,
+   *         in that case the word wraps around to the first word of its
+   *         length. Otherwise true.
+   **/
+  bool advance() noexcept
+  {
+    for (std::size_t i{m_digits.size()}; i-- > 0U;) {
+      if (++(m_digits[i]) != m_alphabets.sizeAt(i)) {
+        m_word[i] = m_alphabets.at(i, m_digits[i]);
+        return true;
+      }
+
+      // carry over to the digit to the left.
+      m_digits[i] = 0U;
+      m_word[i]   = m_alphabets.at(i, 0U);
+    }
+
+    return false;
+  }
+
+  /*!
+   * \brief Read accessor for the current word.
+   * \return The current word.
+   **/
+  const std::string& getWord() const noexcept { return m_word; }
+
+  /*!
+   * \brief Read accessor for the length of the current word.
+   * \return The word length.
+   **/
+  std::size_t getWordLength() const noexcept { return m_word.size(); }
+
+  /*!
+   * \brief Read accessor for the maximum word length.
+   * \return The maximum word length.
+   **/
+  std::size_t getMaxLength() const noexcept { return m_maxLength; }
+
+private:
+  Alphabets                m_alphabets;
+  std::size_t              m_maxLength;
+  std::string              m_word;
+  std::vector<std::size_t> m_digits; /*!< Positions in the alphabets of
+                                      *   the characters of m_word.
+                                      **/
+};
+
+/*!
+ * \brief Odometer that uses the same alphabet at every position.
+ **/
+template<std::size_t AlphabetSize>
+using Odometer = BasicOdometer<UniformAlphabets<AlphabetSize>>;
+} // namespace itsp3
+#endif // INCG_ITSP3_ODOMETER_HPP
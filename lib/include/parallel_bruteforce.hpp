@@ -0,0 +1,414 @@
+/*!
+ * \file parallel_bruteforce.hpp
+ * \brief Exports a multi-threaded variant of the bruteforce algorithm.
+ **/
+#ifndef INCG_ITSP3_PARALLEL_BRUTEFORCE_HPP
+#define INCG_ITSP3_PARALLEL_BRUTEFORCE_HPP
+#include "bruteforce.hpp"      // itsp3::KeyspaceExhaustedException
+#include "candidate_batch.hpp" // itsp3::CandidateBatch, ...
+#include "checkpoint.hpp"      // itsp3::Checkpointer, ...
+#include "keyspace.hpp"        // itsp3::Keyspace, itsp3::KeyspaceIndex
+#include "progress.hpp"        // itsp3::ProgressCounters
+#include "work_stealing.hpp"   // itsp3::WorkStealingScheduler, ...
+#include <algorithm>           // std::min, std::max
+#include <array>               // std::array
+#include <atomic>              // std::atomic
+#include <ciso646>             // not, or
+#include <cstddef>             // std::size_t
+#include <cstdint>             // std::uint64_t
+#include <exception>           // std::exception_ptr, std::current_exception
+#include <mutex>               // std::mutex, std::lock_guard
+#include <optional>            // std::optional
+#include <pl/assert.hpp>       // PL_DBG_CHECK_PRE
+#include <pl/except.hpp>       // PL_THROW_WITH_SOURCE_INFO
+#include <string>              // std::string
+#include <string_view>         // std::string_view
+#include <thread>              // std::thread
+#include <utility>             // std::move
+#include <vector>              // std::vector
+
+namespace itsp3 {
+/*!
+ * \brief The options of parallelBruteforce.
+ **/
+struct ParallelBruteforceOptions {
+  /*!
+   * \brief The length of the shortest words to try.
+   **/
+  std::size_t minLength{0U};
+
+  /*!
+   * \brief The length of the longest words to try, the size of the
+   *        alphabet if nullopt.
+   **/
+  std::optional<std::size_t> maxLength{};
+
+  /*!
+   * \brief The amount of worker threads to use, 0 is treated as 1.
+   **/
+  std::size_t threadCount{std::thread::hardware_concurrency()};
+
+  /*!
+   * \brief The Checkpointer to record the progress with, nullptr not to
+   *        record the progress. If given, the search continues from its
+   *        checkpoint.
+   **/
+  Checkpointer* checkpointer{nullptr};
+
+  /*!
+   * \brief The ProgressCounters to publish the progress to, nullptr not to
+   *        publish the progress. Must have at least 'threadCount' workers.
+   **/
+  ProgressCounters* progress{nullptr};
+
+  /*!
+   * \brief The amount of words a worker checks before it looks for matches
+   *        found by the others, 0 is treated as 1. parallelBatchBruteforce
+   *        passes batches of up to this many words to its verifier, so
+   *        that they can be hashed at once, for instance the laneCount of
+   *        the bcrypt kernel.
+   **/
+  std::size_t batchSize{64U};
+};
+
+namespace detail {
+/*!
+ * \brief Implementation function of parallelBruteforce and
+ *        parallelBatchBruteforce.
+ * \param makeSearch Callable that takes a word length and returns the
+ *                   callable a worker searches the words of that length
+ *                   with. That callable takes a KeyspaceRangeSource&,
+ *                   checks some of its next words and returns the index
+ *                   of the first one that matched or nullopt.
+ * \param alphabet The alphabet to use.
+ * \param options The options.
+ * \param chunkGranularity The chunks the workers request are multiples of
+ *                         this, so that the search callable is never
+ *                         limited to fewer words by the chunk it searches.
+ * \return The first match.
+ * \note Not to be used directly.
+ **/
+template<std::size_t AlphabetSize, typename MakeSearch>
+std::string parallelBruteforceImpl(
+  const MakeSearch&                     makeSearch,
+  const std::array<char, AlphabetSize>& alphabet,
+  const ParallelBruteforceOptions&      options,
+  std::size_t                           chunkGranularity)
+{
+  const KeyspaceExhaustedException::clock::time_point start{
+    KeyspaceExhaustedException::clock::now()};
+  std::atomic<std::uint64_t> candidateCount{0U};
+
+  const std::size_t minLength{options.minLength};
+  const std::size_t maxLength{options.maxLength.value_or(AlphabetSize)};
+  const std::size_t threadCount{std::max<std::size_t>(options.threadCount, 1U)};
+  Checkpointer* const checkpointer{options.checkpointer};
+  ProgressCounters* const progress{options.progress};
+
+  PL_DBG_CHECK_PRE(
+    progress == nullptr or progress->getWorkerCount() >= threadCount);
+
+  std::size_t firstWordLen{minLength};
+
+  if (checkpointer != nullptr) {
+    const Checkpoint checkpoint{checkpointer->getCheckpoint()};
+
+    if (
+      checkpoint.getAlphabet()
+      != std::string_view{alphabet.data(), alphabet.size()}) {
+      PL_THROW_WITH_SOURCE_INFO(
+        CheckpointException, "The checkpoint uses a different alphabet");
+    }
+
+    firstWordLen = std::max(firstWordLen, checkpoint.getWordLength());
+  }
+
+  for (std::size_t curWordLen{firstWordLen}; curWordLen <= maxLength;
+       ++curWordLen) {
+    const Keyspace<AlphabetSize> keyspace{alphabet, curWordLen};
+    const KeyspaceIndex          wordCount{keyspace.size()};
+
+    std::vector<KeyspaceRange> ranges{KeyspaceRange{0U, wordCount}};
+
+    if (checkpointer != nullptr) {
+      checkpointer->beginWordLength(curWordLen);
+      ranges = checkpointer->getCheckpoint().getRemainingRanges(wordCount);
+    }
+
+    KeyspaceIndex remainingCount{0U};
+
+    for (const KeyspaceRange& range : ranges) {
+      remainingCount += range.end - range.begin;
+    }
+
+    if (progress != nullptr) {
+      progress->beginWordLength(
+        curWordLen, wordCount, wordCount - remainingCount);
+    }
+
+    // may have been searched completely before resuming.
+    if (remainingCount == 0U) {
+      continue;
+    }
+
+    const std::size_t workerCount{static_cast<std::size_t>(
+      std::min<KeyspaceIndex>(threadCount, remainingCount))};
+
+    WorkStealingScheduler scheduler{ranges, workerCount};
+
+    // the best match is rarely written, so a mutex is fine.
+    // 'bestMatchVersion' lets workers notice a new best match without
+    // locking the mutex for every candidate.
+    std::mutex                 bestMatchMutex{};
+    std::optional<std::string> bestMatch{};
+    KeyspaceIndex              bestMatchIndex{0U};
+    std::atomic<std::uint64_t> bestMatchVersion{0U};
+
+    std::atomic<bool>               hasFailed{false};
+    std::vector<std::exception_ptr> exceptions(workerCount);
+    std::vector<std::thread>        workers{};
+    workers.reserve(workerCount);
+
+    const auto work = [&](std::size_t worker) {
+      ChunkSizeTuner tuner{
+        ChunkSizeTuner::s_defaultTargetChunkDuration, chunkGranularity};
+      std::uint64_t  knownVersion{0U};
+      KeyspaceIndex  limit{wordCount}; // first index not to check
+
+      try {
+        KeyspaceRangeSource<AlphabetSize> source{alphabet, curWordLen};
+        auto                              search{makeSearch(curWordLen)};
+
+        while (const std::optional<KeyspaceRange> chunk{
+                 scheduler.next(worker, tuner.getChunkSize())}) {
+          const ChunkSizeTuner::clock::time_point chunkStart{
+            ChunkSizeTuner::clock::now()};
+          std::optional<KeyspaceIndex> matchIndex{};
+          source.seek(curWordLen, *chunk);
+
+          for (;;) {
+            if (hasFailed.load(std::memory_order_relaxed)) {
+              return;
+            }
+
+            if (
+              bestMatchVersion.load(std::memory_order_acquire)
+              != knownVersion) {
+              std::lock_guard<std::mutex> lock{bestMatchMutex};
+              knownVersion = bestMatchVersion.load();
+              limit        = bestMatchIndex;
+            }
+
+            // never generates the words at or beyond the limit.
+            source.truncate(limit);
+
+            if (source.isExhausted()) {
+              break;
+            }
+
+            if (const std::optional<KeyspaceIndex> index{search(source)}) {
+              {
+                std::lock_guard<std::mutex> lock{bestMatchMutex};
+
+                if (not bestMatch or *index < bestMatchIndex) {
+                  bestMatch      = *keyspace.iteratorAt(*index);
+                  bestMatchIndex = *index;
+                  ++bestMatchVersion;
+                }
+              }
+
+              scheduler.truncate(*index);
+              matchIndex = index;
+              break;
+            }
+          }
+
+          // the words before the match have all been checked.
+          const KeyspaceIndex searchedEnd{
+            matchIndex.value_or(source.getIndex())};
+          const std::uint64_t chunkCandidateCount{
+            static_cast<std::uint64_t>(searchedEnd - chunk->begin)};
+          candidateCount.fetch_add(
+            chunkCandidateCount, std::memory_order_relaxed);
+          tuner.update(
+            chunkCandidateCount, ChunkSizeTuner::clock::now() - chunkStart);
+
+          // once per chunk, so that publishing costs nothing measurable.
+          if (progress != nullptr) {
+            progress->publish(
+              worker, chunkCandidateCount, tuner.getCandidatesPerSecond());
+          }
+
+          if (checkpointer != nullptr) {
+            checkpointer->markCompleted(
+              KeyspaceRange{chunk->begin, searchedEnd});
+          }
+        }
+      }
+      catch (...) {
+        exceptions[worker] = std::current_exception();
+        hasFailed.store(true);
+      }
+    };
+
+    for (std::size_t worker{0U}; worker < workerCount; ++worker) {
+      workers.emplace_back(work, worker);
+    }
+
+    for (std::thread& thread : workers) {
+      thread.join();
+    }
+
+    for (const std::exception_ptr& exception : exceptions) {
+      if (exception) {
+        std::rethrow_exception(exception);
+      }
+    }
+
+    if (bestMatch) {
+      return std::move(*bestMatch);
+    }
+  }
+
+  throw KeyspaceExhaustedException{
+    minLength,
+    maxLength,
+    candidateCount.load(),
+    KeyspaceExhaustedException::clock::now() - start};
+}
+
+} // namespace detail
+
+/*!
+ * \brief Multi-threaded bruteforce algorithm.
+ * \param doesMatch Callable to determine if the current string matches.
+ *                  Will be called from several threads at once!
+ * \param alphabet The alphabet to use.
+ * \param options The options.
+ * \return The same string that bruteforce would return, that is the
+ *         shortest one for which 'doesMatch' returns true and of those
+ *         the first one in the order of the alphabet.
+ * \throws KeyspaceExhaustedException if none of the words of the lengths
+ *         to search matched.
+ * \throws KeyspaceTooLargeException if the keyspace of a word length that
+ *         had to be searched does not fit into a KeyspaceIndex.
+ * \throws CheckpointException if the alphabet of the checkpoint of the
+ *         checkpointer is not 'alphabet' or saving the checkpoint failed.
+ * \note Exceptions thrown by 'doesMatch' stop all the workers and are
+ *       rethrown.
+ *
+ * The words of each length are handed out to the workers in chunks by a
+ * WorkStealingScheduler, the chunk sizes are tuned from the throughput
+ * measured by each worker. Once a match is found the work beyond it is
+ * dropped, the work before it is still searched, as it may contain a
+ * match that comes first.
+ * Only chunks that have been searched completely are recorded by the
+ * checkpointer, so resuming repeats at most the chunks that were being
+ * searched when the application stopped.
+ * The workers publish their progress to options.progress after every
+ * chunk.
+ **/
+template<std::size_t AlphabetSize, typename Callable>
+std::string parallelBruteforce(
+  const Callable&                       doesMatch,
+  const std::array<char, AlphabetSize>& alphabet,
+  const ParallelBruteforceOptions&      options)
+{
+  const std::size_t batchSize{std::max<std::size_t>(options.batchSize, 1U)};
+
+  // the words are checked in place, in steps of 'batchSize' words between
+  // which the workers look for matches of the others.
+  return detail::parallelBruteforceImpl(
+    [&doesMatch, batchSize](std::size_t) {
+      return [&doesMatch,
+              batchSize](KeyspaceRangeSource<AlphabetSize>& source) {
+        return source.find(doesMatch, batchSize);
+      };
+    },
+    alphabet,
+    options,
+    1U);
+}
+
+/*!
+ * \brief Multi-threaded bruteforce algorithm that checks the words in
+ *        batches.
+ * \param findMatch Callable that takes a const CandidateBatch& and returns
+ *                  a std::optional<std::size_t> with the index of the
+ *                  first candidate that matches or nullopt if none does,
+ *                  such as CrackTarget::findIn.
+ *                  Will be called from several threads at once!
+ * \param alphabet The alphabet to use.
+ * \param options The options, options.batchSize is the capacity of the
+ *                batches.
+ * \return The same string that parallelBruteforce would return.
+ * \throws The same as parallelBruteforce, exceptions thrown by
+ *         'findMatch' are rethrown.
+ *
+ * Searches like parallelBruteforce, but every worker copies the words of
+ * its chunks into a CandidateBatch through a KeyspaceRangeSource, so that
+ * 'findMatch' can hash them at once, such as with bcryptVerifyBatch.
+ * The chunks are multiples of options.batchSize, so the batches are only
+ * partially filled at the ends of the keyspace, of a chunk stolen by
+ * another worker or once a match limits the search.
+ **/
+template<std::size_t AlphabetSize, typename BatchVerifier>
+std::string parallelBatchBruteforce(
+  const BatchVerifier&                  findMatch,
+  const std::array<char, AlphabetSize>& alphabet,
+  const ParallelBruteforceOptions&      options)
+{
+  const std::size_t batchSize{std::max<std::size_t>(options.batchSize, 1U)};
+
+  return detail::parallelBruteforceImpl(
+    [&findMatch, batchSize](std::size_t wordLength) {
+      // every worker fills its own batch.
+      return [&findMatch, batch = CandidateBatch{batchSize, wordLength}](
+               KeyspaceRangeSource<AlphabetSize>& source) mutable
+             -> std::optional<KeyspaceIndex> {
+        const KeyspaceIndex first{source.getIndex()};
+        source.next(batch);
+
+        const CandidateBatch&            candidates{batch};
+        const std::optional<std::size_t> match{findMatch(candidates)};
+
+        if (not match) {
+          return std::nullopt;
+        }
+
+        return first + *match;
+      };
+    },
+    alphabet,
+    options,
+    batchSize);
+}
+
+/*!
+ * \brief Multi-threaded bruteforce algorithm over all the word lengths
+ *        from 0 to the size of the alphabet.
+ * \param doesMatch Callable to determine if the current string matches.
+ *                  Will be called from several threads at once!
+ * \param alphabet The alphabet to use.
+ * \param threadCount The amount of worker threads to use. 0 is treated
+ *                    as 1.
+ * \param checkpointer The Checkpointer to record the progress with or
+ *                     nullptr not to record the progress.
+ * \return The match found.
+ * \see parallelBruteforce
+ **/
+template<std::size_t AlphabetSize, typename Callable>
+std::string parallelBruteforce(
+  const Callable&                       doesMatch,
+  const std::array<char, AlphabetSize>& alphabet,
+  std::size_t   threadCount  = std::thread::hardware_concurrency(),
+  Checkpointer* checkpointer = nullptr)
+{
+  ParallelBruteforceOptions options{};
+  options.threadCount  = threadCount;
+  options.checkpointer = checkpointer;
+
+  return parallelBruteforce(doesMatch, alphabet, options);
+}
+} // namespace itsp3
+#endif // INCG_ITSP3_PARALLEL_BRUTEFORCE_HPP
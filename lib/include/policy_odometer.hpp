@@ -0,0 +1,323 @@
+/*!
+ * \file policy_odometer.hpp
+ * \brief Exports the PolicyOdometer, which generates only the words that
+ *        satisfy a PasswordPolicy, and the bruteforce algorithm built on
+ *        top of it.
+ **/
+#ifndef INCG_ITSP3_POLICY_ODOMETER_HPP
+#define INCG_ITSP3_POLICY_ODOMETER_HPP
+#include "bruteforce.hpp"     // itsp3::KeyspaceExhaustedException
+#include "check_password.hpp" // itsp3::PasswordPolicy, itsp3::isLowerCase
+#include <array>              // std::array
+#include <ciso646>            // not, and, or
+#include <cstddef>            // std::size_t
+#include <cstdint>            // std::uint64_t
+#include <pl/assert.hpp>      // PL_DBG_CHECK_PRE
+#include <string>             // std::string
+#include <utility>            // std::move
+#include <vector>             // std::vector
+
+namespace itsp3 {
+/*!
+ * \brief Generates the words of a given length over an alphabet that
+ *        satisfy a PasswordPolicy, in the order of bruteforce.
+ *
+ * Works like the Odometer, but only accepts a character for a position
+ * if the positions after it can still supply all the character classes
+ * the policy requires and the word is still lacking. That prunes whole
+ * subtrees of words that could never satisfy the policy rather than
+ * generating and rejecting them one by one. The word equal to the
+ * username is skipped if the policy rejects it.
+ **/
+template<std::size_t AlphabetSize>
+class PolicyOdometer {
+public:
+  using this_type     = PolicyOdometer;
+  using alphabet_type = std::array<char, AlphabetSize>;
+
+  /*!
+   * \brief Creates a PolicyOdometer whose word is the empty word.
+   * \param alphabet The alphabet to use.
+   * \param policy The policy the words have to satisfy.
+   * \param username The username the words are passwords of.
+   * \param maxLength The maximum word length that will be used.
+   **/
+  PolicyOdometer(
+    const alphabet_type&  alphabet,
+    const PasswordPolicy& policy,
+    std::string           username,
+    std::size_t           maxLength)
+    : m_alphabet{alphabet}
+    , m_policy{policy}
+    , m_username{std::move(username)}
+    , m_maxLength{maxLength}
+    , m_classes{}
+    , m_requiredClasses{0U}
+    , m_word{}
+    , m_digits{}
+    , m_missingClasses{}
+  {
+    if (m_policy.requiresLowerCase) {
+      m_requiredClasses |= s_lowerCase;
+    }
+
+    if (m_policy.requiresUpperCase) {
+      m_requiredClasses |= s_upperCase;
+    }
+
+    if (m_policy.requiresNumber) {
+      m_requiredClasses |= s_number;
+    }
+
+    if (m_policy.requiresSpecialCharacter) {
+      m_requiredClasses |= s_specialCharacter;
+    }
+
+    unsigned availableClasses{0U};
+
+    for (std::size_t i{0U}; i < AlphabetSize; ++i) {
+      m_classes[i] = classOf(m_alphabet[i]);
+      availableClasses |= m_classes[i];
+    }
+
+    m_isSatisfiable = (m_requiredClasses & ~availableClasses) == 0U;
+
+    m_word.reserve(m_maxLength);
+    m_digits.reserve(m_maxLength);
+    m_missingClasses.reserve(m_maxLength + 1U);
+  }
+
+  /*!
+   * \brief Sets the word to the first word of a given length that
+   *        satisfies the policy.
+   * \param wordLength The word length, may not exceed the maxLength.
+   * \return false if no word of length 'wordLength' satisfies the policy,
+   *         the word is unspecified in that case. Otherwise true.
+   **/
+  bool reset(std::size_t wordLength)
+  {
+    PL_DBG_CHECK_PRE(wordLength <= m_maxLength);
+
+    // stays within the capacity reserved -> never allocates.
+    m_word.resize(wordLength);
+    m_digits.assign(wordLength, 0U);
+    m_missingClasses.assign(wordLength + 1U, 0U);
+    m_missingClasses[0U] = m_requiredClasses;
+
+    if (
+      not m_isSatisfiable or wordLength < m_policy.minLength
+      or classCount(m_requiredClasses) > wordLength) {
+      return false;
+    }
+
+    fill(0U);
+    return not isUsername() or advance();
+  }
+
+  /*!
+   * \brief Advances to the next word of the current length that
+   *        satisfies the policy.
+   * \return false if the current word was the last one, the word is
+   *         unspecified in that case. Otherwise true.
+   **/
+  bool advance() noexcept
+  {
+    do {
+      if (not step()) {
+        return false;
+      }
+    } while (isUsername());
+
+    return true;
+  }
+
+  /*!
+   * \brief Read accessor for the current word.
+   * \return The current word.
+   **/
+  const std::string& getWord() const noexcept { return m_word; }
+
+private:
+  static constexpr unsigned s_lowerCase{1U << 0U};
+  static constexpr unsigned s_upperCase{1U << 1U};
+  static constexpr unsigned s_number{1U << 2U};
+  static constexpr unsigned s_specialCharacter{1U << 3U};
+
+  /*!
+   * \brief Determines the character class of a character.
+   * \param c The character.
+   * \return The class of 'c' or 0 if it belongs to none of them.
+   **/
+  static unsigned classOf(char c) noexcept
+  {
+    if (isLowerCase(c)) {
+      return s_lowerCase;
+    }
+
+    if (isUpperCase(c)) {
+      return s_upperCase;
+    }
+
+    if (isNumber(c)) {
+      return s_number;
+    }
+
+    return isSpecialCharacter(c) ? s_specialCharacter : 0U;
+  }
+
+  /*!
+   * \brief Counts the character classes in a set of classes.
+   * \param classes The set of classes.
+   * \return The amount of classes.
+   **/
+  static std::size_t classCount(unsigned classes) noexcept
+  {
+    return static_cast<std::size_t>(__builtin_popcount(classes));
+  }
+
+  /*!
+   * \brief Checks whether a character may be put at a position.
+   * \param position The position.
+   * \param digit The position of the character in the alphabet.
+   * \return true if the positions after 'position' can still supply the
+   *         classes missing after putting the character there.
+   **/
+  bool isAllowed(std::size_t position, std::size_t digit) const noexcept
+  {
+    const unsigned missing{m_missingClasses[position] & ~m_classes[digit]};
+    return classCount(missing) <= m_word.size() - position - 1U;
+  }
+
+  /*!
+   * \brief Puts a character at a position.
+   * \param position The position.
+   * \param digit The position of the character in the alphabet.
+   **/
+  void put(std::size_t position, std::size_t digit) noexcept
+  {
+    m_digits[position]             = digit;
+    m_word[position]               = m_alphabet[digit];
+    m_missingClasses[position + 1] = m_missingClasses[position]
+                                     & ~m_classes[digit];
+  }
+
+  /*!
+   * \brief Puts the first allowed characters at the positions from a
+   *        position on.
+   * \param first The first position to fill.
+   * \note There always is an allowed character, as the classes missing
+   *       never outnumber the positions left and the alphabet has a
+   *       character of each class required.
+   **/
+  void fill(std::size_t first) noexcept
+  {
+    for (std::size_t i{first}; i < m_word.size(); ++i) {
+      std::size_t digit{0U};
+
+      while (not isAllowed(i, digit)) {
+        ++digit;
+      }
+
+      put(i, digit);
+    }
+  }
+
+  /*!
+   * \brief Advances to the next word that satisfies the character class
+   *        requirements.
+   * \return false if there is none.
+   **/
+  bool step() noexcept
+  {
+    for (std::size_t i{m_word.size()}; i-- > 0U;) {
+      for (std::size_t digit{m_digits[i] + 1U}; digit < AlphabetSize;
+           ++digit) {
+        if (isAllowed(i, digit)) {
+          put(i, digit);
+          fill(i + 1U);
+          return true;
+        }
+      }
+    }
+
+    return false;
+  }
+
+  /*!
+   * \brief Checks whether the current word is rejected for being equal to
+   *        the username.
+   * \return true if it is rejected.
+   **/
+  bool isUsername() const noexcept
+  {
+    return m_policy.rejectsUsername and m_word == m_username;
+  }
+
+  alphabet_type                      m_alphabet;
+  PasswordPolicy                     m_policy;
+  std::string                        m_username;
+  std::size_t                        m_maxLength;
+  std::array<unsigned, AlphabetSize> m_classes; /*!< The class of each
+                                                 *   character.
+                                                 **/
+  unsigned                 m_requiredClasses;
+  bool                     m_isSatisfiable;
+  std::string              m_word;
+  std::vector<std::size_t> m_digits;
+  std::vector<unsigned>    m_missingClasses; /*!< The classes required but
+                                              *   missing before each
+                                              *   position.
+                                              **/
+};
+
+/*!
+ * \brief Bruteforce algorithm that only tries the words that satisfy a
+ *        PasswordPolicy.
+ * \param doesMatch Callable to determine if the current string matches.
+ * \param alphabet The alphabet to use.
+ * \param policy The policy the passwords have to satisfy.
+ * \param username The username the passwords belong to.
+ * \param maxLength The length of the longest words to try.
+ * \return The same string that bruteforce would return, if it satisfies
+ *         the policy.
+ * \throws KeyspaceExhaustedException if none of the words of the lengths
+ *         [policy.minLength .. maxLength] that satisfy the policy matched.
+ **/
+template<std::size_t AlphabetSize, typename Callable>
+std::string policyBruteforce(
+  const Callable&                       doesMatch,
+  const std::array<char, AlphabetSize>& alphabet,
+  const PasswordPolicy&                 policy,
+  const std::string&                    username,
+  std::size_t                           maxLength = AlphabetSize)
+{
+  const KeyspaceExhaustedException::clock::time_point start{
+    KeyspaceExhaustedException::clock::now()};
+  std::uint64_t candidateCount{0U};
+
+  PolicyOdometer<AlphabetSize> odometer{
+    alphabet, policy, username, maxLength};
+
+  for (std::size_t curWordLen{policy.minLength}; curWordLen <= maxLength;
+       ++curWordLen) {
+    if (not odometer.reset(curWordLen)) {
+      continue;
+    }
+
+    do {
+      ++candidateCount;
+
+      if (doesMatch(odometer.getWord())) {
+        return odometer.getWord();
+      }
+    } while (odometer.advance());
+  }
+
+  throw KeyspaceExhaustedException{
+    policy.minLength,
+    maxLength,
+    candidateCount,
+    KeyspaceExhaustedException::clock::now() - start};
+}
+} // namespace itsp3
+#endif // INCG_ITSP3_POLICY_ODOMETER_HPP
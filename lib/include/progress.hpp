@@ -0,0 +1,233 @@
+/*!
+ * \file progress.hpp
+ * \brief Exports types to observe the progress of a bruteforce run while
+ *        it is running.
+ **/
+#ifndef INCG_ITSP3_PROGRESS_HPP
+#define INCG_ITSP3_PROGRESS_HPP
+#include "keyspace_index.hpp" // itsp3::KeyspaceIndex
+#include <atomic>             // std::atomic
+#include <chrono>             // std::chrono::steady_clock
+#include <condition_variable> // std::condition_variable
+#include <cstddef>            // std::size_t
+#include <cstdint>            // std::uint64_t
+#include <iosfwd>             // std::ostream
+#include <memory>             // std::unique_ptr
+#include <mutex>              // std::mutex
+#include <optional>           // std::optional
+#include <string>             // std::string
+#include <thread>             // std::thread
+#include <vector>             // std::vector
+
+namespace itsp3 {
+/*!
+ * \brief The progress of a bruteforce run at some point in time.
+ * \see ProgressCounters::snapshot
+ **/
+struct ProgressSnapshot {
+  using clock = std::chrono::steady_clock;
+
+  /*!
+   * \brief The progress of a single worker.
+   **/
+  struct Worker {
+    std::uint64_t candidateCount;      /*!< The candidates tried */
+    double        candidatesPerSecond; /*!< The throughput measured */
+  };
+
+  std::size_t   wordLength;     /*!< The word length being searched */
+  KeyspaceIndex lengthSize;     /*!< The amount of words of 'wordLength' */
+  KeyspaceIndex searchedCount;  /*!< The words of 'wordLength' searched,
+                                 *   including the ones searched before
+                                 *   resuming.
+                                 **/
+  std::uint64_t candidateCount; /*!< The candidates tried by all the
+                                 *   workers since the run started.
+                                 **/
+  double candidatesPerSecond;   /*!< The throughput of all the workers */
+  clock::duration elapsed;      /*!< The time since the run started */
+
+  /*!
+   * \brief The estimated time it takes to search the rest of the words of
+   *        'wordLength', nullopt if no throughput was measured yet.
+   **/
+  std::optional<clock::duration> eta;
+
+  std::vector<Worker> workers; /*!< The progress of every worker */
+};
+
+/*!
+ * \brief Prints a ProgressSnapshot as a single line of text without a
+ *        line break, for instance
+ *        "length 6: 12.50 % (2000 / 16000), 5120.0 candidates/s,
+ *        ETA 0h 0m 3s".
+ * \param os The ostream to print to.
+ * \param snapshot The ProgressSnapshot to print.
+ * \return A reference to 'os'.
+ **/
+std::ostream& operator<<(std::ostream& os, const ProgressSnapshot& snapshot);
+
+/*!
+ * \brief Writes a ProgressSnapshot to a file as a JSON object.
+ * \param filePath The path of the file to write to.
+ * \param snapshot The ProgressSnapshot to write.
+ * \return true on success, false on failure.
+ * \note Writes to a temporary file that is then renamed to 'filePath', so
+ *       that readers never see a partially written file.
+ **/
+bool writeProgressStats(
+  const std::string&      filePath,
+  const ProgressSnapshot& snapshot);
+
+/*!
+ * \brief Counters the workers of a bruteforce run publish their progress
+ *        to.
+ *
+ * Every worker has its own counters, each on its own cache line, so that
+ * publishing does neither lock nor contend with the other workers. The
+ * workers publish once per chunk rather than once per candidate, which
+ * keeps the overhead out of the throughput.
+ * \note May be used from several threads at once.
+ * \see ParallelBruteforceOptions::progress
+ **/
+class ProgressCounters {
+public:
+  using this_type = ProgressCounters;
+  using clock     = ProgressSnapshot::clock;
+
+  /*!
+   * \brief Creates ProgressCounters.
+   * \param workerCount The maximum amount of workers that publish their
+   *                    progress, 0 is treated as 1.
+   **/
+  explicit ProgressCounters(std::size_t workerCount);
+
+  ProgressCounters(const this_type&) = delete;
+
+  this_type& operator=(const this_type&) = delete;
+
+  /*!
+   * \brief Read accessor for the amount of workers.
+   * \return The maximum amount of workers.
+   **/
+  std::size_t getWorkerCount() const noexcept;
+
+  /*!
+   * \brief Advances to a word length.
+   * \param wordLength The word length searched next.
+   * \param lengthSize The amount of words of 'wordLength'.
+   * \param searchedCount The amount of words of 'wordLength' that have
+   *                      already been searched, for instance before
+   *                      resuming.
+   * \note To be called while no worker is publishing.
+   **/
+  void beginWordLength(
+    std::size_t   wordLength,
+    KeyspaceIndex lengthSize,
+    KeyspaceIndex searchedCount);
+
+  /*!
+   * \brief Publishes the progress of a worker.
+   * \param worker The index of the worker, less than getWorkerCount().
+   * \param candidateCount The amount of candidates the worker has tried
+   *                       since it last published.
+   * \param candidatesPerSecond The throughput the worker measured.
+   **/
+  void publish(
+    std::size_t   worker,
+    std::uint64_t candidateCount,
+    double        candidatesPerSecond) noexcept;
+
+  /*!
+   * \brief Takes a snapshot of the progress.
+   * \return The progress.
+   **/
+  ProgressSnapshot snapshot() const;
+
+private:
+  /*!
+   * \brief The counters of a worker, aligned to a cache line so that no
+   *        two workers share one.
+   **/
+  struct alignas(64) Worker {
+    std::atomic<std::uint64_t> candidateCount{0U};
+    std::atomic<double>        candidatesPerSecond{0.0};
+  };
+
+  const std::size_t         m_workerCount;
+  std::unique_ptr<Worker[]> m_workers;
+  const clock::time_point   m_start;
+  mutable std::mutex        m_mutex; /*!< Guards the members below */
+  std::size_t               m_wordLength;
+  KeyspaceIndex             m_lengthSize;
+  KeyspaceIndex             m_searchedBefore; /*!< Searched before the
+                                               *   workers began the
+                                               *   word length.
+                                               **/
+  std::uint64_t m_lengthStart; /*!< The candidates of all the workers when
+                                *   the word length began.
+                                **/
+};
+
+/*!
+ * \brief Reports the progress of ProgressCounters on an interval from a
+ *        thread of its own, as long as it exists.
+ *
+ * Overwrites a single progress line on an ostream and optionally writes
+ * the progress to a stats file for other applications to read.
+ **/
+class ProgressReporter {
+public:
+  using this_type = ProgressReporter;
+  using clock     = ProgressSnapshot::clock;
+
+  static const clock::duration s_defaultInterval; /*!< 1 second */
+
+  /*!
+   * \brief Creates a ProgressReporter and starts reporting.
+   * \param counters The ProgressCounters to report, must outlive the
+   *                 ProgressReporter.
+   * \param os The ostream to print the progress line to, usually
+   *           std::cerr. Must outlive the ProgressReporter.
+   * \param statsFilePath The path of the file to write the progress to
+   *                      using writeProgressStats, empty for none.
+   * \param interval The duration between two reports.
+   **/
+  ProgressReporter(
+    const ProgressCounters& counters,
+    std::ostream&           os,
+    std::string             statsFilePath = "",
+    clock::duration         interval      = s_defaultInterval);
+
+  ProgressReporter(const this_type&) = delete;
+
+  this_type& operator=(const this_type&) = delete;
+
+  /*!
+   * \brief Reports the final progress, ends the progress line and stops
+   *        the thread.
+   **/
+  ~ProgressReporter();
+
+private:
+  /*!
+   * \brief Reports the current progress.
+   **/
+  void report();
+
+  /*!
+   * \brief The function run by m_thread.
+   **/
+  void run();
+
+  const ProgressCounters& m_counters;
+  std::ostream&           m_os;
+  const std::string       m_statsFilePath;
+  const clock::duration   m_interval;
+  std::mutex              m_mutex; /*!< Guards m_isStopping */
+  std::condition_variable m_conditionVariable;
+  bool                    m_isStopping;
+  std::thread             m_thread;
+};
+} // namespace itsp3
+#endif // INCG_ITSP3_PROGRESS_HPP
@@ -1,5 +1,6 @@
 #ifndef INCG_ITSP3_RECORD_HPP
 #define INCG_ITSP3_RECORD_HPP
+#include <cstdint>       // std::uint64_t
 #include <iosfwd>        // std::ostream, std::istream
 #include <pl/except.hpp> // PL_THROW_WITH_SOURCE_INFO, PL_DEFINE_EXCEPTION_TYPE
 #include <stdexcept>     // std::logic_error
@@ -65,5 +66,24 @@ private:
   std::string m_username;
   std::string m_hash;
 };
+
+/*!
+ * \brief Determines where the last complete record in a binary stream ends.
+ * \param is The input stream to read from.
+ * \param offset The byte offset to start reading records at.
+ *               Must be the byte offset of the beginning of a record.
+ * \param limit Records ending beyond this byte offset are not considered.
+ * \return The byte offset just past the last complete record that follows
+ *         'offset' and ends at or before 'limit'.
+ *         Returns 'offset' if no such record follows it.
+ * \warning 'is' must be opened and have been opened with the binary flag.
+ * \note Clears the state of 'is' before returning, so that it may be
+ *       seeked and read from again. Trailing bytes of a record that is
+ *       still being written are not included.
+ **/
+std::uint64_t findEndOfCompleteRecords(
+  std::istream& is,
+  std::uint64_t offset,
+  std::uint64_t limit = UINT64_MAX);
 } // namespace itsp3
 #endif // INCG_ITSP3_RECORD_HPP
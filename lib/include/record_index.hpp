@@ -0,0 +1,82 @@
+/*!
+ * \file record_index.hpp
+ * \brief Exports the RecordIndex type, an in memory index of the records of
+ *        the binary file that is refreshed incrementally.
+ **/
+#ifndef INCG_ITSP3_RECORD_INDEX_HPP
+#define INCG_ITSP3_RECORD_INDEX_HPP
+#include <cstddef>       // std::size_t
+#include <cstdint>       // std::uint64_t
+#include <mutex>         // std::mutex
+#include <optional>      // std::optional
+#include <shared_mutex>  // std::shared_mutex
+#include <string>        // std::string
+#include <string_view>   // std::string_view
+#include <unordered_map> // std::unordered_map
+
+namespace itsp3 {
+/*!
+ * \brief Maps the usernames of the records of the binary file to their
+ *        hashes.
+ * \note Thread safe.
+ *
+ * Remembers the byte offset up to which the binary file has been indexed,
+ * so that a refresh only parses the records appended since the last one.
+ **/
+class RecordIndex {
+public:
+  using this_type = RecordIndex;
+
+  /*!
+   * \brief Creates an empty RecordIndex.
+   * \param filePath The path to the binary file to index.
+   * \note Call refresh to actually index the binary file.
+   **/
+  explicit RecordIndex(std::string filePath);
+
+  /*!
+   * \brief Indexes the complete records appended to the binary file since
+   *        the last refresh.
+   * \return The amount of records newly indexed.
+   * \note Costs O(new records). A record that is still being written is
+   *       picked up by a later refresh. If the binary file was replaced,
+   *       that is it is a different file or shrank, it is indexed from
+   *       scratch. Does nothing if the binary file does not exist (yet).
+   **/
+  std::size_t refresh();
+
+  /*!
+   * \brief Looks up the hash of a username.
+   * \param username The username to look up the hash of.
+   * \return The hash of 'username' if it has been indexed,
+   *         otherwise a nullopt.
+   * \note Does not refresh the index.
+   **/
+  std::optional<std::string> find(std::string_view username) const;
+
+  /*!
+   * \brief Read accessor for the amount of indexed records.
+   * \return The amount of records indexed.
+   **/
+  std::size_t getRecordCount() const;
+
+  /*!
+   * \brief Read accessor for the byte offset up to which the binary file
+   *        has been indexed.
+   * \return The indexed byte offset.
+   **/
+  std::uint64_t getIndexedOffset() const;
+
+private:
+  std::string               m_filePath;
+  mutable std::shared_mutex m_mutex;        /*!< Guards the hashes and
+                                             *   the indexed offset.
+                                             **/
+  std::mutex                m_refreshMutex; /*!< Serializes refreshes */
+  std::unordered_map<std::string, std::string> m_hashes;
+  std::uint64_t                                m_indexedOffset;
+  std::uint64_t m_indexedDevice; /*!< Of the binary file indexed */
+  std::uint64_t m_indexedInode;  /*!< Of the binary file indexed */
+};
+} // namespace itsp3
+#endif // INCG_ITSP3_RECORD_INDEX_HPP
@@ -0,0 +1,242 @@
+/*!
+ * \file replication.hpp
+ * \brief Exports types to replicate the binary file to read only followers
+ *        by shipping the records appended to it over Unix domain sockets.
+ *
+ * The protocol is deliberately simple:
+ * After connecting, a follower sends the byte offset up to which its local
+ * copy is complete as an 8 byte little endian unsigned integer.
+ * The primary then repeatedly sends frames, each made up of a 20 byte header
+ * followed by the payload. The header holds the byte offset of the payload
+ * in the binary file (8 bytes), the size of the complete records in the
+ * binary file of the primary (8 bytes) and the byte size of the payload
+ * (4 bytes), all as little endian unsigned integers.
+ * The payload only ever contains complete records, frames without a
+ * payload are sent as heartbeats so that followers can observe their lag.
+ * If the binary file of the primary was replaced or is shorter than the
+ * offset of the follower the primary starts over at offset 0. A follower
+ * whose local copy is not empty discards it when it receives a frame at
+ * offset 0.
+ **/
+#ifndef INCG_ITSP3_REPLICATION_HPP
+#define INCG_ITSP3_REPLICATION_HPP
+#include "bcrypt.hpp"    // itsp3::Bcrypt
+#include <atomic>        // std::atomic
+#include <chrono>        // std::chrono::milliseconds
+#include <cstdint>       // std::uint64_t
+#include <list>          // std::list
+#include <mutex>         // std::mutex
+#include <pl/except.hpp> // PL_DEFINE_EXCEPTION_TYPE, PL_THROW_WITH_SOURCE_INFO
+#include <stdexcept>     // std::runtime_error
+#include <string>        // std::string
+#include <string_view>   // std::string_view
+#include <thread>        // std::thread
+
+namespace itsp3 {
+PL_DEFINE_EXCEPTION_TYPE(ReplicationException, std::runtime_error);
+
+/*!
+ * \brief Streams the records appended to a binary file to followers.
+ * \note Every follower is served by its own thread.
+ **/
+class ReplicationPrimary {
+public:
+  using this_type = ReplicationPrimary;
+
+  /*!
+   * \brief Creates a ReplicationPrimary that is not yet listening.
+   * \param filePath The path to the binary file to replicate.
+   * \param socketPath The path of the Unix domain socket to listen on.
+   * \param pollInterval The interval at which the binary file is checked
+   *                     for newly appended records.
+   **/
+  ReplicationPrimary(
+    std::string               filePath,
+    std::string               socketPath,
+    std::chrono::milliseconds pollInterval = std::chrono::milliseconds{10});
+
+  ReplicationPrimary(const this_type&) = delete;
+
+  this_type& operator=(const this_type&) = delete;
+
+  /*!
+   * \brief Stops the primary.
+   **/
+  ~ReplicationPrimary();
+
+  /*!
+   * \brief Starts listening for followers.
+   * \throws ReplicationException if the socket could not be set up.
+   * \warning May only be called once.
+   **/
+  void start();
+
+  /*!
+   * \brief Disconnects all the followers and stops listening.
+   * \note Removes the socket file. Does nothing if not started.
+   **/
+  void stop();
+
+  /*!
+   * \brief Read accessor for the amount of followers currently connected.
+   * \return The amount of connected followers.
+   **/
+  std::size_t getFollowerCount() const noexcept;
+
+private:
+  /*!
+   * \brief A thread serving a follower.
+   **/
+  struct FollowerThread {
+    std::thread       thread;             /*!< Runs serveFollower */
+    std::atomic<bool> hasFinished{false}; /*!< Set once it is done */
+  };
+
+  /*!
+   * \brief Accepts followers until stopped.
+   * \note Joins the threads of the followers that have disconnected, so
+   *       that reconnecting followers do not accumulate threads.
+   **/
+  void acceptLoop();
+
+  /*!
+   * \brief Joins and removes the threads that have finished serving their
+   *        follower.
+   **/
+  void joinFinishedFollowerThreads();
+
+  /*!
+   * \brief Ships the records to a single follower until stopped or the
+   *        follower disconnects.
+   * \note Reopens the binary file if it was replaced and then ships it
+   *       from the beginning.
+   * \param socket The connected socket of the follower. Closed on return.
+   * \param hasFinished Set to true on return.
+   **/
+  void serveFollower(int socket, std::atomic<bool>& hasFinished);
+
+  std::string               m_filePath;
+  std::string               m_socketPath;
+  std::chrono::milliseconds m_pollInterval;
+  int                       m_listenSocket;
+  std::atomic<bool>         m_isRunning;
+  std::atomic<std::size_t>  m_followerCount;
+  std::thread               m_acceptThread;
+  std::mutex                m_followerThreadsMutex;
+  std::list<FollowerThread> m_followerThreads; /*!< A list, as
+                                                *   std::atomic is not
+                                                *   movable.
+                                                **/
+};
+
+/*!
+ * \brief Keeps a local copy of the binary file of a primary up to date
+ *        and serves read only password checks from it.
+ **/
+class ReplicationFollower {
+public:
+  using this_type = ReplicationFollower;
+
+  /*!
+   * \brief Creates a ReplicationFollower that is not yet connected.
+   * \param localFilePath The path to the local copy of the binary file.
+   *                      An existing local copy is continued from
+   *                      its last complete record.
+   * \param socketPath The path of the Unix domain socket of the primary.
+   **/
+  ReplicationFollower(std::string localFilePath, std::string socketPath);
+
+  ReplicationFollower(const this_type&) = delete;
+
+  this_type& operator=(const this_type&) = delete;
+
+  /*!
+   * \brief Stops the follower.
+   **/
+  ~ReplicationFollower();
+
+  /*!
+   * \brief Connects to the primary and starts receiving records.
+   * \throws ReplicationException if the primary could not be reached or
+   *         the local copy could not be opened.
+   * \throws FileWatcherException if the local copy could not be watched.
+   * \warning May only be called once.
+   **/
+  void start();
+
+  /*!
+   * \brief Disconnects from the primary.
+   * \note Does nothing if not started.
+   **/
+  void stop();
+
+  /*!
+   * \brief Checks a given password of a given user for validity against
+   *        the local copy.
+   * \param username The username entered by the user.
+   * \param password The password to check for 'username'.
+   * \return true if 'password' is the correct password for the user
+   *         'username', otherwise false.
+   * \note Users not yet replicated are treated as non-existent.
+   * \see Bcrypt::checkPasswordValidity
+   **/
+  bool checkPasswordValidity(
+    std::string_view username,
+    std::string_view password);
+
+  /*!
+   * \brief Read accessor for the byte offset up to which the local copy
+   *        is complete.
+   * \return The replicated byte offset.
+   **/
+  std::uint64_t getReplicatedOffset() const noexcept;
+
+  /*!
+   * \brief Read accessor for the size of the complete records in the
+   *        binary file of the primary as of the last frame received.
+   * \return The byte offset of the primary.
+   **/
+  std::uint64_t getPrimaryOffset() const noexcept;
+
+  /*!
+   * \brief Calculates how many bytes the local copy is behind the primary.
+   * \return The lag in bytes.
+   **/
+  std::uint64_t getLagBytes() const noexcept;
+
+  /*!
+   * \brief Determines whether the connection to the primary is alive.
+   * \return true if connected, otherwise false.
+   **/
+  bool isConnected() const noexcept;
+
+  /*!
+   * \brief Blocks until the local copy is complete up to a byte offset.
+   * \param offset The byte offset to wait for.
+   * \param timeout The maximum duration to wait for.
+   * \return true if 'offset' was reached, false on timeout.
+   **/
+  bool waitForOffset(std::uint64_t offset, std::chrono::milliseconds timeout)
+    const;
+
+private:
+  /*!
+   * \brief Receives frames and appends them to the local copy until
+   *        stopped or disconnected.
+   **/
+  void receiveLoop();
+
+  std::string                m_localFilePath;
+  std::string                m_socketPath;
+  Bcrypt                     m_bcrypt; /*!< Only used to check passwords,
+                                        *   tail follows the local copy.
+                                        **/
+  int                        m_socket;
+  std::atomic<bool>          m_isRunning;
+  std::atomic<bool>          m_isConnected;
+  std::atomic<std::uint64_t> m_replicatedOffset;
+  std::atomic<std::uint64_t> m_primaryOffset;
+  std::thread                m_receiveThread;
+};
+} // namespace itsp3
+#endif // INCG_ITSP3_REPLICATION_HPP
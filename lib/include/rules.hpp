@@ -0,0 +1,137 @@
+/*!
+ * \file rules.hpp
+ * \brief Exports the word mangling rules, a subset of the rule syntax of
+ *        hashcat, used to derive candidates from the words of a wordlist.
+ **/
+#ifndef INCG_ITSP3_RULES_HPP
+#define INCG_ITSP3_RULES_HPP
+#include <cstddef>       // std::size_t
+#include <pl/except.hpp> // PL_DEFINE_EXCEPTION_TYPE
+#include <stdexcept>     // std::invalid_argument
+#include <string>        // std::string
+#include <string_view>   // std::string_view
+#include <vector>        // std::vector
+
+namespace itsp3 {
+PL_DEFINE_EXCEPTION_TYPE(RuleParseException, std::invalid_argument);
+
+/*!
+ * \brief A compiled mangling rule, a sequence of operations applied to a
+ *        word one after another.
+ *
+ * The operations supported are:
+ * :  do nothing.
+ * l  lower case all the characters.
+ * u  upper case all the characters.
+ * c  upper case the first character, lower case the rest.
+ * C  lower case the first character, upper case the rest.
+ * t  toggle the case of all the characters.
+ * TN toggle the case of the character at position N.
+ * r  reverse the word.
+ * d  duplicate the word.
+ * $X append the character X.
+ * ^X prepend the character X.
+ * [  delete the first character.
+ * ]  delete the last character.
+ * sXY replace all the characters X with Y.
+ * Positions N are 0 - 9 followed by A - Z for 10 - 35, spaces between the
+ * operations are ignored.
+ **/
+class Rule {
+public:
+  using this_type = Rule;
+
+  /*!
+   * \brief Compiles a rule.
+   * \param rule The rule to compile, e.g. "c$1$2".
+   * \return The Rule compiled.
+   * \throws RuleParseException if 'rule' is not a valid rule.
+   **/
+  static Rule parse(std::string_view rule);
+
+  /*!
+   * \brief Applies this Rule to a word.
+   * \param word The word to apply this Rule to.
+   * \param buffer The buffer to write the result to, its previous
+   *               contents are replaced. Reusing the same buffer avoids
+   *               allocating once its capacity has grown large enough.
+   * \warning 'word' may not refer to the contents of 'buffer'.
+   **/
+  void apply(std::string_view word, std::string& buffer) const;
+
+private:
+  /*!
+   * \brief The kinds of operations.
+   **/
+  enum class Opcode {
+    LowerCase,
+    UpperCase,
+    Capitalize,
+    InvertCapitalize,
+    ToggleCase,
+    ToggleCaseAt,
+    Reverse,
+    Duplicate,
+    Append,
+    Prepend,
+    DeleteFirst,
+    DeleteLast,
+    Replace
+  };
+
+  /*!
+   * \brief A compiled operation.
+   **/
+  struct Operation {
+    Opcode      opcode;
+    char        first;    /*!< The character of $, ^ and s */
+    char        second;   /*!< The replacement of s */
+    std::size_t position; /*!< The position of T */
+  };
+
+  Rule() = default;
+
+  std::vector<Operation> m_operations;
+};
+
+/*!
+ * \brief A list of compiled rules.
+ **/
+class RuleSet {
+public:
+  using this_type = RuleSet;
+
+  /*!
+   * \brief Compiles the rules of a rule file.
+   * \param rules One rule per line. Empty lines and lines beginning with
+   *              '#' are skipped.
+   * \return The RuleSet compiled.
+   * \throws RuleParseException if one of the rules is not valid, the
+   *         message names its line.
+   **/
+  static RuleSet parse(std::string_view rules);
+
+  /*!
+   * \brief Creates a RuleSet.
+   * \param rules The rules.
+   **/
+  explicit RuleSet(std::vector<Rule> rules);
+
+  /*!
+   * \brief Read accessor for the rules.
+   * \return The rules, in order.
+   **/
+  const std::vector<Rule>& getRules() const noexcept;
+
+  /*!
+   * \brief Read accessor for the amount of rules.
+   * \return The amount of rules, the amount of candidates derived from
+   *         each word.
+   **/
+  std::size_t size() const noexcept;
+
+private:
+  std::vector<Rule> m_rules;
+};
+} // namespace itsp3
+#endif // INCG_ITSP3_RULES_HPP
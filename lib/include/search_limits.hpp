@@ -0,0 +1,147 @@
+/*!
+ * \file search_limits.hpp
+ * \brief Exports types to stop searches from outside as well as after a
+ *        deadline or a budget of candidates.
+ **/
+#ifndef INCG_ITSP3_SEARCH_LIMITS_HPP
+#define INCG_ITSP3_SEARCH_LIMITS_HPP
+#include <atomic>   // std::atomic
+#include <chrono>   // std::chrono::steady_clock
+#include <cstdint>  // std::uint64_t
+#include <iosfwd>   // std::ostream
+#include <optional> // std::optional
+
+namespace itsp3 {
+/*!
+ * \brief Lets one thread ask searches running on other threads to stop.
+ * \note May be used from several threads at once.
+ **/
+class CancellationToken {
+public:
+  using this_type = CancellationToken;
+
+  /*!
+   * \brief Creates a CancellationToken that is not cancelled.
+   **/
+  CancellationToken() noexcept;
+
+  CancellationToken(const this_type&) = delete;
+
+  this_type& operator=(const this_type&) = delete;
+
+  /*!
+   * \brief Asks the searches observing this token to stop.
+   **/
+  void cancel() noexcept;
+
+  /*!
+   * \brief Checks whether cancel has been called.
+   * \return true if cancel has been called, otherwise false.
+   **/
+  bool isCancelled() const noexcept;
+
+private:
+  std::atomic<bool> m_isCancelled;
+};
+
+/*!
+ * \brief The reasons a search may stop before it has finished.
+ **/
+enum class StopReason {
+  Cancelled,       /*!< The CancellationToken was cancelled */
+  DeadlineReached, /*!< The deadline has passed */
+  BudgetExhausted  /*!< The budget of candidates has been used up */
+};
+
+/*!
+ * \brief Prints a StopReason.
+ * \param os The ostream to print to.
+ * \param reason The StopReason to print.
+ * \return A reference to 'os'.
+ **/
+std::ostream& operator<<(std::ostream& os, StopReason reason);
+
+/*!
+ * \brief The limits of a search, none by default.
+ **/
+struct SearchLimits {
+  using clock = std::chrono::steady_clock;
+
+  /*!
+   * \brief The CancellationToken to observe, nullptr for none. Must outlive
+   *        the search.
+   **/
+  const CancellationToken* cancellation{nullptr};
+
+  /*!
+   * \brief The point in time to stop at, nullopt for none.
+   **/
+  std::optional<clock::time_point> deadline{};
+
+  /*!
+   * \brief The maximum amount of candidates to try, nullopt for no limit.
+   **/
+  std::optional<std::uint64_t> candidateBudget{};
+};
+
+/*!
+ * \brief Enforces SearchLimits for a search that tries one candidate
+ *        after another.
+ *
+ * The budget is enforced exactly. Looking at the CancellationToken and the
+ * clock is amortized over a stride of candidates, which is doubled while
+ * the checks are less than s_targetCheckInterval apart and halved when
+ * they are more than twice that apart. So fast searches check rarely,
+ * and slow ones, such as hashing with bcrypt, check before every
+ * candidate.
+ * \note Not thread safe, every thread uses its own SearchLimiter.
+ **/
+class SearchLimiter {
+public:
+  using this_type = SearchLimiter;
+  using clock     = SearchLimits::clock;
+
+  static const clock::duration s_targetCheckInterval; /*!< 1 ms */
+
+  /*!
+   * \brief Creates a SearchLimiter.
+   * \param limits The limits to enforce.
+   **/
+  explicit SearchLimiter(const SearchLimits& limits);
+
+  /*!
+   * \brief To be called before trying a candidate.
+   * \return The reason to stop rather than trying the candidate or nullopt
+   *         if it may be tried.
+   **/
+  std::optional<StopReason> next()
+  {
+    if (m_candidateCount == m_nextCheck) {
+      return check();
+    }
+
+    ++m_candidateCount;
+    return std::nullopt;
+  }
+
+  /*!
+   * \brief Read accessor for the amount of candidates next allowed to be
+   *        tried.
+   * \return The amount of candidates.
+   **/
+  std::uint64_t getCandidateCount() const noexcept;
+
+private:
+  /*!
+   * \brief Checks the limits, see next.
+   **/
+  std::optional<StopReason> check();
+
+  const SearchLimits m_limits;
+  std::uint64_t      m_candidateCount;
+  std::uint64_t      m_nextCheck;
+  std::uint64_t      m_stride;
+  clock::time_point  m_lastCheck;
+};
+} // namespace itsp3
+#endif // INCG_ITSP3_SEARCH_LIMITS_HPP
@@ -0,0 +1,114 @@
+/*!
+ * \file target_set.hpp
+ * \brief Exports the TargetSet type used to crack the passwords of many
+ *        users with a single walk over the candidates.
+ **/
+#ifndef INCG_ITSP3_TARGET_SET_HPP
+#define INCG_ITSP3_TARGET_SET_HPP
+#include "candidate_batch.hpp" // itsp3::CandidateBatch
+#include "check_password.hpp"  // itsp3::PasswordPolicy
+#include "crack_target.hpp"    // itsp3::CrackTarget
+#include <atomic>              // std::atomic
+#include <cstddef>             // std::size_t
+#include <functional>          // std::function
+#include <memory>              // std::unique_ptr
+#include <mutex>               // std::mutex
+#include <optional>            // std::optional
+#include <string_view>         // std::string_view
+#include <vector>              // std::vector
+
+namespace itsp3 {
+/*!
+ * \brief The users whose passwords are still to be cracked.
+ *
+ * Every candidate is checked against each of the targets not yet cracked,
+ * so that the candidates only need to be generated once for all of them.
+ * Targets drop out as soon as their password is found.
+ * \note check and checkBatch may be called from several threads at once.
+ **/
+class TargetSet {
+public:
+  using this_type = TargetSet;
+
+  /*!
+   * \brief Called whenever the password of a target is found.
+   *        Calls are serialized, but may come from any thread calling check
+   *        or checkBatch.
+   **/
+  using CrackedCallback
+    = std::function<void(const CrackTarget& target, std::string_view password)>;
+
+  /*!
+   * \brief Creates a TargetSet.
+   * \param targets The targets to crack.
+   * \param onCracked Called for every target cracked.
+   * \param policy The policy the passwords of the targets satisfy,
+   *               candidates that don't are not hashed for that target,
+   *               see CrackTarget::isWorthChecking.
+   **/
+  TargetSet(
+    std::vector<CrackTarget> targets,
+    CrackedCallback          onCracked,
+    const PasswordPolicy&    policy = PasswordPolicy::none());
+
+  /*!
+   * \brief Checks a candidate against all the targets not yet cracked.
+   * \param candidate The candidate password.
+   * \return true once all the targets are cracked, otherwise false.
+   **/
+  bool check(std::string_view candidate);
+
+  /*!
+   * \brief Checks a batch of candidates against all the targets not yet
+   *        cracked, see CrackTarget::findIn.
+   * \param batch The candidates.
+   * \return nullopt while there are targets not yet cracked. Once all of
+   *         them are, the index of the last candidate in 'batch' that
+   *         cracked one of them, or 0 if none did, so that it can be
+   *         used as the batch verifier of parallelBatchBruteforce.
+   **/
+  std::optional<std::size_t> checkBatch(const CandidateBatch& batch);
+
+  /*!
+   * \brief Calculates the length of the longest candidates worth checking
+   *        against any of the targets.
+   * \return The greatest CrackTarget::getMaxPasswordLength() of the
+   *         targets, but at least the minimum length of the policy. 0 if
+   *         there are no targets.
+   * \note Candidates are only checked against the targets for which
+   *       CrackTarget::isWorthChecking returns true, so searching up to
+   *       this length finds the passwords of all the targets.
+   **/
+  std::size_t getMaxPasswordLength() const noexcept;
+
+  /*!
+   * \brief Read accessor for the targets.
+   * \return All the targets, cracked or not.
+   **/
+  const std::vector<CrackTarget>& getTargets() const noexcept;
+
+  /*!
+   * \brief Checks whether a target has been cracked.
+   * \param index The index of the target in getTargets().
+   * \return true if the password of the target was found.
+   **/
+  bool isCracked(std::size_t index) const noexcept;
+
+  /*!
+   * \brief Read accessor for the amount of targets not yet cracked.
+   * \return The amount of targets not yet cracked.
+   **/
+  std::size_t getRemainingCount() const noexcept;
+
+private:
+  std::vector<CrackTarget>             m_targets;
+  CrackedCallback                      m_onCracked;
+  PasswordPolicy                       m_policy;
+  std::unique_ptr<std::atomic<bool>[]> m_isCracked; /*!< Whether each target
+                                                     *   has been cracked.
+                                                     **/
+  std::atomic<std::size_t> m_remainingCount;
+  std::mutex               m_callbackMutex; /*!< Serializes m_onCracked */
+};
+} // namespace itsp3
+#endif // INCG_ITSP3_TARGET_SET_HPP
@@ -0,0 +1,165 @@
+/*!
+ * \file work_stealing.hpp
+ * \brief Exports the WorkStealingScheduler type that hands out chunks of a
+ *        keyspace to worker threads.
+ **/
+#ifndef INCG_ITSP3_WORK_STEALING_HPP
+#define INCG_ITSP3_WORK_STEALING_HPP
+#include "keyspace_index.hpp" // itsp3::KeyspaceIndex
+#include <chrono>             // std::chrono::steady_clock
+#include <cstddef>            // std::size_t
+#include <cstdint>            // std::uint64_t
+#include <deque>              // std::deque
+#include <memory>             // std::unique_ptr
+#include <mutex>              // std::mutex
+#include <optional>           // std::optional
+#include <vector>             // std::vector
+
+namespace itsp3 {
+/*!
+ * \brief A half open range [begin .. end) of indices into a keyspace.
+ **/
+struct KeyspaceRange {
+  KeyspaceIndex begin;
+  KeyspaceIndex end;
+};
+
+/*!
+ * \brief Hands out the indices of a keyspace in chunks.
+ * \note Thread safe.
+ *
+ * Every worker owns a deque of ranges that initially holds a contiguous
+ * share of the keyspace. Workers cut chunks off the front of their own
+ * deque. A worker whose deque ran dry steals half of the last range of
+ * another worker's deque, so that all the workers stay busy until the
+ * keyspace is exhausted.
+ **/
+class WorkStealingScheduler {
+public:
+  using this_type = WorkStealingScheduler;
+
+  /*!
+   * \brief Creates a WorkStealingScheduler.
+   * \param wordCount The amount of indices to hand out.
+   * \param workerCount The amount of workers. May not be 0.
+   **/
+  WorkStealingScheduler(KeyspaceIndex wordCount, std::size_t workerCount);
+
+  /*!
+   * \brief Creates a WorkStealingScheduler that hands out only some of the
+   *        indices of a keyspace.
+   * \param ranges The ranges of indices to hand out. Must be non-empty,
+   *               in ascending order and may not overlap.
+   * \param workerCount The amount of workers. May not be 0.
+   * \note Used to resume from a Checkpoint.
+   **/
+  WorkStealingScheduler(
+    const std::vector<KeyspaceRange>& ranges,
+    std::size_t                       workerCount);
+
+  /*!
+   * \brief Fetches the next chunk for a worker.
+   * \param worker The worker requesting a chunk, [0 .. workerCount).
+   * \param chunkSize The maximum size of the chunk. May not be 0.
+   * \return The chunk or a nullopt if there is no work left.
+   * \note Chunks handed out to a worker are owned by that worker,
+   *       they cannot be stolen.
+   **/
+  std::optional<KeyspaceRange> next(
+    std::size_t   worker,
+    std::uint64_t chunkSize);
+
+  /*!
+   * \brief Drops all the indices at or after a given index that have not
+   *        yet been handed out.
+   * \param end The index to truncate the remaining work to.
+   * \note Used to stop searching beyond a match that has been found.
+   **/
+  void truncate(KeyspaceIndex end);
+
+private:
+  /*!
+   * \brief Deque of ranges owned by a worker.
+   **/
+  struct RangeDeque {
+    std::mutex                mutex;
+    std::deque<KeyspaceRange> ranges;
+  };
+
+  /*!
+   * \brief Cuts a chunk off the front of the deque of a worker.
+   * \param worker The worker.
+   * \param chunkSize The maximum size of the chunk.
+   * \return The chunk or a nullopt if the deque is empty.
+   **/
+  std::optional<KeyspaceRange> take(
+    std::size_t   worker,
+    std::uint64_t chunkSize);
+
+  /*!
+   * \brief Steals work from the deque of a victim.
+   * \param victim The worker to steal from.
+   * \return The stolen range or a nullopt if there was nothing to steal.
+   **/
+  std::optional<KeyspaceRange> steal(std::size_t victim);
+
+  std::vector<std::unique_ptr<RangeDeque>> m_deques; /*!< Held by pointer as
+                                                      *   std::mutex is not
+                                                      *   movable.
+                                                      **/
+};
+
+/*!
+ * \brief Derives chunk sizes from the measured candidates per second of
+ *        a worker, so that every chunk takes roughly the same time.
+ * \note Not thread safe, every worker uses its own ChunkSizeTuner.
+ *
+ * Starts with chunks of a single granule, which is necessary as checking a
+ * single candidate may take a long time.
+ **/
+class ChunkSizeTuner {
+public:
+  using this_type = ChunkSizeTuner;
+  using clock     = std::chrono::steady_clock;
+
+  static const clock::duration s_defaultTargetChunkDuration; /*!< 50 ms */
+
+  /*!
+   * \brief Creates a ChunkSizeTuner.
+   * \param targetChunkDuration The duration processing a chunk should take.
+   * \param granularity The chunk sizes are multiples of this, for instance
+   *                    the amount of candidates checked at once. 0 is
+   *                    treated as 1.
+   **/
+  explicit ChunkSizeTuner(
+    clock::duration targetChunkDuration = s_defaultTargetChunkDuration,
+    std::uint64_t   granularity         = 1U);
+
+  /*!
+   * \brief Read accessor for the chunk size to use for the next chunk.
+   * \return The chunk size, a multiple of the granularity and at least
+   *         the granularity.
+   **/
+  std::uint64_t getChunkSize() const noexcept;
+
+  /*!
+   * \brief Updates the chunk size from a chunk that has been processed.
+   * \param candidateCount The amount of candidates processed.
+   * \param duration The duration it took to process them.
+   **/
+  void update(std::uint64_t candidateCount, clock::duration duration) noexcept;
+
+  /*!
+   * \brief Read accessor for the smoothed throughput measured.
+   * \return The candidates per second or 0 if nothing was measured yet.
+   **/
+  double getCandidatesPerSecond() const noexcept;
+
+private:
+  clock::duration m_targetChunkDuration;
+  std::uint64_t   m_granularity;
+  double          m_candidatesPerSecond;
+  std::uint64_t   m_chunkSize;
+};
+} // namespace itsp3
+#endif // INCG_ITSP3_WORK_STEALING_HPP
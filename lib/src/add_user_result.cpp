@@ -7,11 +7,12 @@ namespace itsp3 {
 AddUserResult::AddUserResult(PasswordCheckingResult passwordCheckingResult)
   : m_ok{passwordCheckingResult == PasswordCheckingResult::Ok}
   , m_message{asString(passwordCheckingResult)}
+  , m_warning{}
 {
 }
 
 AddUserResult::AddUserResult(Value ok, std::string message)
-  : m_ok{ok == Value::Success}, m_message{std::move(message)}
+  : m_ok{ok == Value::Success}, m_message{std::move(message)}, m_warning{}
 {
 }
 
@@ -25,6 +26,17 @@ std::string_view AddUserResult::getMessage() const noexcept
   return m_message;
 }
 
+AddUserResult& AddUserResult::setWarning(std::string warning)
+{
+  m_warning = std::move(warning);
+  return *this;
+}
+
+const std::optional<std::string>& AddUserResult::getWarning() const noexcept
+{
+  return m_warning;
+}
+
 std::ostream& operator<<(std::ostream& os, const AddUserResult& addUserResult)
 {
   return os << addUserResult.getMessage();
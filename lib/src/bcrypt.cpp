@@ -6,9 +6,14 @@
 #include "string_scrubber.hpp"           // itsp3::StringScrubber
 #include <ciso646>                       // not, or, and
 #include <iterator>                      // std::begin, std::end
+#include <memory>                        // std::make_shared, std::make_unique
+#include <mutex>                         // std::lock_guard
+#include <pl/assert.hpp>                 // PL_DBG_CHECK_PRE
 #include <pl/algo/ranged_algorithms.hpp> // pl::algo::copy
 #include <pl/print_bytes_as_hex.hpp>     // pl::print_bytes_as_hex
-#include <string>                        // std::string
+#include <string>                        // std::string, std::to_string
+#include <sys/stat.h>                    // stat
+#include <utility>                       // std::move
 
 namespace itsp3 {
 namespace {
@@ -20,11 +25,33 @@ namespace {
 constexpr const std::size_t maxSize = BCRYPT_HASHSIZE;
 } // anonymous namespace
 
-Bcrypt::Bcrypt(std::string filePath)
-  : m_filePath{std::move(filePath)}, m_salt{}, m_hash{}
+Bcrypt::Bcrypt(std::string filePath, std::size_t hashCacheByteBudget)
+  : Bcrypt{
+      std::move(filePath),
+      std::make_shared<BcryptLibraryBackend>(),
+      hashCacheByteBudget}
 {
+}
+
+Bcrypt::Bcrypt(
+  std::string                     filePath,
+  std::shared_ptr<HashingBackend> hashingBackend,
+  std::size_t                     hashCacheByteBudget)
+  : m_filePath{std::move(filePath)}
+  , m_hashingBackend{std::move(hashingBackend)}
+  , m_hashCache{hashCacheByteBudget}
+  , m_fileIdentityMutex{std::make_unique<std::mutex>()}
+  , m_fileIdentity{}
+  , m_recordIndex{nullptr}
+  , m_fileWatcher{nullptr}
+  , m_salt{}
+  , m_hash{}
+{
+  PL_DBG_CHECK_PRE(m_hashingBackend != nullptr);
+
   ITSP3_LOG << "Created Bcrypt object\n"
-            << "filepath: " << m_filePath;
+            << "filepath: " << m_filePath << '\n'
+            << "hash cache byte budget: " << hashCacheByteBudget;
 }
 
 AddUserResult Bcrypt::addUser(
@@ -75,10 +102,7 @@ AddUserResult Bcrypt::addUser(
   // note that the file stream is opened in append mode by
   // 'openFileForBinaryWriting'.
 
-  int ret // note that 'ret' is used for the error codes returned by bcrypt
-    = bcrypt_gensalt(s_defaultSaltWorkfactor, m_salt.data());
-
-  if (ret != 0) {
+  if (not m_hashingBackend->generateSalt(m_salt)) {
     ITSP3_LOG << "Failed to generate salt.";
     return AddUserResult{
       AddUserResult::Value::Failure, "Could not generate salt."};
@@ -102,10 +126,8 @@ AddUserResult Bcrypt::addUser(
             << "ASCII: "
             << PrintBytesAsAscii{hashInput.data(), hashInput.size()};
 
-  // bcrypt_hashpw expects the first argument to be a null-terminated string
-  ret = bcrypt_hashpw(hashInput.data(), m_salt.data(), m_hash.data());
-
-  if (ret != 0) {
+  // the hashing backend expects the input to be a null-terminated string
+  if (not m_hashingBackend->hash(hashInput.data(), m_salt, m_hash)) {
     ITSP3_LOG << "Failed to hash the hashInput!";
     return AddUserResult{
       AddUserResult::Value::Failure, "Could not generate hash."};
@@ -122,7 +144,23 @@ AddUserResult Bcrypt::addUser(
   const bool couldWriteData{static_cast<bool>(recordToWrite.write(fs))};
 
   if (couldWriteData) {
-    return AddUserResult{AddUserResult::Value::Success, "Success"};
+    // a freshly added user is likely to log in soon.
+    m_hashCache.insert(recordToWrite.getUsername(), recordToWrite.getHash());
+    AddUserResult result{AddUserResult::Value::Success, "Success"};
+
+    const std::size_t significantLength{
+      significantPasswordLength(username.size())};
+
+    if (password.size() > significantLength) {
+      result.setWarning(
+        "Only the first " + std::to_string(significantLength)
+        + " characters of the password are used, bcrypt ignores all but "
+          "the first "
+        + std::to_string(bcryptKeyLimit)
+        + " bytes of the username followed by the password.");
+    }
+
+    return result;
   }
 
   return AddUserResult{
@@ -165,11 +203,80 @@ bool Bcrypt::checkPasswordValidity(
             << '\n'
             << "ASCII: " << PrintBytesAsAscii{hash.data(), hash.size()};
 
-  const int ret{bcrypt_checkpw(input.data(), hash.data())};
+  // will be true if the hash input matches with the hash read from the
+  // binary file after having hashed the hash input
+  return m_hashingBackend->check(input.data(), hash.data());
+}
+
+std::optional<CrackTarget> Bcrypt::prepareCrackTarget(
+  std::string_view username)
+{
+  if (not isLengthOk(username)) {
+    return std::nullopt;
+  }
+
+  const std::optional<std::string> hashOpt{findHashOfUser(username)};
+
+  if (not hashOpt) {
+    ITSP3_LOG << "no hash found for username: \"" << username << '"';
+    return std::nullopt;
+  }
+
+  return std::make_optional<CrackTarget>(username, *hashOpt);
+}
+
+std::vector<CrackTarget> Bcrypt::prepareCrackTargets(
+  const std::function<bool(std::string_view)>& filter)
+{
+  std::vector<CrackTarget> targets{};
+  std::fstream             fs{};
+
+  if (not openFileForBinaryReading(fs, m_filePath)) {
+    ITSP3_LOG << "Failed to open file for reading, returning no targets";
+    return targets;
+  }
+
+  Record currentRecord{};
+
+  while (Record::read(fs, &currentRecord)) {
+    if (not filter or filter(currentRecord.getUsername())) {
+      targets.emplace_back(
+        currentRecord.getUsername(), currentRecord.getHash());
+    }
+  }
+
+  return targets;
+}
+
+const HashCache& Bcrypt::getHashCache() const noexcept
+{
+  return m_hashCache;
+}
+
+void Bcrypt::enableTailFollowing()
+{
+  if (m_recordIndex) {
+    return;
+  }
+
+  auto recordIndex = std::make_unique<RecordIndex>(m_filePath);
+  RecordIndex& index{*recordIndex};
+
+  // start watching before the initial refresh, so that no append can
+  // slip through in between.
+  m_fileWatcher = std::make_unique<FileWatcher>(
+    m_filePath, [&index] { index.refresh(); });
+
+  index.refresh();
+  m_recordIndex = std::move(recordIndex);
 
-  return ret == 0; // will be true if the hash input matches with the hash
-                   // read from the binary file after having hashed the
-                   // hash input
+  ITSP3_LOG << "Tail following \"" << m_filePath << "\", indexed "
+            << m_recordIndex->getRecordCount() << " records.";
+}
+
+const RecordIndex* Bcrypt::getRecordIndex() const noexcept
+{
+  return m_recordIndex.get();
 }
 
 std::optional<std::string> Bcrypt::findHashOfUser(std::string_view username)
@@ -181,6 +288,25 @@ std::optional<std::string> Bcrypt::findHashOfUser(std::string_view username)
             << pl::print_bytes_as_hex{username.data(), username.size()} << '\n'
             << "ASCII: " << PrintBytesAsAscii{username.data(), username.size()};
 
+  if (m_recordIndex) {
+    std::optional<std::string> indexedHash{m_recordIndex->find(username)};
+
+    // catch up with appends whose inotify events are still in flight.
+    if (not indexedHash and m_recordIndex->refresh() != 0U) {
+      indexedHash = m_recordIndex->find(username);
+    }
+
+    return indexedHash;
+  }
+
+  dropCachedHashesIfReplaced();
+
+  std::optional<std::string> cachedHash{m_hashCache.find(username)};
+
+  if (cachedHash) {
+    return cachedHash;
+  }
+
   if (not openFileForBinaryReading(fs, m_filePath)) {
     ITSP3_LOG << "Failed to open file for reading, returning nullopt";
     return std::nullopt;
@@ -190,6 +316,7 @@ std::optional<std::string> Bcrypt::findHashOfUser(std::string_view username)
 
   while (Record::read(fs, &currentRecord)) {
     if (currentRecord.getUsername() == username) { // it's the same username
+      m_hashCache.insert(currentRecord.getUsername(), currentRecord.getHash());
       return std::make_optional(std::string{currentRecord.getHash()});
     }
   }
@@ -199,11 +326,38 @@ std::optional<std::string> Bcrypt::findHashOfUser(std::string_view username)
   return std::nullopt; // no hash found for username given
 }
 
+void Bcrypt::dropCachedHashesIfReplaced()
+{
+  std::optional<FileIdentity> identity{};
+  struct stat                 status {
+  };
+
+  if (::stat(m_filePath.c_str(), &status) == 0) {
+    identity = FileIdentity{
+      static_cast<std::uint64_t>(status.st_dev),
+      static_cast<std::uint64_t>(status.st_ino),
+      static_cast<std::uint64_t>(status.st_size)};
+  }
+
+  const std::lock_guard<std::mutex> lock{*m_fileIdentityMutex};
+
+  // appends only ever grow the same file.
+  if (
+    m_fileIdentity
+    and (not identity or identity->device != m_fileIdentity->device
+         or identity->inode != m_fileIdentity->inode
+         or identity->size < m_fileIdentity->size)) {
+    ITSP3_LOG << "The binary file \"" << m_filePath
+              << "\" was replaced, clearing the hash cache.\n";
+    m_hashCache.clear();
+  }
+
+  m_fileIdentity = identity;
+}
+
 bool Bcrypt::isLengthOk(std::string_view str) noexcept
 {
   // usernames and paswords shall not be larger than 'maxSize'
   return str.size() <= maxSize;
 }
-
-const int Bcrypt::s_defaultSaltWorkfactor = 12;
 } // namespace itsp3
@@ -0,0 +1,638 @@
+#include "bcrypt_kernel.hpp"
+#include <algorithm>     // std::min
+#include <ciso646>       // not, and, or
+#include <cstring>       // std::memcpy
+#include <ostream>       // std::ostream
+#include <pl/assert.hpp> // PL_DBG_CHECK_PRE
+
+namespace itsp3 {
+namespace {
+/*!
+ * \brief The characters of the base64 variant used by bcrypt.
+ **/
+constexpr char base64Characters[]{
+  "./ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789"};
+
+/*!
+ * \brief The length of a setting such as "$2a$12$R9h/cIPz0gi.URNNX3kh2O".
+ **/
+constexpr std::size_t settingLength{29U};
+
+/*!
+ * \brief "OrpheanBeholderScryDoubt" as big endian words, the plaintext
+ *        that is encrypted to create the digest.
+ **/
+constexpr std::uint32_t magicWords[6]{
+  0x4F727068U, 0x65616E42U, 0x65686F6CU, 0x64657253U, 0x63727944U, 0x6F756274U};
+
+/*!
+ * \brief The length of a complete hash, the setting followed by the 31
+ *        characters of the digest.
+ **/
+constexpr std::size_t hashLength{settingLength + 31U};
+
+/*!
+ * \brief The Blowfish state of one hash.
+ **/
+struct BlowfishState {
+  std::uint32_t p[18];
+  std::uint32_t s[1024];
+};
+
+/*!
+ * \brief Module local function to decode a character of the base64
+ *        variant used by bcrypt.
+ * \param c The character to decode.
+ * \return The 6 bits 'c' encodes or -1 if it is not a base64 character.
+ **/
+int decodeBase64Character(char c) noexcept
+{
+  for (int i{0}; i < 64; ++i) {
+    if (base64Characters[i] == c) {
+      return i;
+    }
+  }
+
+  return -1;
+}
+
+/*!
+ * \brief Module local function to decode bytes encoded with the base64
+ *        variant used by bcrypt.
+ * \param text The characters to decode, at least 4 / 3 of 'size'
+ *             rounded up.
+ * \param size The amount of bytes to decode.
+ * \param out The buffer to write the 'size' bytes to.
+ * \return false if 'text' contains a character that is not a base64
+ *         character, otherwise true.
+ * \note The unused low bits of the last character are ignored.
+ **/
+bool decodeBase64(const char* text, std::size_t size, std::uint8_t* out)
+{
+  int sextets[4];
+
+  // 4 characters encode 3 bytes, the last 2 or 3 characters encode the
+  // remaining 1 or 2 bytes.
+  for (std::size_t byte{0U}; byte < size; text += 4U) {
+    const std::size_t characterCount{std::min<std::size_t>(
+      4U, (size - byte) * 4U / 3U + 1U)};
+
+    for (std::size_t i{0U}; i < characterCount; ++i) {
+      sextets[i] = decodeBase64Character(text[i]);
+
+      if (sextets[i] < 0) {
+        return false;
+      }
+    }
+
+    out[byte++]
+      = static_cast<std::uint8_t>((sextets[0U] << 2) | (sextets[1U] >> 4));
+
+    if (byte == size) {
+      break;
+    }
+
+    out[byte++] = static_cast<std::uint8_t>(
+      ((sextets[1U] & 0x0F) << 4) | (sextets[2U] >> 2));
+
+    if (byte == size) {
+      break;
+    }
+
+    out[byte++]
+      = static_cast<std::uint8_t>(((sextets[2U] & 0x03) << 6) | sextets[3U]);
+  }
+
+  return true;
+}
+
+/*!
+ * \brief Module local function to encode bytes with the base64 variant
+ *        used by bcrypt.
+ * \param data The bytes to encode.
+ * \param size The amount of bytes to encode.
+ * \param out The string to append the characters to.
+ **/
+void encodeBase64(const std::uint8_t* data, std::size_t size, std::string& out)
+{
+  for (std::size_t i{0U}; i < size; i += 3U) {
+    const unsigned c1{data[i]};
+    out += base64Characters[c1 >> 2U];
+
+    if (i + 1U == size) {
+      out += base64Characters[(c1 & 0x03U) << 4U];
+      break;
+    }
+
+    const unsigned c2{data[i + 1U]};
+    out += base64Characters[((c1 & 0x03U) << 4U) | (c2 >> 4U)];
+
+    if (i + 2U == size) {
+      out += base64Characters[(c2 & 0x0FU) << 2U];
+      break;
+    }
+
+    const unsigned c3{data[i + 2U]};
+    out += base64Characters[((c2 & 0x0FU) << 2U) | (c3 >> 6U)];
+    out += base64Characters[c3 & 0x3FU];
+  }
+}
+
+/*!
+ * \brief Module local function to convert the salt to the words used by
+ *        Blowfish.
+ * \param salt The salt.
+ * \param words The buffer to write the 4 big endian words to.
+ **/
+void saltToWords(const BcryptSalt& salt, std::uint32_t* words) noexcept
+{
+  for (std::size_t i{0U}; i < 4U; ++i) {
+    words[i] = (std::uint32_t{salt[4U * i]} << 24U)
+               | (std::uint32_t{salt[4U * i + 1U]} << 16U)
+               | (std::uint32_t{salt[4U * i + 2U]} << 8U)
+               | std::uint32_t{salt[4U * i + 3U]};
+  }
+}
+
+/*!
+ * \brief Module local function to cycle a key to the 18 words XORed into
+ *        the P-array.
+ * \param key The key, ends at the first null character.
+ * \param minor The minor version of bcrypt.
+ * \param expandedKey The buffer to write the 18 words of the key to.
+ * \param initialP The buffer to write the initial P-array XORed with the
+ *                 key to.
+ *
+ * Follows the bcrypt library: "$2x$" reproduces the sign extension bug of
+ * old versions for bytes >= 0x80, "$2a$" flips a bit of the P-array for
+ * the keys that bug would have hashed to the same value as the correct
+ * code, so that such hashes can't be confused.
+ **/
+void expandKey(
+  std::string_view key,
+  char             minor,
+  std::uint32_t*   expandedKey,
+  std::uint32_t*   initialP) noexcept
+{
+  key = key.substr(0U, key.find('\0'));
+
+  const bool          isBuggy{minor == 'x'};
+  const std::uint32_t safety{minor == 'a' ? 0x10000U : 0U};
+  std::uint32_t       sign{0U};
+  std::uint32_t       difference{0U};
+
+  // key.size() is the position of the terminating null character.
+  std::size_t position{0U};
+
+  for (std::size_t i{0U}; i < 18U; ++i) {
+    std::uint32_t correct{0U};
+    std::uint32_t buggy{0U};
+
+    for (std::size_t j{0U}; j < 4U; ++j) {
+      const char c{position < key.size() ? key[position] : '\0'};
+      correct = (correct << 8U) | static_cast<unsigned char>(c);
+      buggy   = (buggy << 8U)
+              | static_cast<std::uint32_t>(static_cast<signed char>(c));
+
+      if (j != 0U) {
+        sign |= buggy & 0x80U;
+      }
+
+      position = position == key.size() ? 0U : position + 1U;
+    }
+
+    difference |= correct ^ buggy;
+    expandedKey[i] = isBuggy ? buggy : correct;
+    initialP[i]    = detail::blowfishInitialP[i] ^ expandedKey[i];
+  }
+
+  // bit 16 is set if the correct and the buggy code differ.
+  difference |= difference >> 16U;
+  difference &= 0xFFFFU;
+  difference += 0xFFFFU;
+  sign <<= 9U;
+  sign &= ~difference & safety;
+
+  initialP[0U] ^= sign;
+}
+
+/*!
+ * \brief Module local function to encrypt a block with Blowfish.
+ * \param state The state to encrypt with.
+ * \param l The left half of the block.
+ * \param r The right half of the block.
+ **/
+inline void encrypt(
+  const BlowfishState& state,
+  std::uint32_t&       l,
+  std::uint32_t&       r) noexcept
+{
+  const auto f = [&state](std::uint32_t x) {
+    return ((state.s[x >> 24U] + state.s[0x100U + ((x >> 16U) & 0xFFU)])
+            ^ state.s[0x200U + ((x >> 8U) & 0xFFU)])
+           + state.s[0x300U + (x & 0xFFU)];
+  };
+
+  l ^= state.p[0U];
+
+  for (std::size_t i{1U}; i < 17U; i += 2U) {
+    r ^= f(l) ^ state.p[i];
+    l ^= f(r) ^ state.p[i + 1U];
+  }
+
+  const std::uint32_t tmp{r};
+  r = l;
+  l = tmp ^ state.p[17U];
+}
+
+/*!
+ * \brief Module local function to encrypt the P-array and S-boxes with
+ *        themselves, XORing in the salt words given between the blocks.
+ * \param state The state.
+ * \param salt The salt words or nullptr for none.
+ **/
+void expandState(BlowfishState& state, const std::uint32_t* salt) noexcept
+{
+  std::uint32_t l{0U};
+  std::uint32_t r{0U};
+  std::size_t   saltIndex{0U};
+
+  const auto encryptBlock = [&](std::uint32_t* out) {
+    if (salt != nullptr) {
+      l ^= salt[saltIndex];
+      r ^= salt[saltIndex + 1U];
+      saltIndex ^= 2U;
+    }
+
+    encrypt(state, l, r);
+    out[0U] = l;
+    out[1U] = r;
+  };
+
+  for (std::size_t i{0U}; i < 18U; i += 2U) {
+    encryptBlock(&state.p[i]);
+  }
+
+  for (std::size_t i{0U}; i < 1024U; i += 2U) {
+    encryptBlock(&state.s[i]);
+  }
+}
+
+/*!
+ * \brief Module local function to extract the digest of a lane.
+ * \param output The ciphertext words of all the lanes.
+ * \param lanes The amount of lanes.
+ * \param lane The lane.
+ * \return The digest.
+ **/
+BcryptDigest toDigest(
+  const std::uint32_t* output,
+  std::size_t          lanes,
+  std::size_t          lane) noexcept
+{
+  std::uint8_t bytes[24];
+
+  for (std::size_t i{0U}; i < 6U; ++i) {
+    const std::uint32_t word{output[i * lanes + lane]};
+    bytes[4U * i]      = static_cast<std::uint8_t>(word >> 24U);
+    bytes[4U * i + 1U] = static_cast<std::uint8_t>(word >> 16U);
+    bytes[4U * i + 2U] = static_cast<std::uint8_t>(word >> 8U);
+    bytes[4U * i + 3U] = static_cast<std::uint8_t>(word);
+  }
+
+  BcryptDigest digest;
+  std::memcpy(digest.data(), bytes, digest.size());
+  return digest;
+}
+
+/*!
+ * \brief Module local function to compare two digests in constant time.
+ * \param a The first digest.
+ * \param b The second digest.
+ * \return true if 'a' and 'b' are equal, otherwise false.
+ * \note Always looks at all the bytes, so that the time taken does not
+ *       tell how many of the leading bytes matched.
+ **/
+bool constantTimeEquals(const BcryptDigest& a, const BcryptDigest& b) noexcept
+{
+  volatile std::uint8_t difference{0U};
+
+  for (std::size_t i{0U}; i < a.size(); ++i) {
+    difference = difference | static_cast<std::uint8_t>(a[i] ^ b[i]);
+  }
+
+  return difference == 0U;
+}
+
+/*!
+ * \brief Module local function to fetch the kernel of an instruction set.
+ * \param isa The instruction set, may not be BcryptIsa::Scalar.
+ * \return The kernel.
+ **/
+auto kernelOf(BcryptIsa isa) noexcept
+{
+  switch (isa) {
+  case BcryptIsa::Sse41:
+    return &detail::bcryptLanesSse41;
+  case BcryptIsa::Avx2:
+    return &detail::bcryptLanesAvx2;
+  default:
+    return &detail::bcryptLanesAvx512;
+  }
+}
+
+/*!
+ * \brief Module local function to fetch the next narrower instruction set.
+ * \param isa The instruction set, may not be BcryptIsa::Scalar.
+ * \return The instruction set with half the lanes of 'isa'.
+ **/
+BcryptIsa narrowerIsa(BcryptIsa isa) noexcept
+{
+  return static_cast<BcryptIsa>(static_cast<int>(isa) - 1);
+}
+} // anonymous namespace
+
+BcryptSetting BcryptSetting::parse(std::string_view hash)
+{
+  const auto fail = [](const char* reason) {
+    PL_THROW_WITH_SOURCE_INFO(
+      BcryptSettingException, std::string{"Invalid bcrypt setting: "} + reason);
+  };
+
+  if (hash.size() < settingLength) {
+    fail("too short");
+  }
+
+  BcryptSetting setting{};
+  setting.minor = hash[2U];
+
+  if (
+    hash[0U] != '$' or hash[1U] != '2'
+    or (setting.minor != 'a' and setting.minor != 'b' and setting.minor != 'x'
+        and setting.minor != 'y')
+    or hash[3U] != '$' or hash[6U] != '$') {
+    fail("not a bcrypt hash");
+  }
+
+  if (
+    hash[4U] < '0' or hash[4U] > '9' or hash[5U] < '0' or hash[5U] > '9') {
+    fail("invalid cost");
+  }
+
+  setting.cost = (hash[4U] - '0') * 10 + (hash[5U] - '0');
+
+  if (setting.cost < 4 or setting.cost > 31) {
+    fail("invalid cost");
+  }
+
+  if (not decodeBase64(
+        &hash[7U], setting.salt.size(), setting.salt.data())) {
+    fail("invalid salt");
+  }
+
+  return setting;
+}
+
+BcryptHash BcryptHash::parse(std::string_view hash)
+{
+  if (hash.size() != hashLength) {
+    PL_THROW_WITH_SOURCE_INFO(
+      BcryptSettingException, "Invalid bcrypt hash: invalid length");
+  }
+
+  BcryptHash result{};
+  result.setting = BcryptSetting::parse(hash);
+
+  if (not decodeBase64(
+        &hash[settingLength], result.digest.size(), result.digest.data())) {
+    PL_THROW_WITH_SOURCE_INFO(
+      BcryptSettingException, "Invalid bcrypt hash: invalid digest");
+  }
+
+  // the bcrypt library compares the strings, so a hash whose unused bits
+  // are set never matches any key.
+  if (formatBcryptHash(result.setting, result.digest) != hash) {
+    PL_THROW_WITH_SOURCE_INFO(
+      BcryptSettingException, "Invalid bcrypt hash: non-canonical encoding");
+  }
+
+  return result;
+}
+
+std::ostream& operator<<(std::ostream& os, BcryptIsa isa)
+{
+  switch (isa) {
+  case BcryptIsa::Scalar:
+    return os << "scalar";
+  case BcryptIsa::Sse41:
+    return os << "SSE4.1";
+  case BcryptIsa::Avx2:
+    return os << "AVX2";
+  case BcryptIsa::Avx512:
+    return os << "AVX-512";
+  }
+
+  return os << "invalid BcryptIsa";
+}
+
+std::size_t laneCount(BcryptIsa isa) noexcept
+{
+  switch (isa) {
+  case BcryptIsa::Sse41:
+    return 4U;
+  case BcryptIsa::Avx2:
+    return 8U;
+  case BcryptIsa::Avx512:
+    return bcryptMaxLaneCount;
+  default:
+    return 1U;
+  }
+}
+
+bool isSupported(BcryptIsa isa) noexcept
+{
+#if defined(__x86_64__) || defined(__i386__)
+  switch (isa) {
+  case BcryptIsa::Scalar:
+    return true;
+  case BcryptIsa::Sse41:
+    return __builtin_cpu_supports("sse4.1");
+  case BcryptIsa::Avx2:
+    return __builtin_cpu_supports("avx2");
+  case BcryptIsa::Avx512:
+    return __builtin_cpu_supports("avx512f");
+  }
+
+  return false;
+#else
+  return isa == BcryptIsa::Scalar;
+#endif
+}
+
+BcryptIsa bestBcryptIsa() noexcept
+{
+  for (BcryptIsa isa : {BcryptIsa::Avx512, BcryptIsa::Avx2, BcryptIsa::Sse41}) {
+    if (isSupported(isa)) {
+      return isa;
+    }
+  }
+
+  return BcryptIsa::Scalar;
+}
+
+BcryptDigest bcryptHash(std::string_view key, const BcryptSetting& setting)
+{
+  std::uint32_t salt[4];
+  std::uint32_t expandedKey[18];
+  BlowfishState state;
+
+  saltToWords(setting.salt, salt);
+  expandKey(key, setting.minor, expandedKey, state.p);
+  std::memcpy(state.s, detail::blowfishInitialS, sizeof(state.s));
+
+  expandState(state, salt);
+
+  for (std::uint64_t round{0U}; round < (std::uint64_t{1U} << setting.cost);
+       ++round) {
+    for (std::size_t i{0U}; i < 18U; ++i) {
+      state.p[i] ^= expandedKey[i];
+    }
+
+    expandState(state, nullptr);
+
+    for (std::size_t i{0U}; i < 18U; ++i) {
+      state.p[i] ^= salt[i & 3U];
+    }
+
+    expandState(state, nullptr);
+  }
+
+  std::uint32_t output[6];
+
+  for (std::size_t i{0U}; i < 6U; i += 2U) {
+    std::uint32_t l{magicWords[i]};
+    std::uint32_t r{magicWords[i + 1U]};
+
+    for (int j{0}; j < 64; ++j) {
+      encrypt(state, l, r);
+    }
+
+    output[i]      = l;
+    output[i + 1U] = r;
+  }
+
+  return toDigest(output, 1U, 0U);
+}
+
+bool bcryptVerify(std::string_view key, const BcryptHash& hash)
+{
+  return constantTimeEquals(bcryptHash(key, hash.setting), hash.digest);
+}
+
+void bcryptHashBatch(
+  const std::string_view* keys,
+  std::size_t             count,
+  const BcryptSetting&    setting,
+  BcryptDigest*           digests,
+  BcryptIsa               isa)
+{
+  PL_DBG_CHECK_PRE(isSupported(isa));
+
+  std::uint32_t salt[4];
+  std::uint32_t initialP[18U * bcryptMaxLaneCount];
+  std::uint32_t expandedKey[18U * bcryptMaxLaneCount];
+  std::uint32_t output[6U * bcryptMaxLaneCount];
+  std::uint32_t laneInitialP[18];
+  std::uint32_t laneExpandedKey[18];
+
+  saltToWords(setting.salt, salt);
+
+  for (std::size_t first{0U}; first < count;) {
+    const std::size_t remaining{count - first};
+
+    // don't leave most of the lanes idle for the last few keys.
+    while (isa != BcryptIsa::Scalar and remaining <= laneCount(isa) / 2U) {
+      isa = narrowerIsa(isa);
+    }
+
+    if (isa == BcryptIsa::Scalar) {
+      digests[first] = bcryptHash(keys[first], setting);
+      ++first;
+      continue;
+    }
+
+    const std::size_t lanes{laneCount(isa)};
+
+    for (std::size_t lane{0U}; lane < lanes; ++lane) {
+      // idle lanes repeat the last key.
+      expandKey(
+        keys[first + std::min(lane, remaining - 1U)],
+        setting.minor,
+        laneExpandedKey,
+        laneInitialP);
+
+      for (std::size_t i{0U}; i < 18U; ++i) {
+        initialP[i * lanes + lane]    = laneInitialP[i];
+        expandedKey[i * lanes + lane] = laneExpandedKey[i];
+      }
+    }
+
+    kernelOf(isa)(initialP, expandedKey, salt, setting.cost, output);
+
+    for (std::size_t lane{0U}; lane < std::min(lanes, remaining); ++lane) {
+      digests[first + lane] = toDigest(output, lanes, lane);
+    }
+
+    first += std::min(lanes, remaining);
+  }
+}
+
+std::optional<std::size_t> bcryptVerifyBatch(
+  const std::string_view* keys,
+  std::size_t             count,
+  const BcryptHash&       hash,
+  BcryptIsa               isa)
+{
+  BcryptDigest digests[bcryptMaxLaneCount];
+
+  // in groups of the widest lane count, so that the digests fit on the
+  // stack.
+  for (std::size_t first{0U}; first < count; first += bcryptMaxLaneCount) {
+    const std::size_t groupSize{
+      std::min(bcryptMaxLaneCount, count - first)};
+    bcryptHashBatch(&keys[first], groupSize, hash.setting, digests, isa);
+
+    // every digest of the group is compared, so that the time taken does
+    // not depend on which lane matched.
+    std::optional<std::size_t> match{};
+
+    for (std::size_t i{0U}; i < groupSize; ++i) {
+      if (constantTimeEquals(digests[i], hash.digest) and not match) {
+        match = first + i;
+      }
+    }
+
+    // the later groups could only hold later matches.
+    if (match) {
+      return match;
+    }
+  }
+
+  return std::nullopt;
+}
+
+std::string formatBcryptHash(
+  const BcryptSetting& setting,
+  const BcryptDigest&  digest)
+{
+  std::string hash{"$2"};
+  hash += setting.minor;
+  hash += '$';
+  hash += static_cast<char>('0' + setting.cost / 10);
+  hash += static_cast<char>('0' + setting.cost % 10);
+  hash += '$';
+  encodeBase64(setting.salt.data(), setting.salt.size(), hash);
+  encodeBase64(digest.data(), digest.size(), hash);
+  return hash;
+}
+} // namespace itsp3
@@ -0,0 +1,64 @@
+#include "bcrypt_kernel.hpp"
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t
+#include <cstdlib> // std::abort
+#include <cstring> // std::memcpy
+
+#if defined(__x86_64__) || defined(__i386__)
+// everything from here on may use AVX2, the headers above must not.
+#pragma GCC target("avx2")
+#include "bcrypt_lanes.hpp" // itsp3::BlowfishLanes
+#include <immintrin.h>      // _mm256_i32gather_epi32
+
+namespace itsp3 {
+namespace {
+/*!
+ * \brief The traits of BlowfishLanes for AVX2.
+ **/
+struct Avx2Traits {
+  using Vector = std::uint32_t __attribute__((vector_size(32)));
+
+  static constexpr std::size_t s_laneCount{8U};
+
+  /*!
+   * \brief Looks up words.
+   * \param base The words.
+   * \param indices The indices of the words to look up.
+   * \return The words.
+   **/
+  static Vector gather(const std::uint32_t* base, Vector indices) noexcept
+  {
+    return (Vector)_mm256_i32gather_epi32(
+      reinterpret_cast<const int*>(base), (__m256i)indices, 4);
+  }
+};
+} // anonymous namespace
+
+namespace detail {
+void bcryptLanesAvx2(
+  const std::uint32_t* initialP,
+  const std::uint32_t* expandedKey,
+  const std::uint32_t* salt,
+  int                  cost,
+  std::uint32_t*       output)
+{
+  BlowfishLanes<Avx2Traits>::run(initialP, expandedKey, salt, cost, output);
+}
+} // namespace detail
+} // namespace itsp3
+#else
+namespace itsp3 {
+namespace detail {
+void bcryptLanesAvx2(
+  const std::uint32_t*,
+  const std::uint32_t*,
+  const std::uint32_t*,
+  int,
+  std::uint32_t*)
+{
+  // unreachable, as isSupported(BcryptIsa::Avx2) is false.
+  std::abort();
+}
+} // namespace detail
+} // namespace itsp3
+#endif
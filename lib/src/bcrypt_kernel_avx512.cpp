@@ -0,0 +1,65 @@
+#include "bcrypt_kernel.hpp"
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t
+#include <cstdlib> // std::abort
+#include <cstring> // std::memcpy
+
+#if defined(__x86_64__) || defined(__i386__)
+// everything from here on may use AVX-512F, the headers above must not.
+#pragma GCC target("avx512f")
+#include "bcrypt_lanes.hpp" // itsp3::BlowfishLanes
+#include <immintrin.h>      // _mm512_mask_i32gather_epi32
+
+namespace itsp3 {
+namespace {
+/*!
+ * \brief The traits of BlowfishLanes for AVX-512F.
+ **/
+struct Avx512Traits {
+  using Vector = std::uint32_t __attribute__((vector_size(64)));
+
+  static constexpr std::size_t s_laneCount{16U};
+
+  /*!
+   * \brief Looks up words.
+   * \param base The words.
+   * \param indices The indices of the words to look up.
+   * \return The words.
+   **/
+  static Vector gather(const std::uint32_t* base, Vector indices) noexcept
+  {
+    // the unmasked variant trips -Wuninitialized in the headers of GCC 12.
+    return (Vector)_mm512_mask_i32gather_epi32(
+      _mm512_setzero_si512(), 0xFFFF, (__m512i)indices, base, 4);
+  }
+};
+} // anonymous namespace
+
+namespace detail {
+void bcryptLanesAvx512(
+  const std::uint32_t* initialP,
+  const std::uint32_t* expandedKey,
+  const std::uint32_t* salt,
+  int                  cost,
+  std::uint32_t*       output)
+{
+  BlowfishLanes<Avx512Traits>::run(initialP, expandedKey, salt, cost, output);
+}
+} // namespace detail
+} // namespace itsp3
+#else
+namespace itsp3 {
+namespace detail {
+void bcryptLanesAvx512(
+  const std::uint32_t*,
+  const std::uint32_t*,
+  const std::uint32_t*,
+  int,
+  std::uint32_t*)
+{
+  // unreachable, as isSupported(BcryptIsa::Avx512) is false.
+  std::abort();
+}
+} // namespace detail
+} // namespace itsp3
+#endif
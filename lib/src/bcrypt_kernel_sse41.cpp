@@ -0,0 +1,63 @@
+#include "bcrypt_kernel.hpp"
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t
+#include <cstdlib> // std::abort
+#include <cstring> // std::memcpy
+
+#if defined(__x86_64__) || defined(__i386__)
+// everything from here on may use SSE4.1, the headers above must not.
+#pragma GCC target("sse4.1")
+#include "bcrypt_lanes.hpp" // itsp3::BlowfishLanes
+
+namespace itsp3 {
+namespace {
+/*!
+ * \brief The traits of BlowfishLanes for SSE4.1.
+ **/
+struct Sse41Traits {
+  using Vector = std::uint32_t __attribute__((vector_size(16)));
+
+  static constexpr std::size_t s_laneCount{4U};
+
+  /*!
+   * \brief Looks up words, one after another as SSE4.1 can't gather.
+   * \param base The words.
+   * \param indices The indices of the words to look up.
+   * \return The words.
+   **/
+  static Vector gather(const std::uint32_t* base, Vector indices) noexcept
+  {
+    return Vector{
+      base[indices[0]], base[indices[1]], base[indices[2]], base[indices[3]]};
+  }
+};
+} // anonymous namespace
+
+namespace detail {
+void bcryptLanesSse41(
+  const std::uint32_t* initialP,
+  const std::uint32_t* expandedKey,
+  const std::uint32_t* salt,
+  int                  cost,
+  std::uint32_t*       output)
+{
+  BlowfishLanes<Sse41Traits>::run(initialP, expandedKey, salt, cost, output);
+}
+} // namespace detail
+} // namespace itsp3
+#else
+namespace itsp3 {
+namespace detail {
+void bcryptLanesSse41(
+  const std::uint32_t*,
+  const std::uint32_t*,
+  const std::uint32_t*,
+  int,
+  std::uint32_t*)
+{
+  // unreachable, as isSupported(BcryptIsa::Sse41) is false.
+  std::abort();
+}
+} // namespace detail
+} // namespace itsp3
+#endif
@@ -0,0 +1,70 @@
+#include "bruteforce.hpp"
+#include <sstream> // std::ostringstream
+
+namespace itsp3 {
+namespace {
+/*!
+ * \brief Module local function to create the message of a
+ *        KeyspaceExhaustedException.
+ * \param minLength The minimum word length searched.
+ * \param maxLength The maximum word length searched.
+ * \param candidateCount The amount of words that were tried.
+ * \param duration The duration the search took.
+ * \return The message.
+ **/
+std::string createMessage(
+  std::size_t                                 minLength,
+  std::size_t                                 maxLength,
+  std::uint64_t                               candidateCount,
+  KeyspaceExhaustedException::clock::duration duration)
+{
+  const double seconds{std::chrono::duration<double>{duration}.count()};
+
+  std::ostringstream oss{};
+  oss << "Bruteforce algorithm found no match: tried " << candidateCount
+      << " candidates of lengths " << minLength << " to " << maxLength
+      << " in " << seconds << " seconds";
+
+  if (seconds > 0.0) {
+    oss << " (" << static_cast<double>(candidateCount) / seconds
+        << " candidates per second)";
+  }
+
+  return oss.str();
+}
+} // anonymous namespace
+
+KeyspaceExhaustedException::KeyspaceExhaustedException(
+  std::size_t     minLength,
+  std::size_t     maxLength,
+  std::uint64_t   candidateCount,
+  clock::duration duration)
+  : base_type{createMessage(minLength, maxLength, candidateCount, duration)}
+  , m_minLength{minLength}
+  , m_maxLength{maxLength}
+  , m_candidateCount{candidateCount}
+  , m_duration{duration}
+{
+}
+
+std::size_t KeyspaceExhaustedException::getMinLength() const noexcept
+{
+  return m_minLength;
+}
+
+std::size_t KeyspaceExhaustedException::getMaxLength() const noexcept
+{
+  return m_maxLength;
+}
+
+std::uint64_t KeyspaceExhaustedException::getCandidateCount() const noexcept
+{
+  return m_candidateCount;
+}
+
+KeyspaceExhaustedException::clock::duration KeyspaceExhaustedException::
+  getDuration() const noexcept
+{
+  return m_duration;
+}
+} // namespace itsp3
@@ -0,0 +1,115 @@
+#include "candidate_batch.hpp"
+#include <algorithm>     // std::max
+#include <ciso646>       // not, and
+#include <cstring>       // std::memcpy
+#include <pl/assert.hpp> // PL_DBG_CHECK_PRE
+
+namespace itsp3 {
+CandidateBatch::CandidateBatch(std::size_t capacity, std::size_t maxLength)
+  : m_maxLength{maxLength}
+  , m_buffer(std::max<std::size_t>(capacity, 1U) * maxLength)
+  , m_views(std::max<std::size_t>(capacity, 1U))
+  , m_size{0U}
+{
+}
+
+std::size_t CandidateBatch::getCapacity() const noexcept
+{
+  return m_views.size();
+}
+
+std::size_t CandidateBatch::getMaxLength() const noexcept
+{
+  return m_maxLength;
+}
+
+std::size_t CandidateBatch::size() const noexcept
+{
+  return m_size;
+}
+
+bool CandidateBatch::empty() const noexcept
+{
+  return m_size == 0U;
+}
+
+bool CandidateBatch::isFull() const noexcept
+{
+  return m_size == m_views.size();
+}
+
+void CandidateBatch::clear() noexcept
+{
+  m_size = 0U;
+}
+
+bool CandidateBatch::push(std::string_view candidate) noexcept
+{
+  PL_DBG_CHECK_PRE(not isFull());
+
+  if (candidate.size() > m_maxLength) {
+    return false;
+  }
+
+  char* const destination{m_buffer.data() + m_size * m_maxLength};
+
+  // memcpy must not be given nullptr, which data() of an empty view may be.
+  if (not candidate.empty()) {
+    std::memcpy(destination, candidate.data(), candidate.size());
+  }
+
+  m_views[m_size] = std::string_view{destination, candidate.size()};
+  ++m_size;
+  return true;
+}
+
+std::string_view CandidateBatch::operator[](std::size_t index) const noexcept
+{
+  PL_DBG_CHECK_PRE(index < m_size);
+  return m_views[index];
+}
+
+const std::string_view* CandidateBatch::data() const noexcept
+{
+  return m_views.data();
+}
+
+const std::string_view* CandidateBatch::begin() const noexcept
+{
+  return m_views.data();
+}
+
+const std::string_view* CandidateBatch::end() const noexcept
+{
+  return m_views.data() + m_size;
+}
+
+WordlistSource::WordlistSource(std::string_view wordlist) noexcept
+  : m_wordlist{wordlist}, m_offset{0U}
+{
+}
+
+bool WordlistSource::next(CandidateBatch& batch)
+{
+  batch.clear();
+
+  while (m_offset < m_wordlist.size() and not batch.isFull()) {
+    const std::size_t newline{m_wordlist.find('\n', m_offset)};
+    const std::size_t lineEnd{
+      newline == std::string_view::npos ? m_wordlist.size() : newline};
+    std::string_view word{m_wordlist.substr(m_offset, lineEnd - m_offset)};
+    m_offset = lineEnd + 1U;
+
+    if (not word.empty() and word.back() == '\r') {
+      word.remove_suffix(1U);
+    }
+
+    // empty lines are skipped, too long words are rejected by push.
+    if (not word.empty()) {
+      batch.push(word);
+    }
+  }
+
+  return not batch.empty();
+}
+} // namespace itsp3
@@ -1,7 +1,7 @@
 #include "check_password.hpp"
-#include "alphabets.hpp"                 // itsp3::makeAlphabet
+#include "alphabets.hpp"                 // itsp3::lowerCaseCharacterSet, ...
 #include "log.hpp"                       // ITSP3_LOG
-#include <ciso646>                       // not
+#include <ciso646>                       // not, and, or
 #include <cstddef>                       // std::size_t
 #include <ostream>                       // std::ostream
 #include <pl/algo/ranged_algorithms.hpp> // pl::algo::any_of
@@ -10,127 +10,6 @@
 
 namespace itsp3 {
 namespace {
-/*!
- * All the lower case character. (Assuming ASCII implementation).
- * '{' is the character after 'z'. (Note the use of half open ranges typical
- * in C++).
- * See an ASCII chart for reference at:
- * http://en.cppreference.com/w/cpp/language/ascii
- **/
-constexpr std::array<char, '{' - 'a'> lowerCaseCharacters
-  = makeAlphabet<'a', '{'>();
-
-/*!
- * The upper case characters.
- **/
-constexpr std::array<char, '[' - 'A'> upperCaseCharacters
-  = makeAlphabet<'A', '['>();
-
-/*!
- * The numbers '0' - '9' as chars.
- **/
-constexpr std::array<char, ':' - '0'> numbers = makeAlphabet<'0', ':'>();
-
-/*!
- * The 'special' characters.
- * pl::cont::make_array is used to deduce the size of the std::array
- **/
-constexpr auto specialCharacters = ::pl::cont::make_array(
-  ' ',
-  '!',
-  '"',
-  '#',
-  '$',
-  '%',
-  '&',
-  '\'',
-  '(',
-  ')',
-  '*',
-  '+',
-  ',',
-  '-',
-  '.',
-  '/',
-  ':',
-  ';',
-  '<',
-  '=',
-  '>',
-  '?',
-  '@',
-  '[',
-  '\\',
-  ']',
-  '^',
-  '_',
-  '`',
-  '{',
-  '|',
-  '}',
-  '~');
-
-/*!
- * \brief Module local function to check if 'c' is a lower case character.
- * \param c The character to check.
- * \return true if 'c' is considered a lower case character, otherwise false.
- * \note These function are used in place of the (C) functions exported by the
- *       <cctype> header, as those include some (stupid) assertions on some
- *       implementations if the character supplied is outside of the range
- *       of ASCII characters 0x00 through 0x7F (both inclusive) as chars
- *       being byte sized object can hold values of the range 0x00 through
- *       0xFF (both inclusive) (assuming CHAR_BIT == 8, that is bytes being
- *       8 bit large). These funny assertion cause the application to crash
- *       on bad input, which is just ridiculous.
- **/
-bool isLowerCase(char c) noexcept
-{
-  return pl::algo::any_of(lowerCaseCharacters, [c](char lowerCaseChar) {
-    return lowerCaseChar == c;
-  });
-}
-
-/*!
- * \brief Module local function to check if 'c' is an upper case character.
- * \param c The character to check.
- * \return true if 'c' is an upper case character, false otherwise.
- **/
-bool isUpperCase(char c) noexcept
-{
-  return pl::algo::any_of(upperCaseCharacters, [c](char upperCaseChar) {
-    return upperCaseChar == c;
-  });
-}
-
-/*!
- * \brief Module local function to check if 'c' is a 'number' that is
- *        'c' compares equal to '0', '1', '2', '3', '4', '5', '6', '7',
- *        '8', or '9'.
- * \param c The characeter to check.
- * \return true if 'c' is considered to be a 'number', false otherwise.
- **/
-bool isNumber(char c) noexcept
-{
-  return pl::algo::any_of(numbers, [c](char number) { return number == c; });
-}
-
-/*!
- * \brief Module local function to check if 'c' is a 'special' character,
- *        that is 'c' compares equal to either ' ', '!', '"', '#', '$', '%',
- *        '&', '\'', '(', ')', '*', '+', ',', '-', '.', '/', ':', ';',
- *        '<', '=', '>', '?', '@', '[', '\\', ']', '^', '_', '`', '{',
- *        '|', '}', or '~'
- * \param c The character to check.
- * \return true if 'c' is considered to be a special character, otherwise
- *         false.
- **/
-bool isSpecialCharacter(char c) noexcept
-{
-  return pl::algo::any_of(specialCharacters, [c](char specialCharacter) {
-    return specialCharacter == c;
-  });
-}
-
 /*!
  * \brief Module local function to check if the password given is
  *        at least 8 characters long.
@@ -140,8 +19,6 @@ bool isSpecialCharacter(char c) noexcept
  **/
 bool isPasswordLengthOk(std::string_view password) noexcept
 {
-  static constexpr std::size_t minimumPasswordLength{8U};
-
   return password.size() >= minimumPasswordLength;
 }
 
@@ -206,6 +83,23 @@ bool isEqualToUsername(std::string_view password, std::string_view username)
 }
 } // anonymous namespace
 
+bool isLowerCase(char c) noexcept
+{
+  return lowerCaseCharacterSet.contains(c);
+}
+
+bool isUpperCase(char c) noexcept
+{
+  return upperCaseCharacterSet.contains(c);
+}
+
+bool isNumber(char c) noexcept { return digitCharacterSet.contains(c); }
+
+bool isSpecialCharacter(char c) noexcept
+{
+  return specialCharacterSet.contains(c);
+}
+
 std::ostream& operator<<(
   std::ostream&          os,
   PasswordCheckingResult passwordCheckingResult)
@@ -289,4 +183,39 @@ PasswordCheckingResult checkPassword(
             << "\n\tpassword was determined to be OK.";
   return PasswordCheckingResult::Ok;
 }
+
+PasswordPolicy PasswordPolicy::none() noexcept
+{
+  PasswordPolicy policy{};
+  policy.minLength                = 0U;
+  policy.requiresLowerCase        = false;
+  policy.requiresUpperCase        = false;
+  policy.requiresNumber           = false;
+  policy.requiresSpecialCharacter = false;
+  policy.rejectsUsername          = false;
+  return policy;
+}
+
+PasswordPolicy PasswordPolicy::active() noexcept
+{
+#ifdef ENABLE_PW_CHECKS
+  return PasswordPolicy{};
+#else
+  return none();
+#endif // ENABLE_PW_CHECKS
+}
+
+bool PasswordPolicy::isSatisfiedBy(
+  std::string_view username,
+  std::string_view password) const noexcept
+{
+  return password.size() >= minLength
+         and (not requiresLowerCase or containsLowerCaseCharacter(password))
+         and (not requiresUpperCase or containsUpperCaseCharacter(password))
+         and (not requiresNumber or containsNumber(password))
+         and (not requiresSpecialCharacter
+              or containsSpecialCharacter(password))
+         and (not rejectsUsername
+              or not isEqualToUsername(password, username));
+}
 } // namespace itsp3
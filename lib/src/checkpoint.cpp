@@ -0,0 +1,426 @@
+#include "checkpoint.hpp"
+#include <algorithm>     // std::max, std::upper_bound
+#include <cerrno>        // errno, EINTR
+#include <ciso646>       // not, or
+#include <cstdint>       // std::uint64_t
+#include <cstdio>        // std::rename
+#include <cstring>       // std::memcmp, std::strerror
+#include <fcntl.h>       // open, O_WRONLY, O_CREAT, O_TRUNC
+#include <fstream>       // std::ifstream
+#include <iterator>      // std::istreambuf_iterator
+#include <unistd.h>      // write, fsync, close
+#include <utility>       // std::move
+
+namespace itsp3 {
+namespace {
+/*!
+ * \brief The bytes every checkpoint file begins with, the last one is the
+ *        version of the file format.
+ **/
+constexpr char magic[]{'I', 'T', 'S', 'P', '3', 'C', 'P', '1'};
+
+/*!
+ * \brief Module local function to append an unsigned integer as 8 little
+ *        endian bytes.
+ * \param buffer The buffer to append to.
+ * \param value The value to append.
+ **/
+void appendUint64(std::string& buffer, std::uint64_t value)
+{
+  for (std::size_t i{0U}; i < 8U; ++i) {
+    buffer.push_back(static_cast<char>((value >> (8U * i)) & 0xFFU));
+  }
+}
+
+/*!
+ * \brief Module local function to append a KeyspaceIndex as 16 little
+ *        endian bytes.
+ * \param buffer The buffer to append to.
+ * \param value The value to append.
+ **/
+void appendIndex(std::string& buffer, KeyspaceIndex value)
+{
+  appendUint64(buffer, static_cast<std::uint64_t>(value));
+  appendUint64(buffer, static_cast<std::uint64_t>(value >> 64U));
+}
+
+/*!
+ * \brief Module local function to append a string prefixed by its size.
+ * \param buffer The buffer to append to.
+ * \param string The string to append.
+ **/
+void appendString(std::string& buffer, const std::string& string)
+{
+  appendUint64(buffer, string.size());
+  buffer += string;
+}
+
+/*!
+ * \brief Parses the contents of a checkpoint file front to back.
+ **/
+class Parser {
+public:
+  Parser(const std::string& filePath, const std::string& contents)
+    : m_filePath{filePath}, m_contents{contents}, m_position{0U}
+  {
+  }
+
+  std::uint64_t readUint64()
+  {
+    require(8U);
+
+    std::uint64_t value{0U};
+
+    for (std::size_t i{8U}; i-- > 0U;) {
+      value = (value << 8U)
+              | static_cast<unsigned char>(m_contents[m_position + i]);
+    }
+
+    m_position += 8U;
+    return value;
+  }
+
+  KeyspaceIndex readIndex()
+  {
+    const KeyspaceIndex low{readUint64()};
+    const KeyspaceIndex high{readUint64()};
+    return (high << 64U) | low;
+  }
+
+  std::string readString()
+  {
+    const std::uint64_t size{readUint64()};
+    require(size);
+
+    std::string string{m_contents.substr(m_position, size)};
+    m_position += size;
+    return string;
+  }
+
+  void readMagic()
+  {
+    require(sizeof(magic));
+
+    if (std::memcmp(m_contents.data(), magic, sizeof(magic)) != 0) {
+      fail("not a checkpoint file");
+    }
+
+    m_position += sizeof(magic);
+  }
+
+  void expectEnd()
+  {
+    if (m_position != m_contents.size()) {
+      fail("trailing bytes");
+    }
+  }
+
+  [[noreturn]] void fail(const std::string& reason) const
+  {
+    PL_THROW_WITH_SOURCE_INFO(
+      CheckpointException,
+      "Invalid checkpoint file \"" + m_filePath + "\": " + reason);
+  }
+
+private:
+  void require(std::uint64_t byteCount) const
+  {
+    if (byteCount > m_contents.size() - m_position) {
+      fail("truncated");
+    }
+  }
+
+  const std::string& m_filePath;
+  const std::string& m_contents;
+  std::size_t        m_position;
+};
+
+/*!
+ * \brief Module local function to write a buffer to a file completely and
+ *        flush it to the disk.
+ * \param filePath The path of the file to write, it is truncated.
+ * \param buffer The data to write.
+ * \return true on success, otherwise false, errno is set in that case.
+ **/
+bool writeFileDurably(const std::string& filePath, const std::string& buffer)
+{
+  const int fd{::open(filePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644)};
+
+  if (fd == -1) {
+    return false;
+  }
+
+  const char* data{buffer.data()};
+  std::size_t remaining{buffer.size()};
+
+  while (remaining != 0U) {
+    const ssize_t written{::write(fd, data, remaining)};
+
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+
+      const int error{errno};
+      ::close(fd);
+      errno = error;
+      return false;
+    }
+
+    data += written;
+    remaining -= static_cast<std::size_t>(written);
+  }
+
+  if (::fsync(fd) == -1) {
+    const int error{errno};
+    ::close(fd);
+    errno = error;
+    return false;
+  }
+
+  return ::close(fd) == 0;
+}
+} // anonymous namespace
+
+Checkpoint Checkpoint::load(const std::string& filePath)
+{
+  std::ifstream ifs{filePath, std::ios_base::in | std::ios_base::binary};
+
+  if (not ifs) {
+    PL_THROW_WITH_SOURCE_INFO(
+      CheckpointException,
+      "Could not open checkpoint file \"" + filePath + '"');
+  }
+
+  const std::string contents{
+    std::istreambuf_iterator<char>{ifs}, std::istreambuf_iterator<char>{}};
+
+  Parser parser{filePath, contents};
+  parser.readMagic();
+
+  std::string         target{parser.readString()};
+  std::string         alphabet{parser.readString()};
+  const std::uint64_t wordLength{parser.readUint64()};
+  const std::uint64_t rangeCount{parser.readUint64()};
+
+  Checkpoint checkpoint{std::move(target), std::move(alphabet)};
+  checkpoint.m_wordLength = wordLength;
+
+  if (wordLength > checkpoint.m_alphabet.size()) {
+    parser.fail("invalid word length");
+  }
+
+  KeyspaceIndex wordCount{0U};
+
+  try {
+    wordCount = keyspaceSize(checkpoint.m_alphabet.size(), wordLength);
+  }
+  catch (const KeyspaceTooLargeException&) {
+    parser.fail("word length too large");
+  }
+
+  KeyspaceIndex previousEnd{0U};
+
+  for (std::uint64_t i{0U}; i < rangeCount; ++i) {
+    const KeyspaceIndex begin{parser.readIndex()};
+    const KeyspaceIndex end{parser.readIndex()};
+
+    // the ranges must be sorted and merged.
+    if (
+      begin >= end or end > wordCount
+      or (i != 0U and begin <= previousEnd)) {
+      parser.fail("invalid range");
+    }
+
+    checkpoint.m_completedRanges.push_back(KeyspaceRange{begin, end});
+    previousEnd = end;
+  }
+
+  parser.expectEnd();
+
+  return checkpoint;
+}
+
+Checkpoint::Checkpoint(std::string target, std::string alphabet)
+  : m_target{std::move(target)}
+  , m_alphabet{std::move(alphabet)}
+  , m_wordLength{0U}
+  , m_completedRanges{}
+{
+}
+
+void Checkpoint::save(const std::string& filePath) const
+{
+  std::string buffer(magic, sizeof(magic));
+  appendString(buffer, m_target);
+  appendString(buffer, m_alphabet);
+  appendUint64(buffer, m_wordLength);
+  appendUint64(buffer, m_completedRanges.size());
+
+  for (const KeyspaceRange& range : m_completedRanges) {
+    appendIndex(buffer, range.begin);
+    appendIndex(buffer, range.end);
+  }
+
+  const std::string temporaryFilePath{filePath + ".tmp"};
+
+  if (
+    not writeFileDurably(temporaryFilePath, buffer)
+    or std::rename(temporaryFilePath.c_str(), filePath.c_str()) != 0) {
+    PL_THROW_WITH_SOURCE_INFO(
+      CheckpointException,
+      "Could not save checkpoint file \"" + filePath
+        + "\": " + std::strerror(errno));
+  }
+}
+
+const std::string& Checkpoint::getTarget() const noexcept
+{
+  return m_target;
+}
+
+const std::string& Checkpoint::getAlphabet() const noexcept
+{
+  return m_alphabet;
+}
+
+std::size_t Checkpoint::getWordLength() const noexcept
+{
+  return m_wordLength;
+}
+
+const std::vector<KeyspaceRange>& Checkpoint::getCompletedRanges() const
+  noexcept
+{
+  return m_completedRanges;
+}
+
+void Checkpoint::setWordLength(std::size_t wordLength)
+{
+  if (wordLength != m_wordLength) {
+    m_wordLength = wordLength;
+    m_completedRanges.clear();
+  }
+}
+
+void Checkpoint::markCompleted(KeyspaceRange range)
+{
+  if (range.begin >= range.end) {
+    return;
+  }
+
+  // the first range that begins after the new one.
+  auto it = std::upper_bound(
+    m_completedRanges.begin(),
+    m_completedRanges.end(),
+    range.begin,
+    [](KeyspaceIndex begin, const KeyspaceRange& completed) {
+      return begin < completed.begin;
+    });
+
+  // merge with the preceding range if they overlap or touch.
+  if (it != m_completedRanges.begin() and std::prev(it)->end >= range.begin) {
+    --it;
+    it->end = std::max(it->end, range.end);
+  }
+  else {
+    it = m_completedRanges.insert(it, range);
+  }
+
+  // swallow the following ranges that now overlap or touch.
+  auto next = std::next(it);
+
+  while (next != m_completedRanges.end() and next->begin <= it->end) {
+    it->end = std::max(it->end, next->end);
+    ++next;
+  }
+
+  m_completedRanges.erase(std::next(it), next);
+}
+
+std::vector<KeyspaceRange> Checkpoint::getRemainingRanges(
+  KeyspaceIndex wordCount) const
+{
+  std::vector<KeyspaceRange> remainingRanges{};
+  KeyspaceIndex              begin{0U};
+
+  for (const KeyspaceRange& completed : m_completedRanges) {
+    if (completed.begin >= wordCount) {
+      break;
+    }
+
+    if (begin < completed.begin) {
+      remainingRanges.push_back(KeyspaceRange{begin, completed.begin});
+    }
+
+    begin = completed.end;
+  }
+
+  if (begin < wordCount) {
+    remainingRanges.push_back(KeyspaceRange{begin, wordCount});
+  }
+
+  return remainingRanges;
+}
+
+KeyspaceIndex Checkpoint::getCompletedCount() const noexcept
+{
+  KeyspaceIndex completedCount{0U};
+
+  for (const KeyspaceRange& completed : m_completedRanges) {
+    completedCount += completed.end - completed.begin;
+  }
+
+  return completedCount;
+}
+
+Checkpointer::Checkpointer(
+  std::string     filePath,
+  Checkpoint      checkpoint,
+  clock::duration saveInterval)
+  : m_filePath{std::move(filePath)}
+  , m_saveInterval{saveInterval}
+  , m_mutex{}
+  , m_checkpoint{std::move(checkpoint)}
+  , m_lastSave{clock::now()}
+{
+}
+
+Checkpoint Checkpointer::getCheckpoint() const
+{
+  std::lock_guard<std::mutex> lock{m_mutex};
+  return m_checkpoint;
+}
+
+void Checkpointer::beginWordLength(std::size_t wordLength)
+{
+  std::lock_guard<std::mutex> lock{m_mutex};
+  m_checkpoint.setWordLength(wordLength);
+  saveLocked();
+}
+
+void Checkpointer::markCompleted(KeyspaceRange range)
+{
+  std::lock_guard<std::mutex> lock{m_mutex};
+  m_checkpoint.markCompleted(range);
+
+  if (clock::now() - m_lastSave >= m_saveInterval) {
+    saveLocked();
+  }
+}
+
+void Checkpointer::save()
+{
+  std::lock_guard<std::mutex> lock{m_mutex};
+  saveLocked();
+}
+
+void Checkpointer::saveLocked()
+{
+  m_checkpoint.save(m_filePath);
+  m_lastSave = clock::now();
+}
+
+const Checkpointer::clock::duration Checkpointer::s_defaultSaveInterval
+  = std::chrono::seconds{30};
+} // namespace itsp3
@@ -0,0 +1,165 @@
+#include "crack_target.hpp"
+#include <algorithm>          // std::min, std::max
+#include <array>              // std::array
+#include <ciso646>            // not, and, or
+#include <cstring>            // std::memcpy
+#include <pl/zero_memory.hpp> // pl::secure_zero_memory
+#include <string>             // std::string
+
+namespace itsp3 {
+namespace {
+/*!
+ * \brief The maximum length of usernames and passwords, see Bcrypt.
+ **/
+constexpr std::size_t maxSize{BCRYPT_HASHSIZE};
+} // anonymous namespace
+
+CrackTarget::CrackTarget(std::string_view username, std::string_view hash)
+  : m_username{username}, m_salt{}, m_hash{}
+{
+  if (m_username.size() > maxSize) {
+    PL_THROW_WITH_SOURCE_INFO(CrackTargetException, "Username was too long");
+  }
+
+  // the binary file pads the hashes with null characters.
+  hash = hash.substr(0U, hash.find('\0'));
+
+  try {
+    m_hash = BcryptHash::parse(hash);
+  }
+  catch (const BcryptSettingException& ex) {
+    PL_THROW_WITH_SOURCE_INFO(CrackTargetException, ex.what());
+  }
+
+  std::memcpy(m_salt.data(), hash.data(), s_saltLength);
+}
+
+bool CrackTarget::check(std::string_view password) const
+{
+  if (password.size() > maxSize) {
+    return false;
+  }
+
+  // username + password, on the stack so that checking does not allocate.
+  std::array<char, 2U * maxSize> input;
+  std::memcpy(input.data(), m_username.data(), m_username.size());
+  std::memcpy(
+    input.data() + m_username.size(), password.data(), password.size());
+
+  const std::size_t inputSize{m_username.size() + password.size()};
+  const bool        isMatch{
+    bcryptVerify(std::string_view{input.data(), inputSize}, m_hash)};
+
+  // zero out the input, as it does contain the password.
+  pl::secure_zero_memory(input.data(), inputSize);
+
+  return isMatch;
+}
+
+std::optional<std::size_t> CrackTarget::findIn(
+  const CandidateBatch& batch) const
+{
+  return findInImpl(batch, nullptr);
+}
+
+std::optional<std::size_t> CrackTarget::findIn(
+  const CandidateBatch& batch,
+  const PasswordPolicy& policy) const
+{
+  return findInImpl(batch, &policy);
+}
+
+std::size_t CrackTarget::getMaxPasswordLength() const noexcept
+{
+  return std::min(maxSize, significantPasswordLength(m_username.size()));
+}
+
+bool CrackTarget::isWorthChecking(
+  std::string_view      candidate,
+  const PasswordPolicy& policy) const noexcept
+{
+  const std::size_t maxLength{
+    std::max(getMaxPasswordLength(), policy.minLength)};
+
+  if (candidate.size() > maxLength) {
+    return false;
+  }
+
+  // passwords longer than 'candidate' beginning with it have its hash.
+  if (candidate.size() == maxLength and maxLength < maxSize) {
+    return true;
+  }
+
+  return policy.isSatisfiedBy(m_username, candidate);
+}
+
+std::optional<std::size_t> CrackTarget::findInImpl(
+  const CandidateBatch& batch,
+  const PasswordPolicy* policy) const
+{
+  // username + candidate for a group of candidates, on the stack so that
+  // checking does not allocate.
+  static constexpr std::size_t stride{2U * maxSize};
+  std::array<char, bcryptMaxLaneCount * stride>    inputs;
+  std::array<std::string_view, bcryptMaxLaneCount> keys;
+  std::array<std::size_t, bcryptMaxLaneCount>      indices;
+
+  std::size_t i{0U};
+
+  while (i < batch.size()) {
+    std::size_t keyCount{0U};
+
+    // candidates longer than maxSize are left out, as check would reject
+    // them.
+    for (; i < batch.size() and keyCount < bcryptMaxLaneCount; ++i) {
+      const std::string_view password{batch[i]};
+
+      if (
+        password.size() > maxSize
+        or (policy != nullptr and not isWorthChecking(password, *policy))) {
+        continue;
+      }
+
+      char* const input{inputs.data() + keyCount * stride};
+      std::memcpy(input, m_username.data(), m_username.size());
+
+      if (not password.empty()) {
+        std::memcpy(
+          input + m_username.size(), password.data(), password.size());
+      }
+
+      keys[keyCount] = std::string_view{
+        input, m_username.size() + password.size()};
+      indices[keyCount] = i;
+      ++keyCount;
+    }
+
+    const std::optional<std::size_t> match{
+      bcryptVerifyBatch(keys.data(), keyCount, m_hash)};
+
+    // zero out the inputs, as they do contain the candidates.
+    pl::secure_zero_memory(inputs.data(), keyCount * stride);
+
+    if (match) {
+      return indices[*match];
+    }
+  }
+
+  return std::nullopt;
+}
+
+const std::string& CrackTarget::getUsername() const noexcept
+{
+  return m_username;
+}
+
+int CrackTarget::getCost() const noexcept
+{
+  return m_hash.setting.cost;
+}
+
+std::string_view CrackTarget::getSalt() const noexcept
+{
+  return std::string_view{m_salt.data(), s_saltLength};
+}
+} // namespace itsp3
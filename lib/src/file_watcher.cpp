@@ -0,0 +1,108 @@
+#include "file_watcher.hpp"
+#include "log.hpp"         // ITSP3_LOG
+#include <array>           // std::array
+#include <cerrno>          // errno
+#include <ciso646>         // not, and
+#include <cstdint>         // std::uint32_t
+#include <cstring>         // std::strerror
+#include <filesystem>      // std::filesystem::path
+#include <poll.h>          // poll, pollfd, POLLIN
+#include <sys/inotify.h>   // inotify_init1, inotify_add_watch, inotify_event
+#include <unistd.h>        // read, close
+#include <utility>         // std::move
+
+namespace itsp3 {
+namespace {
+/*!
+ * \brief The timeout used when waiting for inotify events so that the
+ *        destructor is not blocked for long.
+ **/
+constexpr int pollTimeoutMilliseconds{20};
+} // anonymous namespace
+
+FileWatcher::FileWatcher(std::string filePath, std::function<void()> onChange)
+  : m_fileName{}
+  , m_onChange{std::move(onChange)}
+  , m_inotifyFd{::inotify_init1(IN_NONBLOCK | IN_CLOEXEC)}
+  , m_isRunning{true}
+  , m_thread{}
+{
+  if (m_inotifyFd < 0) {
+    PL_THROW_WITH_SOURCE_INFO(
+      FileWatcherException,
+      std::string{"could not initialize inotify: "} + std::strerror(errno));
+  }
+
+  const std::filesystem::path path{filePath};
+  m_fileName = path.filename().string();
+
+  std::string directory{path.parent_path().string()};
+
+  if (directory.empty()) {
+    directory = ".";
+  }
+
+  static constexpr std::uint32_t mask{
+    IN_CREATE | IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_TO};
+
+  if (::inotify_add_watch(m_inotifyFd, directory.c_str(), mask) < 0) {
+    const std::string error{std::strerror(errno)};
+    ::close(m_inotifyFd);
+    PL_THROW_WITH_SOURCE_INFO(
+      FileWatcherException,
+      "could not watch \"" + directory + "\": " + error);
+  }
+
+  ITSP3_LOG << "Watching \"" << m_fileName << "\" in \"" << directory << '"';
+
+  m_thread = std::thread{&FileWatcher::watchLoop, this};
+}
+
+FileWatcher::~FileWatcher()
+{
+  m_isRunning = false;
+  m_thread.join();
+  ::close(m_inotifyFd);
+}
+
+void FileWatcher::watchLoop()
+{
+  alignas(inotify_event) std::array<char, 4096U> buffer{};
+
+  while (m_isRunning.load()) {
+    pollfd pollFd{m_inotifyFd, POLLIN, 0};
+
+    if (::poll(&pollFd, 1U, pollTimeoutMilliseconds) <= 0) {
+      continue;
+    }
+
+    bool hasChanged{false};
+
+    // drain all the pending events, so that a burst of writes only
+    // results in a single invocation of the callback.
+    for (;;) {
+      const ssize_t byteCount{
+        ::read(m_inotifyFd, buffer.data(), buffer.size())};
+
+      if (byteCount <= 0) {
+        break;
+      }
+
+      for (ssize_t offset{0}; offset < byteCount;) {
+        const auto* event
+          = reinterpret_cast<const inotify_event*>(buffer.data() + offset);
+
+        if (event->len != 0U and m_fileName == event->name) {
+          hasChanged = true;
+        }
+
+        offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+      }
+    }
+
+    if (hasChanged) {
+      m_onChange();
+    }
+  }
+}
+} // namespace itsp3
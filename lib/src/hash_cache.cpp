@@ -0,0 +1,166 @@
+#include "hash_cache.hpp"
+#include <functional>    // std::hash
+#include <pl/assert.hpp> // PL_DBG_CHECK_PRE
+#include <utility>       // std::move
+
+namespace itsp3 {
+HashCache::HashCache(std::size_t byteBudget, std::size_t shardCount)
+  : m_byteBudget{byteBudget}, m_shardByteBudget{0U}, m_shards{}
+{
+  PL_DBG_CHECK_PRE(shardCount != 0U);
+
+  m_shardByteBudget = m_byteBudget / shardCount;
+
+  m_shards.reserve(shardCount);
+
+  for (std::size_t i{0U}; i < shardCount; ++i) {
+    m_shards.push_back(std::make_unique<Shard>());
+  }
+}
+
+std::optional<std::string> HashCache::find(std::string_view username)
+{
+  Shard& shard{shardOf(username)};
+
+  std::lock_guard<std::mutex> lock{shard.mutex};
+
+  const auto it = shard.index.find(username);
+
+  if (it == shard.index.end()) {
+    ++shard.misses;
+    return std::nullopt;
+  }
+
+  ++shard.hits;
+
+  // move the entry to the front as it is now the most recently used one.
+  shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+
+  return std::make_optional(it->second->hash);
+}
+
+void HashCache::insert(std::string_view username, std::string_view hash)
+{
+  const std::size_t byteSize{entryByteSize(username, hash)};
+
+  // too large to ever fit -> don't evict everything else for it.
+  if (byteSize > m_shardByteBudget) {
+    return;
+  }
+
+  Shard& shard{shardOf(username)};
+
+  std::lock_guard<std::mutex> lock{shard.mutex};
+
+  const auto it = shard.index.find(username);
+
+  if (it != shard.index.end()) {
+    Entry& entry{*(it->second)};
+    shard.byteSize -= entryByteSize(entry.username, entry.hash);
+    entry.hash = std::string{hash};
+    shard.byteSize += byteSize;
+    shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+  }
+  else {
+    shard.lru.push_front(Entry{std::string{username}, std::string{hash}});
+    // the key refers to the string owned by the list node, which is
+    // stable as list nodes never move.
+    shard.index.emplace(shard.lru.front().username, shard.lru.begin());
+    shard.byteSize += byteSize;
+  }
+
+  // evict the least recently used entries until the shard fits its budget.
+  while (shard.byteSize > m_shardByteBudget) {
+    const Entry& victim{shard.lru.back()};
+    shard.byteSize -= entryByteSize(victim.username, victim.hash);
+    shard.index.erase(victim.username);
+    shard.lru.pop_back();
+  }
+}
+
+void HashCache::clear()
+{
+  for (const std::unique_ptr<Shard>& shard : m_shards) {
+    std::lock_guard<std::mutex> lock{shard->mutex};
+    shard->index.clear();
+    shard->lru.clear();
+    shard->byteSize = 0U;
+  }
+}
+
+std::uint64_t HashCache::getHitCount() const
+{
+  std::uint64_t hits{0U};
+
+  for (const std::unique_ptr<Shard>& shard : m_shards) {
+    std::lock_guard<std::mutex> lock{shard->mutex};
+    hits += shard->hits;
+  }
+
+  return hits;
+}
+
+std::uint64_t HashCache::getMissCount() const
+{
+  std::uint64_t misses{0U};
+
+  for (const std::unique_ptr<Shard>& shard : m_shards) {
+    std::lock_guard<std::mutex> lock{shard->mutex};
+    misses += shard->misses;
+  }
+
+  return misses;
+}
+
+std::size_t HashCache::getEntryCount() const
+{
+  std::size_t entryCount{0U};
+
+  for (const std::unique_ptr<Shard>& shard : m_shards) {
+    std::lock_guard<std::mutex> lock{shard->mutex};
+    entryCount += shard->lru.size();
+  }
+
+  return entryCount;
+}
+
+std::size_t HashCache::getByteSize() const
+{
+  std::size_t byteSize{0U};
+
+  for (const std::unique_ptr<Shard>& shard : m_shards) {
+    std::lock_guard<std::mutex> lock{shard->mutex};
+    byteSize += shard->byteSize;
+  }
+
+  return byteSize;
+}
+
+std::size_t HashCache::getByteBudget() const noexcept
+{
+  return m_byteBudget;
+}
+
+std::size_t HashCache::entryByteSize(
+  std::string_view username,
+  std::string_view hash) noexcept
+{
+  // approximation of the list node, the hash table node and the bucket
+  // pointer that are allocated for every entry.
+  static constexpr std::size_t overhead{
+    sizeof(Entry) + sizeof(std::string_view) + 6U * sizeof(void*)};
+
+  return username.size() + hash.size() + overhead;
+}
+
+HashCache::Shard& HashCache::shardOf(std::string_view username) const
+{
+  const std::size_t hash{std::hash<std::string_view>{}(username)};
+
+  return *m_shards[hash % m_shards.size()];
+}
+
+const std::size_t HashCache::s_defaultByteBudget = 1024U * 1024U;
+
+const std::size_t HashCache::s_defaultShardCount = 16U;
+} // namespace itsp3
@@ -0,0 +1,38 @@
+#include "hashing_backend.hpp"
+
+namespace itsp3 {
+HashingBackend::~HashingBackend() = default;
+
+BcryptLibraryBackend::BcryptLibraryBackend(int workFactor) noexcept
+  : m_workFactor{workFactor}
+{
+}
+
+bool BcryptLibraryBackend::generateSalt(HashBuffer& salt)
+{
+  return bcrypt_gensalt(m_workFactor, salt.data()) == 0;
+}
+
+bool BcryptLibraryBackend::hash(
+  const char*       input,
+  const HashBuffer& salt,
+  HashBuffer&       hash)
+{
+  return bcrypt_hashpw(input, salt.data(), hash.data()) == 0;
+}
+
+bool BcryptLibraryBackend::check(const char* input, const char* hash)
+{
+  // bcrypt_checkpw returns -1 on error and 1 on mismatch.
+  return bcrypt_checkpw(input, hash) == 0;
+}
+
+int BcryptLibraryBackend::getWorkFactor() const noexcept
+{
+  return m_workFactor;
+}
+
+const int BcryptLibraryBackend::s_defaultWorkFactor = 12;
+
+const int BcryptLibraryBackend::s_minimumWorkFactor = 4;
+} // namespace itsp3
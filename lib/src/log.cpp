@@ -1,4 +1,5 @@
 #include "log.hpp"
+#include <atomic>  // std::atomic
 #include <cstdint> // std::uint64_t
 #include <utility> // std::move
 
@@ -29,14 +30,16 @@ Log::Log(std::string logFilePath)
 
 Log& createLogEntry(const char* file, const char* line, const char* function)
 {
-  static std::uint64_t entryNumber{0U};
+  // atomic so that merely creating entries from several threads, as the
+  // release mode build does, is not a data race.
+  static std::atomic<std::uint64_t> entryNumber{0U};
 
   Log& log{Log::getInstance()};
 
-  ++entryNumber;
+  const std::uint64_t currentEntryNumber{++entryNumber};
 
   log << "\n\n"
-      << "Entry:    " << entryNumber << '\n'
+      << "Entry:    " << currentEntryNumber << '\n'
       << "File:     " << file << '\n'
       << "Line:     " << line << '\n'
       << "Function: " << function << '\n'
@@ -0,0 +1,67 @@
+#include "mapped_file.hpp"
+#include <cerrno>     // errno
+#include <cstring>    // std::strerror
+#include <fcntl.h>    // open, O_RDONLY
+#include <sys/mman.h> // mmap, munmap, madvise
+#include <sys/stat.h> // fstat
+#include <unistd.h>   // close
+
+namespace itsp3 {
+MappedFile::MappedFile(const std::string& filePath)
+  : m_data{nullptr}, m_size{0U}
+{
+  const int fd{::open(filePath.c_str(), O_RDONLY)};
+
+  if (fd == -1) {
+    PL_THROW_WITH_SOURCE_INFO(
+      MappedFileException,
+      "Could not open \"" + filePath + "\": " + std::strerror(errno));
+  }
+
+  struct stat status {
+  };
+
+  if (::fstat(fd, &status) == -1) {
+    const std::string error{std::strerror(errno)};
+    ::close(fd);
+    PL_THROW_WITH_SOURCE_INFO(
+      MappedFileException, "Could not stat \"" + filePath + "\": " + error);
+  }
+
+  m_size = static_cast<std::size_t>(status.st_size);
+
+  // mapping 0 bytes is an error.
+  if (m_size != 0U) {
+    void* const address{
+      ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0)};
+
+    if (address == MAP_FAILED) {
+      const std::string error{std::strerror(errno)};
+      ::close(fd);
+      PL_THROW_WITH_SOURCE_INFO(
+        MappedFileException, "Could not map \"" + filePath + "\": " + error);
+    }
+
+    // the file is mostly read front to back, read ahead aggressively.
+    ::madvise(address, m_size, MADV_SEQUENTIAL);
+    m_data = static_cast<const char*>(address);
+  }
+
+  // the mapping stays valid after closing the file descriptor.
+  ::close(fd);
+}
+
+MappedFile::~MappedFile()
+{
+  if (m_data != nullptr) {
+    ::munmap(const_cast<char*>(m_data), m_size);
+  }
+}
+
+std::string_view MappedFile::getContents() const noexcept
+{
+  return std::string_view{m_data, m_size};
+}
+
+std::size_t MappedFile::getSize() const noexcept { return m_size; }
+} // namespace itsp3
@@ -0,0 +1,242 @@
+#include "markov.hpp"
+#include <algorithm>     // std::stable_sort
+#include <ciso646>       // not, or
+#include <cstring>       // std::memcmp
+#include <fstream>       // std::ifstream, std::ofstream
+#include <iterator>      // std::istreambuf_iterator
+#include <numeric>       // std::iota
+#include <pl/assert.hpp> // PL_DBG_CHECK_PRE
+#include <utility>       // std::move
+
+namespace itsp3 {
+namespace {
+/*!
+ * \brief The bytes every model file begins with, the last one is the
+ *        version of the file format.
+ **/
+constexpr char magic[]{'I', 'T', 'S', 'P', '3', 'M', 'M', '1'};
+
+/*!
+ * \brief Marks characters that are not in the alphabet in the state table.
+ **/
+constexpr std::size_t noState{static_cast<std::size_t>(-1)};
+
+/*!
+ * \brief Module local function to create the state table of an alphabet.
+ * \param alphabet The alphabet.
+ * \return The state after each character, noState for the characters
+ *         not in 'alphabet'.
+ * \throws MarkovModelException if 'alphabet' is empty or contains
+ *         duplicates.
+ **/
+std::array<std::size_t, 0x100> makeStates(std::string_view alphabet)
+{
+  if (alphabet.empty()) {
+    PL_THROW_WITH_SOURCE_INFO(
+      MarkovModelException, "The alphabet may not be empty");
+  }
+
+  std::array<std::size_t, 0x100> states{};
+  states.fill(noState);
+
+  for (std::size_t i{0U}; i < alphabet.size(); ++i) {
+    std::size_t& state{states[static_cast<unsigned char>(alphabet[i])]};
+
+    if (state != noState) {
+      PL_THROW_WITH_SOURCE_INFO(
+        MarkovModelException, "The alphabet contains duplicates");
+    }
+
+    // state 0 is the start state.
+    state = i + 1U;
+  }
+
+  return states;
+}
+} // anonymous namespace
+
+MarkovModel MarkovModel::train(
+  std::string_view alphabet,
+  std::string_view corpus)
+{
+  const std::array<std::size_t, 0x100> states{makeStates(alphabet)};
+  const std::size_t                    alphabetSize{alphabet.size()};
+  const std::size_t                    stateCount{alphabetSize + 1U};
+
+  // counts[state * alphabetSize + i]: how often alphabet[i] followed state.
+  std::vector<std::uint64_t> counts(stateCount * alphabetSize, 0U);
+  std::size_t                state{s_startState};
+
+  for (char c : corpus) {
+    const std::size_t next{
+      c == '\n' ? noState : states[static_cast<unsigned char>(c)]};
+
+    if (next == noState) {
+      state = s_startState;
+      continue;
+    }
+
+    ++counts[state * alphabetSize + (next - 1U)];
+    state = next;
+  }
+
+  std::string              successors(stateCount * alphabetSize, '\0');
+  std::vector<std::size_t> order(alphabetSize);
+
+  for (std::size_t row{0U}; row < stateCount; ++row) {
+    const std::uint64_t* const rowCounts{&counts[row * alphabetSize]};
+
+    std::iota(order.begin(), order.end(), std::size_t{0U});
+    std::stable_sort(
+      order.begin(), order.end(), [rowCounts](std::size_t a, std::size_t b) {
+        return rowCounts[a] > rowCounts[b];
+      });
+
+    for (std::size_t rank{0U}; rank < alphabetSize; ++rank) {
+      successors[row * alphabetSize + rank] = alphabet[order[rank]];
+    }
+  }
+
+  return MarkovModel{std::string{alphabet}, std::move(successors)};
+}
+
+MarkovModel MarkovModel::load(const std::string& filePath)
+{
+  std::ifstream ifs{filePath, std::ios_base::in | std::ios_base::binary};
+
+  if (not ifs) {
+    PL_THROW_WITH_SOURCE_INFO(
+      MarkovModelException, "Could not open model file \"" + filePath + '"');
+  }
+
+  const std::string contents{
+    std::istreambuf_iterator<char>{ifs}, std::istreambuf_iterator<char>{}};
+
+  const auto fail = [&filePath](const std::string& reason) {
+    PL_THROW_WITH_SOURCE_INFO(
+      MarkovModelException,
+      "Invalid model file \"" + filePath + "\": " + reason);
+  };
+
+  const std::size_t headerSize{sizeof(magic) + 8U};
+
+  if (
+    contents.size() < headerSize
+    or std::memcmp(contents.data(), magic, sizeof(magic)) != 0) {
+    fail("not a model file");
+  }
+
+  // 8 little endian bytes.
+  std::uint64_t alphabetSize{0U};
+
+  for (std::size_t i{8U}; i-- > 0U;) {
+    alphabetSize = (alphabetSize << 8U)
+                   | static_cast<unsigned char>(contents[sizeof(magic) + i]);
+  }
+
+  if (
+    alphabetSize == 0U or alphabetSize > 0x100U
+    or contents.size()
+         != headerSize + alphabetSize + (alphabetSize + 1U) * alphabetSize) {
+    fail("invalid size");
+  }
+
+  std::string alphabet{contents.substr(headerSize, alphabetSize)};
+  std::string successors{contents.substr(headerSize + alphabetSize)};
+
+  MarkovModel model{std::move(alphabet), std::move(successors)};
+
+  // every row must be a permutation of the alphabet.
+  std::vector<std::size_t> lastSeenRow(alphabetSize + 1U, noState);
+
+  for (std::size_t row{0U}; row <= alphabetSize; ++row) {
+    for (std::size_t rank{0U}; rank < alphabetSize; ++rank) {
+      const std::size_t state{model.stateAfter(model.successors(row)[rank])};
+
+      if (state == noState or lastSeenRow[state] == row) {
+        fail("invalid successor table");
+      }
+
+      lastSeenRow[state] = row;
+    }
+  }
+
+  return model;
+}
+
+void MarkovModel::save(const std::string& filePath) const
+{
+  std::ofstream ofs{
+    filePath,
+    std::ios_base::out | std::ios_base::binary | std::ios_base::trunc};
+
+  ofs.write(magic, sizeof(magic));
+
+  for (std::size_t i{0U}; i < 8U; ++i) {
+    ofs.put(static_cast<char>(
+      (static_cast<std::uint64_t>(m_alphabet.size()) >> (8U * i)) & 0xFFU));
+  }
+
+  ofs << m_alphabet << m_successors;
+  ofs.flush();
+
+  if (not ofs) {
+    PL_THROW_WITH_SOURCE_INFO(
+      MarkovModelException,
+      "Could not save model file \"" + filePath + '"');
+  }
+}
+
+const std::string& MarkovModel::getAlphabet() const noexcept
+{
+  return m_alphabet;
+}
+
+MarkovModel::MarkovModel(std::string alphabet, std::string successors)
+  : m_alphabet{std::move(alphabet)}
+  , m_successors{std::move(successors)}
+  , m_states{makeStates(m_alphabet)}
+{
+}
+
+MarkovOdometer::MarkovOdometer(const MarkovModel& model, std::size_t maxLength)
+  : m_model{&model}
+  , m_alphabetSize{model.getAlphabet().size()}
+  , m_maxLength{maxLength}
+  , m_word{}
+  , m_digits{}
+  , m_rows{}
+{
+  m_word.reserve(m_maxLength);
+  m_digits.reserve(m_maxLength);
+  m_rows.reserve(m_maxLength);
+}
+
+void MarkovOdometer::reset(std::size_t wordLength)
+{
+  PL_DBG_CHECK_PRE(wordLength <= m_maxLength);
+
+  // stays within the capacity reserved -> never allocates.
+  m_word.resize(wordLength);
+  m_digits.assign(wordLength, 0U);
+  m_rows.resize(wordLength);
+  recompute(0U);
+}
+
+void MarkovOdometer::seek(std::size_t wordLength, KeyspaceIndex index)
+{
+  PL_DBG_CHECK_PRE(wordLength <= m_maxLength);
+
+  m_word.resize(wordLength);
+  m_digits.resize(wordLength);
+  m_rows.resize(wordLength);
+
+  // the last character is the least significant digit.
+  for (std::size_t i{wordLength}; i-- > 0U;) {
+    m_digits[i] = static_cast<std::size_t>(index % m_alphabetSize);
+    index /= m_alphabetSize;
+  }
+
+  recompute(0U);
+}
+} // namespace itsp3
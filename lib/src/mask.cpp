@@ -0,0 +1,131 @@
+#include "mask.hpp"
+#include "alphabets.hpp" // itsp3::lowerCaseCharacters, ...
+#include <algorithm>     // std::min
+#include <cstddef>       // std::ptrdiff_t
+#include <limits>        // std::numeric_limits
+#include <utility>       // std::move
+
+namespace itsp3 {
+namespace {
+/*!
+ * \brief Module local function to create a std::string from an alphabet.
+ * \param alphabet The alphabet.
+ * \return The characters of 'alphabet' as a std::string.
+ **/
+template<std::size_t AlphabetSize>
+std::string toString(const std::array<char, AlphabetSize>& alphabet)
+{
+  return std::string{alphabet.begin(), alphabet.end()};
+}
+} // anonymous namespace
+
+Mask Mask::parse(std::string_view mask)
+{
+  std::vector<std::string> alphabets{};
+
+  for (std::size_t i{0U}; i < mask.size(); ++i) {
+    if (mask[i] != '?') {
+      alphabets.emplace_back(1U, mask[i]);
+      continue;
+    }
+
+    ++i;
+
+    if (i == mask.size()) {
+      PL_THROW_WITH_SOURCE_INFO(
+        InvalidMaskException,
+        "The mask \"" + std::string{mask} + "\" ends with a lone '?'");
+    }
+
+    switch (mask[i]) {
+    case 'l':
+      alphabets.push_back(toString(lowerCaseCharacters));
+      break;
+    case 'u':
+      alphabets.push_back(toString(upperCaseCharacters));
+      break;
+    case 'd':
+      alphabets.push_back(toString(digits));
+      break;
+    case 's':
+      alphabets.push_back(toString(specialCharacters));
+      break;
+    case 'a':
+      alphabets.push_back(
+        toString(lowerCaseCharacters) + toString(upperCaseCharacters)
+        + toString(digits) + toString(specialCharacters));
+      break;
+    case '?':
+      alphabets.emplace_back(1U, '?');
+      break;
+    default:
+      PL_THROW_WITH_SOURCE_INFO(
+        InvalidMaskException,
+        "Unknown placeholder \"?" + std::string(1U, mask[i])
+          + "\" in the mask \"" + std::string{mask} + '"');
+    }
+  }
+
+  return Mask{std::move(alphabets)};
+}
+
+Mask::Mask(std::vector<std::string> alphabets)
+  : m_alphabets{std::move(alphabets)}
+{
+  for (const std::string& alphabet : m_alphabets) {
+    if (alphabet.empty()) {
+      PL_THROW_WITH_SOURCE_INFO(
+        InvalidMaskException, "The alphabets of a mask may not be empty");
+    }
+  }
+}
+
+std::size_t Mask::getLength() const noexcept { return m_alphabets.size(); }
+
+const std::string& Mask::getAlphabet(std::size_t position) const noexcept
+{
+  return m_alphabets[position];
+}
+
+KeyspaceIndex Mask::size() const
+{
+  KeyspaceIndex size{1U};
+
+  for (const std::string& alphabet : m_alphabets) {
+    if (size > std::numeric_limits<KeyspaceIndex>::max() / alphabet.size()) {
+      PL_THROW_WITH_SOURCE_INFO(
+        KeyspaceTooLargeException,
+        "The keyspace of the mask of length " + std::to_string(getLength())
+          + " is too large");
+    }
+
+    size *= alphabet.size();
+  }
+
+  return size;
+}
+
+Mask Mask::prefix(std::size_t length) const
+{
+  const std::size_t prefixLength{std::min(length, getLength())};
+
+  return Mask{std::vector<std::string>(
+    m_alphabets.begin(),
+    m_alphabets.begin() + static_cast<std::ptrdiff_t>(prefixLength))};
+}
+
+bool Mask::matches(std::string_view word) const noexcept
+{
+  if (word.size() != m_alphabets.size()) {
+    return false;
+  }
+
+  for (std::size_t i{0U}; i < word.size(); ++i) {
+    if (m_alphabets[i].find(word[i]) == std::string::npos) {
+      return false;
+    }
+  }
+
+  return true;
+}
+} // namespace itsp3
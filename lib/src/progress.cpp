@@ -0,0 +1,279 @@
+#include "progress.hpp"
+#include <algorithm>     // std::min
+#include <ciso646>       // not, or
+#include <cstdio>        // std::rename
+#include <fstream>       // std::ofstream
+#include <ostream>       // std::ostream
+#include <pl/assert.hpp> // PL_DBG_CHECK_PRE
+#include <sstream>       // std::ostringstream
+#include <utility>       // std::move
+
+namespace itsp3 {
+namespace {
+/*!
+ * \brief Module local function to convert a KeyspaceIndex to a string of
+ *        decimal digits, as the standard library can't print 128 bit
+ *        integers.
+ * \param value The value to convert.
+ * \return The decimal digits of 'value'.
+ **/
+std::string toString(KeyspaceIndex value)
+{
+  std::string digits{};
+
+  do {
+    digits.insert(digits.begin(), static_cast<char>('0' + value % 10U));
+    value /= 10U;
+  } while (value != 0U);
+
+  return digits;
+}
+
+/*!
+ * \brief Module local function to convert a duration to seconds.
+ * \param duration The duration.
+ * \return The seconds.
+ **/
+double toSeconds(ProgressSnapshot::clock::duration duration) noexcept
+{
+  return std::chrono::duration<double>{duration}.count();
+}
+} // anonymous namespace
+
+std::ostream& operator<<(std::ostream& os, const ProgressSnapshot& snapshot)
+{
+  const double percentage{
+    snapshot.lengthSize == 0U
+      ? 100.0
+      : static_cast<double>(
+        static_cast<long double>(snapshot.searchedCount) * 100.0L
+        / static_cast<long double>(snapshot.lengthSize))};
+
+  std::ostringstream oss{};
+  oss.setf(std::ios_base::fixed);
+  oss.precision(2);
+  oss << "length " << snapshot.wordLength << ": " << percentage << " % ("
+      << toString(snapshot.searchedCount) << " / "
+      << toString(snapshot.lengthSize) << "), ";
+  oss.precision(1);
+  oss << snapshot.candidatesPerSecond << " candidates/s, ETA ";
+
+  if (snapshot.eta) {
+    const std::uint64_t seconds{static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::seconds>(*snapshot.eta)
+        .count())};
+
+    oss << seconds / 3600U << "h " << seconds / 60U % 60U << "m "
+        << seconds % 60U << 's';
+  }
+  else {
+    oss << "unknown";
+  }
+
+  return os << oss.str();
+}
+
+bool writeProgressStats(
+  const std::string&      filePath,
+  const ProgressSnapshot& snapshot)
+{
+  const std::string temporaryFilePath{filePath + ".tmp"};
+
+  {
+    std::ofstream ofs{temporaryFilePath, std::ios_base::trunc};
+
+    if (not ofs) {
+      return false;
+    }
+
+    ofs << "{\n"
+        << "  \"wordLength\": " << snapshot.wordLength << ",\n"
+        << "  \"lengthSize\": " << toString(snapshot.lengthSize) << ",\n"
+        << "  \"searchedCount\": " << toString(snapshot.searchedCount)
+        << ",\n"
+        << "  \"candidateCount\": " << snapshot.candidateCount << ",\n"
+        << "  \"candidatesPerSecond\": " << snapshot.candidatesPerSecond
+        << ",\n"
+        << "  \"elapsedSeconds\": " << toSeconds(snapshot.elapsed) << ",\n"
+        << "  \"etaSeconds\": ";
+
+    if (snapshot.eta) {
+      ofs << toSeconds(*snapshot.eta);
+    }
+    else {
+      ofs << "null";
+    }
+
+    ofs << ",\n  \"workers\": [";
+
+    for (std::size_t i{0U}; i < snapshot.workers.size(); ++i) {
+      ofs << (i == 0U ? "\n" : ",\n") << "    {\"candidateCount\": "
+          << snapshot.workers[i].candidateCount
+          << ", \"candidatesPerSecond\": "
+          << snapshot.workers[i].candidatesPerSecond << '}';
+    }
+
+    ofs << "\n  ]\n}\n";
+
+    if (not ofs.flush()) {
+      return false;
+    }
+  }
+
+  return std::rename(temporaryFilePath.c_str(), filePath.c_str()) == 0;
+}
+
+ProgressCounters::ProgressCounters(std::size_t workerCount)
+  : m_workerCount{std::max<std::size_t>(workerCount, 1U)}
+  , m_workers{std::make_unique<Worker[]>(m_workerCount)}
+  , m_start{clock::now()}
+  , m_mutex{}
+  , m_wordLength{0U}
+  , m_lengthSize{0U}
+  , m_searchedBefore{0U}
+  , m_lengthStart{0U}
+{
+}
+
+std::size_t ProgressCounters::getWorkerCount() const noexcept
+{
+  return m_workerCount;
+}
+
+void ProgressCounters::beginWordLength(
+  std::size_t   wordLength,
+  KeyspaceIndex lengthSize,
+  KeyspaceIndex searchedCount)
+{
+  std::uint64_t candidateCount{0U};
+
+  for (std::size_t i{0U}; i < m_workerCount; ++i) {
+    candidateCount += m_workers[i].candidateCount.load();
+  }
+
+  std::lock_guard<std::mutex> lock{m_mutex};
+  m_wordLength     = wordLength;
+  m_lengthSize     = lengthSize;
+  m_searchedBefore = searchedCount;
+  m_lengthStart    = candidateCount;
+}
+
+void ProgressCounters::publish(
+  std::size_t   worker,
+  std::uint64_t candidateCount,
+  double        candidatesPerSecond) noexcept
+{
+  PL_DBG_CHECK_PRE(worker < m_workerCount);
+
+  // only this worker writes its counters, so there is no need for a
+  // read-modify-write.
+  Worker& counters{m_workers[worker]};
+  counters.candidateCount.store(
+    counters.candidateCount.load(std::memory_order_relaxed) + candidateCount,
+    std::memory_order_relaxed);
+  counters.candidatesPerSecond.store(
+    candidatesPerSecond, std::memory_order_relaxed);
+}
+
+ProgressSnapshot ProgressCounters::snapshot() const
+{
+  ProgressSnapshot snapshot{};
+  snapshot.elapsed = clock::now() - m_start;
+  snapshot.workers.reserve(m_workerCount);
+
+  for (std::size_t i{0U}; i < m_workerCount; ++i) {
+    const ProgressSnapshot::Worker worker{
+      m_workers[i].candidateCount.load(std::memory_order_relaxed),
+      m_workers[i].candidatesPerSecond.load(std::memory_order_relaxed)};
+    snapshot.candidateCount += worker.candidateCount;
+    snapshot.candidatesPerSecond += worker.candidatesPerSecond;
+    snapshot.workers.push_back(worker);
+  }
+
+  std::lock_guard<std::mutex> lock{m_mutex};
+  snapshot.wordLength = m_wordLength;
+  snapshot.lengthSize = m_lengthSize;
+
+  // the counters are not read atomically with the word length, so the
+  // sum may be ahead of or behind the word length.
+  const std::uint64_t lengthCandidateCount{
+    snapshot.candidateCount >= m_lengthStart
+      ? snapshot.candidateCount - m_lengthStart
+      : 0U};
+  snapshot.searchedCount
+    = std::min(m_searchedBefore + lengthCandidateCount, m_lengthSize);
+
+  if (snapshot.candidatesPerSecond > 0.0) {
+    const long double remainingSeconds{
+      static_cast<long double>(snapshot.lengthSize - snapshot.searchedCount)
+      / static_cast<long double>(snapshot.candidatesPerSecond)};
+
+    // beyond what a duration can hold.
+    if (remainingSeconds < 1e12L) {
+      snapshot.eta = std::chrono::duration_cast<clock::duration>(
+        std::chrono::duration<double>{static_cast<double>(remainingSeconds)});
+    }
+  }
+
+  return snapshot;
+}
+
+ProgressReporter::ProgressReporter(
+  const ProgressCounters& counters,
+  std::ostream&           os,
+  std::string             statsFilePath,
+  clock::duration         interval)
+  : m_counters{counters}
+  , m_os{os}
+  , m_statsFilePath{std::move(statsFilePath)}
+  , m_interval{interval}
+  , m_mutex{}
+  , m_conditionVariable{}
+  , m_isStopping{false}
+  , m_thread{}
+{
+  m_thread = std::thread{&this_type::run, this};
+}
+
+ProgressReporter::~ProgressReporter()
+{
+  {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_isStopping = true;
+  }
+
+  m_conditionVariable.notify_one();
+  m_thread.join();
+
+  report();
+  m_os << '\n' << std::flush;
+}
+
+void ProgressReporter::report()
+{
+  const ProgressSnapshot snapshot{m_counters.snapshot()};
+
+  // the trailing spaces erase what is left of a longer previous line.
+  m_os << '\r' << snapshot << "    " << std::flush;
+
+  if (not m_statsFilePath.empty()) {
+    // a dashboard missing an update is no reason to stop cracking.
+    writeProgressStats(m_statsFilePath, snapshot);
+  }
+}
+
+void ProgressReporter::run()
+{
+  std::unique_lock<std::mutex> lock{m_mutex};
+
+  while (not m_conditionVariable.wait_for(
+    lock, m_interval, [this] { return m_isStopping; })) {
+    lock.unlock();
+    report();
+    lock.lock();
+  }
+}
+
+const ProgressReporter::clock::duration ProgressReporter::s_defaultInterval
+  = std::chrono::seconds{1};
+} // namespace itsp3
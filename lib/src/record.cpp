@@ -88,4 +88,29 @@ std::string_view Record::getHash() const noexcept
 {
   return m_hash;
 }
+
+std::uint64_t findEndOfCompleteRecords(
+  std::istream& is,
+  std::uint64_t offset,
+  std::uint64_t limit)
+{
+  std::uint64_t endOffset{offset};
+  Record        record{};
+
+  is.clear();
+  is.seekg(static_cast<std::streamoff>(offset));
+
+  while (Record::read(is, &record)) {
+    const std::uint64_t recordEndOffset{static_cast<std::uint64_t>(is.tellg())};
+
+    if (recordEndOffset > limit) {
+      break;
+    }
+
+    endOffset = recordEndOffset;
+  }
+
+  is.clear();
+  return endOffset;
+}
 } // namespace itsp3
@@ -0,0 +1,125 @@
+#include "record_index.hpp"
+#include "binary_io.hpp" // itsp3::openFileForBinaryReading
+#include "log.hpp"       // ITSP3_LOG
+#include "record.hpp"    // itsp3::Record
+#include <ciso646>       // not, and, or
+#include <fstream>       // std::fstream
+#include <sys/stat.h>    // stat
+#include <utility>       // std::move
+#include <vector>        // std::vector
+
+namespace itsp3 {
+RecordIndex::RecordIndex(std::string filePath)
+  : m_filePath{std::move(filePath)}
+  , m_mutex{}
+  , m_refreshMutex{}
+  , m_hashes{}
+  , m_indexedOffset{0U}
+  , m_indexedDevice{0U}
+  , m_indexedInode{0U}
+{
+}
+
+std::size_t RecordIndex::refresh()
+{
+  std::lock_guard<std::mutex> refreshLock{m_refreshMutex};
+
+  // identified before opening, so that a replacement in between is
+  // noticed by the next refresh rather than never.
+  struct stat status {
+  };
+
+  if (::stat(m_filePath.c_str(), &status) != 0) {
+    return 0U;
+  }
+
+  const std::uint64_t device{static_cast<std::uint64_t>(status.st_dev)};
+  const std::uint64_t inode{static_cast<std::uint64_t>(status.st_ino)};
+
+  std::fstream fs{};
+
+  // re-opened every time, as the binary file may have been replaced.
+  if (not openFileForBinaryReading(fs, m_filePath)) {
+    return 0U;
+  }
+
+  fs.seekg(0, std::ios_base::end);
+  const std::uint64_t fileSize{static_cast<std::uint64_t>(fs.tellg())};
+
+  // only refreshes write the offset and the identity and they are
+  // serialized, so they can be read without the shared lock.
+  // a file renamed over the binary file may well be larger, parsing it
+  // from the old offset would begin in the middle of a record.
+  std::uint64_t offset{m_indexedOffset};
+  const bool    wasReplaced{
+    offset != 0U
+    and (device != m_indexedDevice or inode != m_indexedInode
+         or fileSize < offset)};
+
+  if (wasReplaced) {
+    ITSP3_LOG << "\"" << m_filePath
+              << "\" was replaced, reindexing from scratch";
+    offset = 0U;
+  }
+
+  if (fileSize == offset and not wasReplaced) {
+    return 0U;
+  }
+
+  // parse outside of the lock so that lookups are not blocked by I/O.
+  std::vector<Record> records{};
+  Record              record{};
+
+  fs.seekg(static_cast<std::streamoff>(offset));
+
+  while (Record::read(fs, &record)) {
+    offset = static_cast<std::uint64_t>(fs.tellg());
+    records.push_back(std::move(record));
+  }
+
+  std::unique_lock<std::shared_mutex> lock{m_mutex};
+
+  if (wasReplaced) {
+    m_hashes.clear();
+  }
+
+  for (const Record& currentRecord : records) {
+    // the first record of a username is the authoritative one,
+    // just like when scanning the binary file.
+    m_hashes.emplace(
+      std::string{currentRecord.getUsername()},
+      std::string{currentRecord.getHash()});
+  }
+
+  m_indexedOffset = offset;
+  m_indexedDevice = device;
+  m_indexedInode  = inode;
+
+  return records.size();
+}
+
+std::optional<std::string> RecordIndex::find(std::string_view username) const
+{
+  std::shared_lock<std::shared_mutex> lock{m_mutex};
+
+  const auto it = m_hashes.find(std::string{username});
+
+  if (it == m_hashes.end()) {
+    return std::nullopt;
+  }
+
+  return std::make_optional(it->second);
+}
+
+std::size_t RecordIndex::getRecordCount() const
+{
+  std::shared_lock<std::shared_mutex> lock{m_mutex};
+  return m_hashes.size();
+}
+
+std::uint64_t RecordIndex::getIndexedOffset() const
+{
+  std::shared_lock<std::shared_mutex> lock{m_mutex};
+  return m_indexedOffset;
+}
+} // namespace itsp3
@@ -0,0 +1,648 @@
+#include "replication.hpp"
+#include "binary_io.hpp" // itsp3::openFileForBinaryReading, itsp3::openFileForBinaryWriting
+#include "log.hpp"       // ITSP3_LOG
+#include "record.hpp"    // itsp3::findEndOfCompleteRecords
+#include <algorithm>     // std::min
+#include <array>         // std::array
+#include <cerrno>        // errno, EINTR
+#include <ciso646>       // not, and, or
+#include <cstddef>       // std::size_t
+#include <cstring>       // std::memcpy, std::strerror
+#include <filesystem>    // std::filesystem::resize_file
+#include <fstream>       // std::fstream
+#include <functional>    // std::ref
+#include <poll.h>        // poll, pollfd, POLLIN
+#include <sys/socket.h>  // socket, bind, listen, accept, connect, send, recv
+#include <sys/stat.h>    // stat
+#include <sys/un.h>      // sockaddr_un
+#include <unistd.h>      // close, unlink
+#include <utility>       // std::move
+#include <vector>        // std::vector
+
+namespace itsp3 {
+namespace {
+/*!
+ * \brief The byte size of the offset sent by a follower after connecting.
+ **/
+constexpr std::size_t handshakeByteSize{8U};
+
+/*!
+ * \brief The byte size of the header of every frame sent by the primary.
+ **/
+constexpr std::size_t frameHeaderByteSize{8U + 8U + 4U};
+
+/*!
+ * \brief The maximum byte size of the payload of a single frame.
+ **/
+constexpr std::size_t maxPayloadByteSize{1024U * 1024U};
+
+/*!
+ * \brief The interval at which the primary sends heartbeat frames if
+ *        no records were appended.
+ **/
+constexpr std::chrono::milliseconds heartbeatInterval{100};
+
+/*!
+ * \brief The timeout used when waiting for a socket to become readable
+ *        so that stop requests are noticed in a timely manner.
+ **/
+constexpr int pollTimeoutMilliseconds{20};
+
+/*!
+ * \brief Module local function to encode an unsigned integer as little
+ *        endian bytes.
+ * \param buffer The buffer to write 'byteSize' bytes to.
+ * \param value The value to encode.
+ * \param byteSize The amount of bytes to encode 'value' as.
+ **/
+void encodeLittleEndian(
+  char*         buffer,
+  std::uint64_t value,
+  std::size_t   byteSize) noexcept
+{
+  for (std::size_t i{0U}; i < byteSize; ++i) {
+    buffer[i] = static_cast<char>((value >> (8U * i)) & 0xFFU);
+  }
+}
+
+/*!
+ * \brief Module local function to decode little endian bytes as an
+ *        unsigned integer.
+ * \param buffer The buffer to read 'byteSize' bytes from.
+ * \param byteSize The amount of bytes to decode.
+ * \return The decoded value.
+ **/
+std::uint64_t decodeLittleEndian(
+  const char* buffer,
+  std::size_t byteSize) noexcept
+{
+  std::uint64_t value{0U};
+
+  for (std::size_t i{byteSize}; i-- > 0U;) {
+    value = (value << 8U) | static_cast<unsigned char>(buffer[i]);
+  }
+
+  return value;
+}
+
+/*!
+ * \brief Module local function to create a Unix domain socket address.
+ * \param socketPath The path of the socket.
+ * \return The address.
+ * \throws ReplicationException if 'socketPath' is too long.
+ **/
+sockaddr_un makeAddress(const std::string& socketPath)
+{
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+
+  if (socketPath.size() >= sizeof(address.sun_path)) {
+    PL_THROW_WITH_SOURCE_INFO(
+      ReplicationException, "socket path \"" + socketPath + "\" too long");
+  }
+
+  std::memcpy(address.sun_path, socketPath.data(), socketPath.size());
+  return address;
+}
+
+/*!
+ * \brief Module local function to send a buffer completely.
+ * \param socket The socket to send on.
+ * \param data The data to send.
+ * \param dataByteSize The byte size of 'data'.
+ * \return true on success, false if the peer disconnected.
+ **/
+bool sendAll(int socket, const char* data, std::size_t dataByteSize) noexcept
+{
+  while (dataByteSize != 0U) {
+    const ssize_t sent{::send(socket, data, dataByteSize, MSG_NOSIGNAL)};
+
+    if (sent < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+
+      return false;
+    }
+
+    data += sent;
+    dataByteSize -= static_cast<std::size_t>(sent);
+  }
+
+  return true;
+}
+
+/*!
+ * \brief Module local function to receive a buffer completely.
+ * \param socket The socket to receive on.
+ * \param data The buffer to write to.
+ * \param dataByteSize The amount of bytes to receive.
+ * \param isRunning Checked regularly, receiving is abandoned once false.
+ * \return true on success, false if stopped or the peer disconnected.
+ **/
+bool receiveAll(
+  int                      socket,
+  char*                    data,
+  std::size_t              dataByteSize,
+  const std::atomic<bool>& isRunning) noexcept
+{
+  while (dataByteSize != 0U) {
+    if (not isRunning.load()) {
+      return false;
+    }
+
+    pollfd pollFd{socket, POLLIN, 0};
+
+    const int ready{::poll(&pollFd, 1U, pollTimeoutMilliseconds)};
+
+    if (ready == 0 or (ready < 0 and errno == EINTR)) {
+      continue;
+    }
+
+    if (ready < 0) {
+      return false;
+    }
+
+    const ssize_t received{::recv(socket, data, dataByteSize, 0)};
+
+    if (received < 0 and errno == EINTR) {
+      continue;
+    }
+
+    if (received <= 0) {
+      return false;
+    }
+
+    data += received;
+    dataByteSize -= static_cast<std::size_t>(received);
+  }
+
+  return true;
+}
+
+/*!
+ * \brief Module local function to send a frame.
+ * \param socket The socket to send on.
+ * \param payloadOffset The byte offset of 'payload' in the binary file.
+ * \param primaryOffset The end of the complete records of the primary.
+ * \param payload The complete records to send, may be empty.
+ * \return true on success, false if the peer disconnected.
+ **/
+bool sendFrame(
+  int                      socket,
+  std::uint64_t            payloadOffset,
+  std::uint64_t            primaryOffset,
+  const std::vector<char>& payload) noexcept
+{
+  std::array<char, frameHeaderByteSize> header{};
+  encodeLittleEndian(&header[0U], payloadOffset, 8U);
+  encodeLittleEndian(&header[8U], primaryOffset, 8U);
+  encodeLittleEndian(&header[16U], payload.size(), 4U);
+
+  return sendAll(socket, header.data(), header.size())
+         and sendAll(socket, payload.data(), payload.size());
+}
+} // anonymous namespace
+
+ReplicationPrimary::ReplicationPrimary(
+  std::string               filePath,
+  std::string               socketPath,
+  std::chrono::milliseconds pollInterval)
+  : m_filePath{std::move(filePath)}
+  , m_socketPath{std::move(socketPath)}
+  , m_pollInterval{pollInterval}
+  , m_listenSocket{-1}
+  , m_isRunning{false}
+  , m_followerCount{0U}
+  , m_acceptThread{}
+  , m_followerThreadsMutex{}
+  , m_followerThreads{}
+{
+}
+
+ReplicationPrimary::~ReplicationPrimary()
+{
+  stop();
+}
+
+void ReplicationPrimary::start()
+{
+  const sockaddr_un address{makeAddress(m_socketPath)};
+
+  m_listenSocket = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+  if (m_listenSocket < 0) {
+    PL_THROW_WITH_SOURCE_INFO(
+      ReplicationException,
+      std::string{"could not create socket: "} + std::strerror(errno));
+  }
+
+  // remove a stale socket file left behind by a previous primary.
+  ::unlink(m_socketPath.c_str());
+
+  if (
+    ::bind(
+      m_listenSocket,
+      reinterpret_cast<const sockaddr*>(&address),
+      sizeof(address))
+      != 0
+    or ::listen(m_listenSocket, SOMAXCONN) != 0) {
+    const std::string error{std::strerror(errno)};
+    ::close(m_listenSocket);
+    m_listenSocket = -1;
+    PL_THROW_WITH_SOURCE_INFO(
+      ReplicationException,
+      "could not listen on \"" + m_socketPath + "\": " + error);
+  }
+
+  ITSP3_LOG << "Replication primary listening on \"" << m_socketPath << '"';
+
+  m_isRunning    = true;
+  m_acceptThread = std::thread{&ReplicationPrimary::acceptLoop, this};
+}
+
+void ReplicationPrimary::stop()
+{
+  if (m_listenSocket < 0) {
+    return;
+  }
+
+  m_isRunning = false;
+  m_acceptThread.join();
+
+  // no new follower threads can be created now that the accept thread
+  // has finished.
+  for (FollowerThread& followerThread : m_followerThreads) {
+    followerThread.thread.join();
+  }
+
+  m_followerThreads.clear();
+
+  ::close(m_listenSocket);
+  m_listenSocket = -1;
+  ::unlink(m_socketPath.c_str());
+}
+
+std::size_t ReplicationPrimary::getFollowerCount() const noexcept
+{
+  return m_followerCount.load();
+}
+
+void ReplicationPrimary::acceptLoop()
+{
+  while (m_isRunning.load()) {
+    joinFinishedFollowerThreads();
+
+    pollfd pollFd{m_listenSocket, POLLIN, 0};
+
+    if (::poll(&pollFd, 1U, pollTimeoutMilliseconds) <= 0) {
+      continue;
+    }
+
+    const int followerSocket{
+      ::accept4(m_listenSocket, nullptr, nullptr, SOCK_CLOEXEC)};
+
+    if (followerSocket < 0) {
+      continue;
+    }
+
+    std::lock_guard<std::mutex> lock{m_followerThreadsMutex};
+    FollowerThread&             follower{m_followerThreads.emplace_back()};
+    follower.thread = std::thread{
+      &ReplicationPrimary::serveFollower,
+      this,
+      followerSocket,
+      std::ref(follower.hasFinished)};
+  }
+}
+
+void ReplicationPrimary::joinFinishedFollowerThreads()
+{
+  std::lock_guard<std::mutex> lock{m_followerThreadsMutex};
+
+  for (auto it = m_followerThreads.begin(); it != m_followerThreads.end();) {
+    if (it->hasFinished.load()) {
+      it->thread.join();
+      it = m_followerThreads.erase(it);
+    }
+    else {
+      ++it;
+    }
+  }
+}
+
+void ReplicationPrimary::serveFollower(
+  int                socket,
+  std::atomic<bool>& hasFinished)
+{
+  ++m_followerCount;
+
+  std::array<char, handshakeByteSize> handshake{};
+
+  if (not receiveAll(socket, handshake.data(), handshake.size(), m_isRunning)) {
+    --m_followerCount;
+    ::close(socket);
+    hasFinished = true;
+    return;
+  }
+
+  std::uint64_t offset{decodeLittleEndian(handshake.data(), handshake.size())};
+  std::uint64_t     primaryOffset{offset};
+  auto              lastFrameTime = std::chrono::steady_clock::now();
+  std::fstream      fs{};
+  std::uint64_t     device{0U}; // of the binary file opened
+  std::uint64_t     inode{0U};  // of the binary file opened
+  std::vector<char> payload{};
+
+  ITSP3_LOG << "Follower connected at offset " << offset;
+
+  while (m_isRunning.load()) {
+    // the binary file may not have been created yet or may have been
+    // replaced, in which case the stream still reads the old one.
+    struct stat status {
+    };
+
+    if (
+      ::stat(m_filePath.c_str(), &status) == 0
+      and (not fs.is_open()
+           or static_cast<std::uint64_t>(status.st_dev) != device
+           or static_cast<std::uint64_t>(status.st_ino) != inode)) {
+      const bool wasReplaced{fs.is_open()};
+      fs.close();
+      fs.clear();
+
+      // identified before opening, so that a replacement in between is
+      // noticed by the next iteration.
+      if (openFileForBinaryReading(fs, m_filePath)) {
+        device = static_cast<std::uint64_t>(status.st_dev);
+        inode  = static_cast<std::uint64_t>(status.st_ino);
+
+        fs.seekg(0, std::ios_base::end);
+        const std::uint64_t fileSize{static_cast<std::uint64_t>(fs.tellg())};
+
+        // the copy of the follower is not a prefix of the binary file,
+        // the first frame at offset 0 makes the follower discard it.
+        if (wasReplaced or offset > fileSize) {
+          ITSP3_LOG << "Follower at offset " << offset
+                    << " is sent the binary file from the beginning";
+          offset        = 0U;
+          primaryOffset = 0U;
+        }
+      }
+    }
+
+    if (fs.is_open()) {
+      primaryOffset = findEndOfCompleteRecords(fs, primaryOffset);
+    }
+
+    bool couldSend{true};
+
+    while (couldSend and offset < primaryOffset) {
+      payload.resize(static_cast<std::size_t>(std::min<std::uint64_t>(
+        primaryOffset - offset, maxPayloadByteSize)));
+
+      fs.seekg(static_cast<std::streamoff>(offset));
+
+      if (not readBinary(fs, payload.data(), payload.size())) {
+        fs.clear();
+        break;
+      }
+
+      // a capped payload may end in the middle of a record,
+      // so only ship up to the last record boundary within it.
+      if (offset + payload.size() != primaryOffset) {
+        const std::uint64_t end{
+          findEndOfCompleteRecords(fs, offset, offset + payload.size())};
+        payload.resize(static_cast<std::size_t>(end - offset));
+      }
+
+      couldSend     = sendFrame(socket, offset, primaryOffset, payload);
+      offset       += payload.size();
+      lastFrameTime = std::chrono::steady_clock::now();
+    }
+
+    if (couldSend and std::chrono::steady_clock::now() - lastFrameTime
+                        >= heartbeatInterval) {
+      payload.clear();
+      couldSend     = sendFrame(socket, offset, primaryOffset, payload);
+      lastFrameTime = std::chrono::steady_clock::now();
+    }
+
+    if (not couldSend) {
+      ITSP3_LOG << "Follower disconnected at offset " << offset;
+      break;
+    }
+
+    std::this_thread::sleep_for(m_pollInterval);
+  }
+
+  --m_followerCount;
+  ::close(socket);
+  hasFinished = true;
+}
+
+ReplicationFollower::ReplicationFollower(
+  std::string localFilePath,
+  std::string socketPath)
+  : m_localFilePath{std::move(localFilePath)}
+  , m_socketPath{std::move(socketPath)}
+  , m_bcrypt{m_localFilePath}
+  , m_socket{-1}
+  , m_isRunning{false}
+  , m_isConnected{false}
+  , m_replicatedOffset{0U}
+  , m_primaryOffset{0U}
+  , m_receiveThread{}
+{
+}
+
+ReplicationFollower::~ReplicationFollower()
+{
+  stop();
+}
+
+void ReplicationFollower::start()
+{
+  std::uint64_t replicatedOffset{0U};
+
+  {
+    std::fstream fs{};
+
+    if (openFileForBinaryReading(fs, m_localFilePath)) {
+      replicatedOffset = findEndOfCompleteRecords(fs, 0U);
+      fs.close();
+
+      // drop a record that was only partially written before a crash,
+      // the primary will send it again.
+      std::error_code errorCode{};
+      std::filesystem::resize_file(
+        m_localFilePath, replicatedOffset, errorCode);
+
+      if (errorCode) {
+        PL_THROW_WITH_SOURCE_INFO(
+          ReplicationException,
+          "could not truncate \"" + m_localFilePath
+            + "\": " + errorCode.message());
+      }
+    }
+  }
+
+  const sockaddr_un address{makeAddress(m_socketPath)};
+
+  m_socket = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+  if (m_socket < 0) {
+    PL_THROW_WITH_SOURCE_INFO(
+      ReplicationException,
+      std::string{"could not create socket: "} + std::strerror(errno));
+  }
+
+  std::array<char, handshakeByteSize> handshake{};
+  encodeLittleEndian(handshake.data(), replicatedOffset, handshake.size());
+
+  if (
+    ::connect(
+      m_socket, reinterpret_cast<const sockaddr*>(&address), sizeof(address))
+      != 0
+    or not sendAll(m_socket, handshake.data(), handshake.size())) {
+    const std::string error{std::strerror(errno)};
+    ::close(m_socket);
+    m_socket = -1;
+    PL_THROW_WITH_SOURCE_INFO(
+      ReplicationException,
+      "could not connect to \"" + m_socketPath + "\": " + error);
+  }
+
+  // serve the checks from an index that follows the appends of the
+  // receiving thread.
+  m_bcrypt.enableTailFollowing();
+
+  m_replicatedOffset = replicatedOffset;
+  m_primaryOffset    = replicatedOffset;
+  m_isRunning        = true;
+  m_isConnected      = true;
+  m_receiveThread    = std::thread{&ReplicationFollower::receiveLoop, this};
+}
+
+void ReplicationFollower::stop()
+{
+  if (not m_receiveThread.joinable()) {
+    return;
+  }
+
+  m_isRunning = false;
+  m_receiveThread.join();
+}
+
+bool ReplicationFollower::checkPasswordValidity(
+  std::string_view username,
+  std::string_view password)
+{
+  return m_bcrypt.checkPasswordValidity(username, password);
+}
+
+std::uint64_t ReplicationFollower::getReplicatedOffset() const noexcept
+{
+  return m_replicatedOffset.load();
+}
+
+std::uint64_t ReplicationFollower::getPrimaryOffset() const noexcept
+{
+  return m_primaryOffset.load();
+}
+
+std::uint64_t ReplicationFollower::getLagBytes() const noexcept
+{
+  const std::uint64_t replicatedOffset{getReplicatedOffset()};
+  const std::uint64_t primaryOffset{getPrimaryOffset()};
+
+  return primaryOffset > replicatedOffset ? primaryOffset - replicatedOffset
+                                          : 0U;
+}
+
+bool ReplicationFollower::isConnected() const noexcept
+{
+  return m_isConnected.load();
+}
+
+bool ReplicationFollower::waitForOffset(
+  std::uint64_t             offset,
+  std::chrono::milliseconds timeout) const
+{
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+  while (getReplicatedOffset() < offset) {
+    if (std::chrono::steady_clock::now() >= deadline) {
+      return false;
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+  }
+
+  return true;
+}
+
+void ReplicationFollower::receiveLoop()
+{
+  std::fstream                          fs{};
+  std::array<char, frameHeaderByteSize> header{};
+  std::vector<char>                     payload{};
+
+  if (not openFileForBinaryWriting(fs, m_localFilePath)) {
+    ITSP3_LOG << "Failed to open \"" << m_localFilePath << "\" for writing";
+  }
+
+  while (fs.is_open()
+         and receiveAll(m_socket, header.data(), header.size(), m_isRunning)) {
+    const std::uint64_t payloadOffset{decodeLittleEndian(&header[0U], 8U)};
+    const std::uint64_t primaryOffset{decodeLittleEndian(&header[8U], 8U)};
+    const std::uint64_t payloadByteSize{decodeLittleEndian(&header[16U], 4U)};
+
+    // the primary starts over if its binary file was replaced or is
+    // shorter than the local copy.
+    if (payloadOffset == 0U and m_replicatedOffset.load() != 0U) {
+      ITSP3_LOG << "The primary starts over, discarding \"" << m_localFilePath
+                << '"';
+      std::error_code errorCode{};
+      std::filesystem::resize_file(m_localFilePath, 0U, errorCode);
+
+      if (errorCode) {
+        ITSP3_LOG << "Failed to truncate \"" << m_localFilePath
+                  << "\": " << errorCode.message();
+        break;
+      }
+
+      m_replicatedOffset = 0U;
+    }
+
+    if (
+      payloadByteSize > maxPayloadByteSize
+      or payloadOffset != m_replicatedOffset.load()) {
+      ITSP3_LOG << "Protocol violation, received payload at offset "
+                << payloadOffset << " of size " << payloadByteSize;
+      break;
+    }
+
+    payload.resize(static_cast<std::size_t>(payloadByteSize));
+
+    if (not receiveAll(m_socket, payload.data(), payload.size(), m_isRunning)) {
+      break;
+    }
+
+    if (not payload.empty()) {
+      if (not writeBinary(fs, payload.data(), payload.size()).flush()) {
+        ITSP3_LOG << "Failed to write to \"" << m_localFilePath << '"';
+        break;
+      }
+
+      m_replicatedOffset += payloadByteSize;
+    }
+
+    m_primaryOffset = primaryOffset;
+  }
+
+  m_isConnected = false;
+  ::close(m_socket);
+  m_socket = -1;
+}
+} // namespace itsp3
@@ -0,0 +1,251 @@
+#include "rules.hpp"
+#include <algorithm> // std::reverse, std::replace
+#include <ciso646>   // and, or, not
+#include <utility>   // std::move
+
+namespace itsp3 {
+namespace {
+/*!
+ * \brief Module local function to lower case an ASCII character.
+ * \param c The character.
+ * \return The lower case character or 'c' if it is not a letter.
+ * \note Used in place of std::tolower, which depends on the locale.
+ **/
+char toLower(char c) noexcept
+{
+  return (c >= 'A' and c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+/*!
+ * \brief Module local function to upper case an ASCII character.
+ * \param c The character.
+ * \return The upper case character or 'c' if it is not a letter.
+ **/
+char toUpper(char c) noexcept
+{
+  return (c >= 'a' and c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c;
+}
+
+/*!
+ * \brief Module local function to toggle the case of an ASCII character.
+ * \param c The character.
+ * \return The character in the other case or 'c' if it is not a letter.
+ **/
+char toggleCase(char c) noexcept
+{
+  return (c >= 'a' and c <= 'z') ? toUpper(c) : toLower(c);
+}
+
+/*!
+ * \brief Module local function to parse a position of a rule.
+ * \param c The character denoting the position.
+ * \param rule The rule, for the error message.
+ * \return The position.
+ * \throws RuleParseException if 'c' is not a position.
+ **/
+std::size_t parsePosition(char c, std::string_view rule)
+{
+  if (c >= '0' and c <= '9') {
+    return static_cast<std::size_t>(c - '0');
+  }
+
+  if (c >= 'A' and c <= 'Z') {
+    return static_cast<std::size_t>(c - 'A' + 10);
+  }
+
+  PL_THROW_WITH_SOURCE_INFO(
+    RuleParseException,
+    "Invalid position '" + std::string(1U, c) + "' in the rule \""
+      + std::string{rule} + '"');
+}
+} // anonymous namespace
+
+Rule Rule::parse(std::string_view rule)
+{
+  Rule result{};
+
+  // fetches the argument of the operation at 'i', advancing 'i' to it.
+  const auto argument = [rule](std::size_t& i) {
+    if (i + 1U >= rule.size()) {
+      PL_THROW_WITH_SOURCE_INFO(
+        RuleParseException,
+        "Missing argument of '" + std::string(1U, rule[i])
+          + "' in the rule \"" + std::string{rule} + '"');
+    }
+
+    return rule[++i];
+  };
+
+  for (std::size_t i{0U}; i < rule.size(); ++i) {
+    Operation operation{Opcode::LowerCase, '\0', '\0', 0U};
+
+    switch (rule[i]) {
+    case ' ':
+    case ':':
+      continue;
+    case 'l':
+      operation.opcode = Opcode::LowerCase;
+      break;
+    case 'u':
+      operation.opcode = Opcode::UpperCase;
+      break;
+    case 'c':
+      operation.opcode = Opcode::Capitalize;
+      break;
+    case 'C':
+      operation.opcode = Opcode::InvertCapitalize;
+      break;
+    case 't':
+      operation.opcode = Opcode::ToggleCase;
+      break;
+    case 'T':
+      operation.opcode   = Opcode::ToggleCaseAt;
+      operation.position = parsePosition(argument(i), rule);
+      break;
+    case 'r':
+      operation.opcode = Opcode::Reverse;
+      break;
+    case 'd':
+      operation.opcode = Opcode::Duplicate;
+      break;
+    case '$':
+      operation.opcode = Opcode::Append;
+      operation.first  = argument(i);
+      break;
+    case '^':
+      operation.opcode = Opcode::Prepend;
+      operation.first  = argument(i);
+      break;
+    case '[':
+      operation.opcode = Opcode::DeleteFirst;
+      break;
+    case ']':
+      operation.opcode = Opcode::DeleteLast;
+      break;
+    case 's':
+      operation.opcode = Opcode::Replace;
+      operation.first  = argument(i);
+      operation.second = argument(i);
+      break;
+    default:
+      PL_THROW_WITH_SOURCE_INFO(
+        RuleParseException,
+        "Unknown operation '" + std::string(1U, rule[i]) + "' in the rule \""
+          + std::string{rule} + '"');
+    }
+
+    result.m_operations.push_back(operation);
+  }
+
+  return result;
+}
+
+void Rule::apply(std::string_view word, std::string& buffer) const
+{
+  buffer.assign(word.data(), word.size());
+
+  for (const Operation& operation : m_operations) {
+    switch (operation.opcode) {
+    case Opcode::LowerCase:
+      for (char& c : buffer) {
+        c = toLower(c);
+      }
+      break;
+    case Opcode::UpperCase:
+      for (char& c : buffer) {
+        c = toUpper(c);
+      }
+      break;
+    case Opcode::Capitalize:
+    case Opcode::InvertCapitalize: {
+      const bool isCapitalize{operation.opcode == Opcode::Capitalize};
+
+      for (std::size_t i{0U}; i < buffer.size(); ++i) {
+        buffer[i] = ((i == 0U) == isCapitalize) ? toUpper(buffer[i])
+                                                : toLower(buffer[i]);
+      }
+      break;
+    }
+    case Opcode::ToggleCase:
+      for (char& c : buffer) {
+        c = toggleCase(c);
+      }
+      break;
+    case Opcode::ToggleCaseAt:
+      if (operation.position < buffer.size()) {
+        buffer[operation.position] = toggleCase(buffer[operation.position]);
+      }
+      break;
+    case Opcode::Reverse:
+      std::reverse(buffer.begin(), buffer.end());
+      break;
+    case Opcode::Duplicate:
+      buffer.append(buffer);
+      break;
+    case Opcode::Append:
+      buffer.push_back(operation.first);
+      break;
+    case Opcode::Prepend:
+      buffer.insert(buffer.begin(), operation.first);
+      break;
+    case Opcode::DeleteFirst:
+      if (not buffer.empty()) {
+        buffer.erase(buffer.begin());
+      }
+      break;
+    case Opcode::DeleteLast:
+      if (not buffer.empty()) {
+        buffer.pop_back();
+      }
+      break;
+    case Opcode::Replace:
+      std::replace(
+        buffer.begin(), buffer.end(), operation.first, operation.second);
+      break;
+    }
+  }
+}
+
+RuleSet RuleSet::parse(std::string_view rules)
+{
+  std::vector<Rule> result{};
+  std::size_t       lineNumber{0U};
+
+  while (not rules.empty()) {
+    ++lineNumber;
+
+    const std::size_t newline{rules.find('\n')};
+    std::string_view  line{rules.substr(0U, newline)};
+    rules.remove_prefix(
+      newline == std::string_view::npos ? rules.size() : newline + 1U);
+
+    if (not line.empty() and line.back() == '\r') {
+      line.remove_suffix(1U);
+    }
+
+    if (line.empty() or line.front() == '#') {
+      continue;
+    }
+
+    try {
+      result.push_back(Rule::parse(line));
+    }
+    catch (const RuleParseException& ex) {
+      PL_THROW_WITH_SOURCE_INFO(
+        RuleParseException,
+        "Line " + std::to_string(lineNumber) + ": " + ex.what());
+    }
+  }
+
+  return RuleSet{std::move(result)};
+}
+
+RuleSet::RuleSet(std::vector<Rule> rules) : m_rules{std::move(rules)} {}
+
+const std::vector<Rule>& RuleSet::getRules() const noexcept
+{
+  return m_rules;
+}
+
+std::size_t RuleSet::size() const noexcept { return m_rules.size(); }
+} // namespace itsp3
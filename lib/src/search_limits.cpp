@@ -0,0 +1,96 @@
+#include "search_limits.hpp"
+#include <algorithm> // std::min, std::max
+#include <ostream>   // std::ostream
+
+namespace itsp3 {
+namespace {
+/*!
+ * \brief The largest stride between two checks.
+ **/
+constexpr std::uint64_t maxStride{std::uint64_t{1U} << 16U};
+} // anonymous namespace
+
+CancellationToken::CancellationToken() noexcept : m_isCancelled{false} {}
+
+void CancellationToken::cancel() noexcept
+{
+  m_isCancelled.store(true, std::memory_order_relaxed);
+}
+
+bool CancellationToken::isCancelled() const noexcept
+{
+  return m_isCancelled.load(std::memory_order_relaxed);
+}
+
+std::ostream& operator<<(std::ostream& os, StopReason reason)
+{
+  switch (reason) {
+  case StopReason::Cancelled:
+    return os << "cancelled";
+  case StopReason::DeadlineReached:
+    return os << "deadline reached";
+  case StopReason::BudgetExhausted:
+    return os << "candidate budget exhausted";
+  }
+
+  return os << "invalid StopReason";
+}
+
+SearchLimiter::SearchLimiter(const SearchLimits& limits)
+  : m_limits{limits}
+  , m_candidateCount{0U}
+  , m_nextCheck{0U}
+  , m_stride{1U}
+  , m_lastCheck{clock::now()}
+{
+}
+
+std::uint64_t SearchLimiter::getCandidateCount() const noexcept
+{
+  return m_candidateCount;
+}
+
+std::optional<StopReason> SearchLimiter::check()
+{
+  if (
+    m_limits.candidateBudget
+    and m_candidateCount >= *m_limits.candidateBudget) {
+    return StopReason::BudgetExhausted;
+  }
+
+  if (
+    m_limits.cancellation != nullptr
+    and m_limits.cancellation->isCancelled()) {
+    return StopReason::Cancelled;
+  }
+
+  const clock::time_point now{clock::now()};
+
+  if (m_limits.deadline and now >= *m_limits.deadline) {
+    return StopReason::DeadlineReached;
+  }
+
+  const clock::duration sinceLastCheck{now - m_lastCheck};
+  m_lastCheck = now;
+
+  if (sinceLastCheck < s_targetCheckInterval) {
+    m_stride = std::min(m_stride * 2U, maxStride);
+  }
+  else if (sinceLastCheck > 2 * s_targetCheckInterval) {
+    m_stride = std::max<std::uint64_t>(m_stride / 2U, 1U);
+  }
+
+  m_nextCheck = m_candidateCount + m_stride;
+
+  // the budget is enforced exactly.
+  if (m_limits.candidateBudget) {
+    m_nextCheck = std::min(m_nextCheck, *m_limits.candidateBudget);
+  }
+
+  ++m_candidateCount;
+  return std::nullopt;
+}
+
+const SearchLimiter::clock::duration SearchLimiter::s_targetCheckInterval
+  = std::chrono::milliseconds{1};
+} // namespace itsp3
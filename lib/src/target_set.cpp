@@ -0,0 +1,123 @@
+#include "target_set.hpp"
+#include <algorithm> // std::max
+#include <ciso646>   // not, or
+#include <memory>    // std::make_unique
+#include <utility>   // std::move
+
+namespace itsp3 {
+TargetSet::TargetSet(
+  std::vector<CrackTarget> targets,
+  CrackedCallback          onCracked,
+  const PasswordPolicy&    policy)
+  : m_targets{std::move(targets)}
+  , m_onCracked{std::move(onCracked)}
+  , m_policy{policy}
+  , m_isCracked{std::make_unique<std::atomic<bool>[]>(m_targets.size())}
+  , m_remainingCount{m_targets.size()}
+  , m_callbackMutex{}
+{
+  for (std::size_t i{0U}; i < m_targets.size(); ++i) {
+    m_isCracked[i].store(false, std::memory_order_relaxed);
+  }
+}
+
+bool TargetSet::check(std::string_view candidate)
+{
+  for (std::size_t i{0U}; i < m_targets.size(); ++i) {
+    if (m_isCracked[i].load(std::memory_order_relaxed)) {
+      continue;
+    }
+
+    const CrackTarget& target{m_targets[i]};
+
+    if (
+      not target.isWorthChecking(candidate, m_policy)
+      or not target.check(candidate)) {
+      continue;
+    }
+
+    // another thread may have found the same password in the meantime.
+    if (m_isCracked[i].exchange(true)) {
+      continue;
+    }
+
+    {
+      const std::lock_guard<std::mutex> lock{m_callbackMutex};
+
+      if (m_onCracked) {
+        m_onCracked(target, candidate);
+      }
+    }
+
+    m_remainingCount.fetch_sub(1U);
+  }
+
+  return m_remainingCount.load() == 0U;
+}
+
+std::optional<std::size_t> TargetSet::checkBatch(const CandidateBatch& batch)
+{
+  std::size_t lastIndex{0U};
+
+  for (std::size_t i{0U}; i < m_targets.size(); ++i) {
+    if (m_isCracked[i].load(std::memory_order_relaxed)) {
+      continue;
+    }
+
+    const CrackTarget&               target{m_targets[i]};
+    const std::optional<std::size_t> index{target.findIn(batch, m_policy)};
+
+    // another thread may have found the same password in the meantime.
+    if (not index or m_isCracked[i].exchange(true)) {
+      continue;
+    }
+
+    {
+      const std::lock_guard<std::mutex> lock{m_callbackMutex};
+
+      if (m_onCracked) {
+        m_onCracked(target, batch[*index]);
+      }
+    }
+
+    lastIndex = std::max(lastIndex, *index);
+    m_remainingCount.fetch_sub(1U);
+  }
+
+  if (m_remainingCount.load() != 0U) {
+    return std::nullopt;
+  }
+
+  return lastIndex;
+}
+
+std::size_t TargetSet::getMaxPasswordLength() const noexcept
+{
+  if (m_targets.empty()) {
+    return 0U;
+  }
+
+  std::size_t maxLength{m_policy.minLength};
+
+  for (const CrackTarget& target : m_targets) {
+    maxLength = std::max(maxLength, target.getMaxPasswordLength());
+  }
+
+  return maxLength;
+}
+
+const std::vector<CrackTarget>& TargetSet::getTargets() const noexcept
+{
+  return m_targets;
+}
+
+bool TargetSet::isCracked(std::size_t index) const noexcept
+{
+  return m_isCracked[index].load();
+}
+
+std::size_t TargetSet::getRemainingCount() const noexcept
+{
+  return m_remainingCount.load();
+}
+} // namespace itsp3
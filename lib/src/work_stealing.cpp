@@ -0,0 +1,242 @@
+#include "work_stealing.hpp"
+#include <algorithm>     // std::min, std::max
+#include <ciso646>       // not
+#include <pl/assert.hpp> // PL_DBG_CHECK_PRE
+
+namespace itsp3 {
+namespace {
+/*!
+ * \brief The largest chunk size handed out, so that chunks stay short
+ *        even if the throughput measurements were off.
+ **/
+constexpr std::uint64_t maxChunkSize{std::uint64_t{1U} << 32U};
+
+/*!
+ * \brief Weight of the most recent measurement in the smoothed throughput.
+ **/
+constexpr double smoothingFactor{0.25};
+} // anonymous namespace
+
+WorkStealingScheduler::WorkStealingScheduler(
+  KeyspaceIndex wordCount,
+  std::size_t   workerCount)
+  : this_type{
+    wordCount == 0U ? std::vector<KeyspaceRange>{}
+                    : std::vector<KeyspaceRange>{KeyspaceRange{0U, wordCount}},
+    workerCount}
+{
+}
+
+WorkStealingScheduler::WorkStealingScheduler(
+  const std::vector<KeyspaceRange>& ranges,
+  std::size_t                       workerCount)
+  : m_deques{}
+{
+  PL_DBG_CHECK_PRE(workerCount != 0U);
+
+  m_deques.reserve(workerCount);
+
+  KeyspaceIndex wordCount{0U};
+
+  for (const KeyspaceRange& range : ranges) {
+    PL_DBG_CHECK_PRE(range.begin < range.end);
+    wordCount += range.end - range.begin;
+  }
+
+  const KeyspaceIndex shareSize{wordCount / workerCount};
+  const KeyspaceIndex remainder{wordCount % workerCount};
+  auto                rangeIt = ranges.begin();
+  KeyspaceIndex       begin{rangeIt == ranges.end() ? 0U : rangeIt->begin};
+
+  // start out with a static split, the first 'remainder' workers get one
+  // extra index.
+  for (std::size_t worker{0U}; worker < workerCount; ++worker) {
+    KeyspaceIndex share{shareSize + (worker < remainder ? 1U : 0U)};
+
+    m_deques.push_back(std::make_unique<RangeDeque>());
+
+    // a share may span several of the ranges.
+    while (share != 0U) {
+      const KeyspaceIndex end{std::min(rangeIt->end, begin + share)};
+
+      m_deques.back()->ranges.push_back(KeyspaceRange{begin, end});
+      share -= end - begin;
+      begin = end;
+
+      if (begin == rangeIt->end and ++rangeIt != ranges.end()) {
+        begin = rangeIt->begin;
+      }
+    }
+  }
+}
+
+std::optional<KeyspaceRange> WorkStealingScheduler::next(
+  std::size_t   worker,
+  std::uint64_t chunkSize)
+{
+  PL_DBG_CHECK_PRE(worker < m_deques.size());
+  PL_DBG_CHECK_PRE(chunkSize != 0U);
+
+  std::optional<KeyspaceRange> chunk{take(worker, chunkSize)};
+
+  if (chunk) {
+    return chunk;
+  }
+
+  // start with the next worker, so that thieves spread over the victims.
+  for (std::size_t i{1U}; i < m_deques.size(); ++i) {
+    const std::size_t victim{(worker + i) % m_deques.size()};
+
+    const std::optional<KeyspaceRange> stolen{steal(victim)};
+
+    if (stolen) {
+      RangeDeque& deque{*m_deques[worker]};
+
+      {
+        std::lock_guard<std::mutex> lock{deque.mutex};
+        deque.ranges.push_back(*stolen);
+      }
+
+      // the stolen range may itself be stolen from now on.
+      chunk = take(worker, chunkSize);
+
+      if (chunk) {
+        return chunk;
+      }
+    }
+  }
+
+  return std::nullopt;
+}
+
+void WorkStealingScheduler::truncate(KeyspaceIndex end)
+{
+  for (const std::unique_ptr<RangeDeque>& deque : m_deques) {
+    std::lock_guard<std::mutex> lock{deque->mutex};
+
+    std::deque<KeyspaceRange>& ranges{deque->ranges};
+
+    for (auto it = ranges.begin(); it != ranges.end();) {
+      if (it->begin >= end) {
+        it = ranges.erase(it);
+      }
+      else {
+        it->end = std::min(it->end, end);
+        ++it;
+      }
+    }
+  }
+}
+
+std::optional<KeyspaceRange> WorkStealingScheduler::take(
+  std::size_t   worker,
+  std::uint64_t chunkSize)
+{
+  RangeDeque& deque{*m_deques[worker]};
+
+  std::lock_guard<std::mutex> lock{deque.mutex};
+
+  if (deque.ranges.empty()) {
+    return std::nullopt;
+  }
+
+  KeyspaceRange&      front{deque.ranges.front()};
+  const KeyspaceIndex chunkEnd{
+    std::min<KeyspaceIndex>(front.end, front.begin + chunkSize)};
+  const KeyspaceRange chunk{front.begin, chunkEnd};
+
+  front.begin = chunkEnd;
+
+  if (front.begin == front.end) {
+    deque.ranges.pop_front();
+  }
+
+  return chunk;
+}
+
+std::optional<KeyspaceRange> WorkStealingScheduler::steal(std::size_t victim)
+{
+  RangeDeque& deque{*m_deques[victim]};
+
+  std::lock_guard<std::mutex> lock{deque.mutex};
+
+  if (deque.ranges.empty()) {
+    return std::nullopt;
+  }
+
+  KeyspaceRange& back{deque.ranges.back()};
+
+  // leave the front half to the victim, the owner works front to back.
+  const KeyspaceIndex size{back.end - back.begin};
+
+  if (size == 1U or deque.ranges.size() > 1U) {
+    const KeyspaceRange stolen{back};
+    deque.ranges.pop_back();
+    return stolen;
+  }
+
+  const KeyspaceIndex middle{back.begin + size / 2U};
+  const KeyspaceRange stolen{middle, back.end};
+  back.end = middle;
+  return stolen;
+}
+
+ChunkSizeTuner::ChunkSizeTuner(
+  clock::duration targetChunkDuration,
+  std::uint64_t   granularity)
+  : m_targetChunkDuration{targetChunkDuration}
+  , m_granularity{std::max<std::uint64_t>(granularity, 1U)}
+  , m_candidatesPerSecond{0.0}
+  , m_chunkSize{m_granularity}
+{
+}
+
+std::uint64_t ChunkSizeTuner::getChunkSize() const noexcept
+{
+  return m_chunkSize;
+}
+
+void ChunkSizeTuner::update(
+  std::uint64_t   candidateCount,
+  clock::duration duration) noexcept
+{
+  const double seconds{std::chrono::duration<double>{duration}.count()};
+
+  if (candidateCount == 0U or not(seconds > 0.0)) {
+    return;
+  }
+
+  const double measured{static_cast<double>(candidateCount) / seconds};
+
+  m_candidatesPerSecond
+    = m_candidatesPerSecond == 0.0
+        ? measured
+        : smoothingFactor * measured
+            + (1.0 - smoothingFactor) * m_candidatesPerSecond;
+
+  const double targetSeconds{
+    std::chrono::duration<double>{m_targetChunkDuration}.count()};
+  const double chunkSize{m_candidatesPerSecond * targetSeconds};
+
+  // grow at most by a factor of 2 per chunk, so that a single fast
+  // measurement can not result in a huge chunk.
+  m_chunkSize = static_cast<std::uint64_t>(std::min(
+    {chunkSize,
+     2.0 * static_cast<double>(m_chunkSize),
+     static_cast<double>(maxChunkSize)}));
+
+  // a chunk smaller than a granule would leave the lanes idle that check
+  // the candidates at once.
+  m_chunkSize = std::max(m_chunkSize / m_granularity, std::uint64_t{1U})
+                * m_granularity;
+}
+
+double ChunkSizeTuner::getCandidatesPerSecond() const noexcept
+{
+  return m_candidatesPerSecond;
+}
+
+const ChunkSizeTuner::clock::duration
+  ChunkSizeTuner::s_defaultTargetChunkDuration
+  = std::chrono::milliseconds{50};
+} // namespace itsp3
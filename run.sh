@@ -7,7 +7,7 @@ readonly prev_dir=$(pwd)
 
 cd $DIR
 
-./build/app/itsp3a
+./build/app/itsp3a "$@"
 
 cd $prev_dir
 
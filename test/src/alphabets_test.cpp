@@ -0,0 +1,80 @@
+#include "alphabets.hpp" // itsp3::CharSet, itsp3::toAlphabet, ...
+#include <ciso646>       // and
+#include <doctest.h>
+#include <string>      // std::string
+
+namespace {
+constexpr itsp3::CharSet hexDigits{
+  itsp3::digitCharacterSet | itsp3::CharSet::fromRange('a', 'g')};
+
+constexpr itsp3::CharSet duplicates{itsp3::CharSet::fromCharacters("cabbac")};
+
+// evaluated at compile time.
+static_assert(hexDigits.size() == 16U, "wrong size");
+static_assert(itsp3::toAlphabet<duplicates>().size() == 3U, "not deduped");
+static_assert(itsp3::printableAlphabet.size() == 95U, "wrong size");
+static_assert(itsp3::alnumAlphabet.size() == 62U, "wrong size");
+static_assert(itsp3::specialCharacters.size() == 33U, "wrong size");
+
+/*!
+ * \brief Module local function to convert an alphabet to a std::string.
+ * \param alphabet The alphabet.
+ * \return The characters of 'alphabet'.
+ **/
+template<typename Alphabet>
+std::string toString(const Alphabet& alphabet)
+{
+  return std::string{alphabet.begin(), alphabet.end()};
+}
+} // anonymous namespace
+
+TEST_CASE("alphabets_test")
+{
+  SUBCASE("set_algebra")
+  {
+    const itsp3::CharSet abc{itsp3::CharSet::fromRange('a', 'd')};
+    const itsp3::CharSet bcd{itsp3::CharSet::fromCharacters("dcb")};
+
+    CHECK((abc | bcd) == itsp3::CharSet::fromCharacters("abcd"));
+    CHECK((abc & bcd) == itsp3::CharSet::fromCharacters("bc"));
+    CHECK((abc - bcd) == itsp3::CharSet::fromCharacters("a"));
+    CHECK((abc - abc).empty());
+    CHECK(abc != bcd);
+    CHECK(itsp3::CharSet{}.size() == 0U);
+
+    CHECK_UNARY(abc.contains('a'));
+    CHECK_UNARY_FALSE(abc.contains('d'));
+    CHECK_UNARY_FALSE(abc.contains('\0'));
+
+    // char values beyond ASCII are supported.
+    itsp3::CharSet high{};
+    high.insert('\xFF').insert('\x80');
+    CHECK(high.size() == 2U);
+    CHECK_UNARY(high.contains('\xFF'));
+    CHECK_UNARY_FALSE(high.contains('\x7F'));
+  }
+
+  SUBCASE("to_alphabet")
+  {
+    CHECK(toString(itsp3::toAlphabet<hexDigits>()) == "0123456789abcdef");
+    CHECK(toString(itsp3::toAlphabet<duplicates>()) == "abc");
+  }
+
+  SUBCASE("predefined_alphabets")
+  {
+    CHECK(
+      toString(itsp3::specialCharacters)
+      == " !\"#$%&'()*+,-./:;<=>?@[\\]^_`{|}~");
+    CHECK(
+      toString(itsp3::alnumAlphabet)
+      == "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz");
+    CHECK(itsp3::printableAlphabet.front() == ' ');
+    CHECK(itsp3::printableAlphabet.back() == '~');
+
+    for (char c : itsp3::asciiAlphabet) {
+      CHECK(
+        itsp3::printableCharacterSet.contains(c)
+        == (c >= ' ' and c <= '~'));
+    }
+  }
+}
@@ -0,0 +1,227 @@
+#include "bcrypt_kernel.hpp" // itsp3::bcryptHash, itsp3::bcryptHashBatch, ...
+#include <bcrypt.h>          // bcrypt_gensalt, bcrypt_hashpw, ...
+#include <ciso646>           // not, and
+#include <cstddef>           // std::size_t
+#include <doctest.h>
+#include <optional>    // std::optional
+#include <random>      // std::mt19937, std::uniform_int_distribution
+#include <string>      // std::string
+#include <string_view> // std::string_view
+#include <vector>      // std::vector
+
+namespace {
+/*!
+ * \brief Module local function to hash a key with the bcrypt library.
+ * \param key The key.
+ * \param setting The setting, such as "$2a$04$..." .
+ * \return The hash created by bcrypt_hashpw.
+ **/
+std::string libraryHash(const std::string& key, const std::string& setting)
+{
+  char hash[BCRYPT_HASHSIZE]{};
+  REQUIRE(bcrypt_hashpw(key.c_str(), setting.c_str(), hash) == 0);
+  return hash;
+}
+
+/*!
+ * \brief Module local function to hash a key with the in-tree kernel.
+ * \param key The key.
+ * \param setting The setting, such as "$2a$04$..." .
+ * \return The hash.
+ **/
+std::string kernelHash(std::string_view key, const std::string& setting)
+{
+  const itsp3::BcryptSetting parsed{itsp3::BcryptSetting::parse(setting)};
+  return itsp3::formatBcryptHash(parsed, itsp3::bcryptHash(key, parsed));
+}
+} // anonymous namespace
+
+TEST_CASE("bcrypt_kernel_test")
+{
+  SUBCASE("known_vectors")
+  {
+    CHECK(
+      kernelHash("", "$2a$05$CCCCCCCCCCCCCCCCCCCCC.")
+      == "$2a$05$CCCCCCCCCCCCCCCCCCCCC.7uG0VCzI2bS7j6ymqJi9CdcdxiRTWNy");
+    CHECK(
+      kernelHash("U*U", "$2a$05$CCCCCCCCCCCCCCCCCCCCC.")
+      == "$2a$05$CCCCCCCCCCCCCCCCCCCCC.E5YPO9kmyuRGyh0XouQYb4YMJKvyOeW");
+
+    // 8 bit characters, affected by the sign extension bug of "$2x$".
+    CHECK(
+      kernelHash("\xa3", "$2a$05$/OK.fbVrR/bpIqNJ5ianF.")
+      == "$2a$05$/OK.fbVrR/bpIqNJ5ianF.Sa7shbm4.OzKpvFnX1pQLmQW96oUlCq");
+    CHECK(
+      kernelHash("\xa3", "$2x$05$/OK.fbVrR/bpIqNJ5ianF.")
+      == "$2x$05$/OK.fbVrR/bpIqNJ5ianF.CE5elHaaO4EbggVDjb8P19RukzXSM3e");
+    CHECK(
+      kernelHash("\xa3", "$2y$05$/OK.fbVrR/bpIqNJ5ianF.")
+      == "$2y$05$/OK.fbVrR/bpIqNJ5ianF.Sa7shbm4.OzKpvFnX1pQLmQW96oUlCq");
+
+    // "$2a$" avoids colliding with the buggy hash.
+    CHECK(
+      kernelHash("\xff\xff\xa3", "$2a$05$/OK.fbVrR/bpIqNJ5ianF.")
+      == "$2a$05$/OK.fbVrR/bpIqNJ5ianF.nqd1wy.pTMdcvrRWxyiGL2eMz.2a85.");
+    CHECK(
+      kernelHash("\xff\xff\xa3", "$2y$05$/OK.fbVrR/bpIqNJ5ianF.")
+      == "$2y$05$/OK.fbVrR/bpIqNJ5ianF.CE5elHaaO4EbggVDjb8P19RukzXSM3e");
+  }
+
+  SUBCASE("bit_identical_to_the_library")
+  {
+    std::mt19937                               engine{20180117U};
+    std::uniform_int_distribution<int>         byteDistribution{1, 0xFF};
+    std::uniform_int_distribution<std::size_t> lengthDistribution{0U, 80U};
+
+    char salt[BCRYPT_HASHSIZE]{};
+    REQUIRE(bcrypt_gensalt(4, salt) == 0);
+    const std::string          setting{salt};
+    const itsp3::BcryptSetting parsed{itsp3::BcryptSetting::parse(setting)};
+
+    std::vector<std::string> keys{"", std::string(71U, 'a'),
+                                  std::string(72U, 'a'),
+                                  std::string(73U, 'a')};
+
+    while (keys.size() < 67U) {
+      std::string key(lengthDistribution(engine), ' ');
+
+      for (char& c : key) {
+        c = static_cast<char>(byteDistribution(engine));
+      }
+
+      keys.push_back(key);
+    }
+
+    std::vector<std::string> expected{};
+
+    for (const std::string& key : keys) {
+      expected.push_back(libraryHash(key, setting));
+      CHECK(kernelHash(key, setting) == expected.back());
+    }
+
+    const std::vector<std::string_view> views(keys.begin(), keys.end());
+
+    for (itsp3::BcryptIsa isa :
+         {itsp3::BcryptIsa::Scalar,
+          itsp3::BcryptIsa::Sse41,
+          itsp3::BcryptIsa::Avx2,
+          itsp3::BcryptIsa::Avx512}) {
+      if (not itsp3::isSupported(isa)) {
+        continue;
+      }
+
+      std::vector<itsp3::BcryptDigest> digests(views.size());
+      itsp3::bcryptHashBatch(
+        views.data(), views.size(), parsed, digests.data(), isa);
+
+      for (std::size_t i{0U}; i < keys.size(); ++i) {
+        CHECK(itsp3::formatBcryptHash(parsed, digests[i]) == expected[i]);
+      }
+    }
+  }
+
+  SUBCASE("verify_agrees_with_the_library")
+  {
+    std::mt19937                               engine{20180118U};
+    std::uniform_int_distribution<int>         byteDistribution{1, 0xFF};
+    std::uniform_int_distribution<std::size_t> lengthDistribution{0U, 80U};
+
+    for (std::size_t i{0U}; i < 200U; ++i) {
+      std::string key(lengthDistribution(engine), ' ');
+
+      for (char& c : key) {
+        c = static_cast<char>(byteDistribution(engine));
+      }
+
+      char salt[BCRYPT_HASHSIZE]{};
+      REQUIRE(bcrypt_gensalt(4, salt) == 0);
+      const std::string       hash{libraryHash(key, salt)};
+      const itsp3::BcryptHash parsed{itsp3::BcryptHash::parse(hash)};
+
+      // every other candidate differs from the key in one byte.
+      std::string candidate{key};
+
+      if (i % 2U == 1U and not candidate.empty()) {
+        candidate[i % candidate.size()] ^= 0x01;
+      }
+
+      CHECK(
+        itsp3::bcryptVerify(candidate, parsed)
+        == (bcrypt_checkpw(candidate.c_str(), hash.c_str()) == 0));
+    }
+  }
+
+  SUBCASE("rejects_invalid_hashes")
+  {
+    for (const char* hash :
+         {"$2a$05$CCCCCCCCCCCCCCCCCCCCC.E5YPO9kmyuRGyh0XouQYb4YMJKvyOe",
+          "$2a$05$CCCCCCCCCCCCCCCCCCCCC.E5YPO9kmyuRGyh0XouQYb4YMJKvyOeW.",
+          "$2a$05$CCCCCCCCCCCCCCCCCCCCC.E5YPO9kmyuRGyh0XouQYb4YMJKvyOe!",
+          // the unused bits of the salt or the digest are set.
+          "$2a$05$CCCCCCCCCCCCCCCCCCCCC/E5YPO9kmyuRGyh0XouQYb4YMJKvyOeW",
+          "$2a$05$CCCCCCCCCCCCCCCCCCCCC.E5YPO9kmyuRGyh0XouQYb4YMJKvyOeX"}) {
+      CHECK_THROWS_AS(
+        itsp3::BcryptHash::parse(hash), itsp3::BcryptSettingException);
+    }
+
+    const itsp3::BcryptHash hash{itsp3::BcryptHash::parse(
+      "$2a$05$CCCCCCCCCCCCCCCCCCCCC.E5YPO9kmyuRGyh0XouQYb4YMJKvyOeW")};
+    CHECK(hash.setting.cost == 5);
+    CHECK_UNARY(itsp3::bcryptVerify("U*U", hash));
+    CHECK_UNARY_FALSE(itsp3::bcryptVerify("U*V", hash));
+  }
+
+  SUBCASE("keys_end_at_null_characters")
+  {
+    const std::string setting{"$2a$04$CCCCCCCCCCCCCCCCCCCCC."};
+    CHECK(
+      kernelHash(std::string_view{"abc\0def", 7U}, setting)
+      == kernelHash("abc", setting));
+  }
+
+  SUBCASE("rejects_invalid_settings")
+  {
+    for (const char* setting :
+         {"",
+          "$2a$05$CCCCCCCCCCCCCCCCCCCC",
+          "$2c$05$CCCCCCCCCCCCCCCCCCCCC.",
+          "$2a$03$CCCCCCCCCCCCCCCCCCCCC.",
+          "$2a$32$CCCCCCCCCCCCCCCCCCCCC.",
+          "$2a$0a$CCCCCCCCCCCCCCCCCCCCC.",
+          "$2a$05$CCCCCCCCCCCCCCCCCCCC!."}) {
+      CHECK_THROWS_AS(
+        itsp3::BcryptSetting::parse(setting), itsp3::BcryptSettingException);
+    }
+  }
+
+  SUBCASE("verify_batch_finds_the_first_match")
+  {
+    const itsp3::BcryptHash hash{itsp3::BcryptHash::parse(
+      "$2a$05$CCCCCCCCCCCCCCCCCCCCC.E5YPO9kmyuRGyh0XouQYb4YMJKvyOeW")};
+
+    // spans three groups, the key is in the second and the third.
+    std::vector<std::string_view> keys(40U, "U*V");
+    keys[20U] = "U*U";
+    keys[35U] = "U*U";
+
+    const std::optional<std::size_t> match{
+      itsp3::bcryptVerifyBatch(keys.data(), keys.size(), hash)};
+    REQUIRE_UNARY(match.has_value());
+    CHECK(*match == 20U);
+
+    CHECK_UNARY_FALSE(
+      itsp3::bcryptVerifyBatch(keys.data(), 20U, hash).has_value());
+    CHECK_UNARY_FALSE(
+      itsp3::bcryptVerifyBatch(keys.data(), 0U, hash).has_value());
+  }
+
+  SUBCASE("lanes")
+  {
+    CHECK(itsp3::laneCount(itsp3::BcryptIsa::Scalar) == 1U);
+    CHECK(itsp3::laneCount(itsp3::BcryptIsa::Sse41) == 4U);
+    CHECK(itsp3::laneCount(itsp3::BcryptIsa::Avx2) == 8U);
+    CHECK(itsp3::laneCount(itsp3::BcryptIsa::Avx512) == 16U);
+    CHECK_UNARY(itsp3::isSupported(itsp3::BcryptIsa::Scalar));
+    CHECK_UNARY(itsp3::isSupported(itsp3::bestBcryptIsa()));
+  }
+}
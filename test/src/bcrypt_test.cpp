@@ -1,14 +1,59 @@
-#include "bcrypt.hpp" // itsp3::Bcrypt
+#include "bcrypt.hpp"          // itsp3::Bcrypt
+#include "hashing_backend.hpp" // itsp3::HashingBackend, itsp3::BcryptLibraryBackend
+#include <atomic>              // std::atomic
 #include <cassert>    // assert
 #include <ciso646>    // and
 #include <cstddef>    // std::size_t
-#include <cstdio>     // std::remove
+#include <cstdint>    // std::uint64_t
+#include <cstdio>     // std::remove, std::rename
 #include <doctest.h>
+#include <fstream>  // std::ofstream
 #include <iterator>                      // std::begin
+#include <memory> // std::shared_ptr, std::make_shared
 #include <pl/algo/ranged_algorithms.hpp> // pl::algo::copy
 #include <string> // std::string, std::literals::string_literals::operator""s
 #include <unordered_map> // std::unordered_map
 
+namespace {
+/*!
+ * \brief Instrumented HashingBackend that counts the hashes calculated.
+ *        Uses the lowest work factor, as the tests don't need strong
+ *        hashes, but many of them.
+ **/
+class CountingBackend : public itsp3::HashingBackend {
+public:
+  bool generateSalt(itsp3::HashBuffer& salt) override
+  {
+    return m_backend.generateSalt(salt);
+  }
+
+  bool hash(
+    const char*              input,
+    const itsp3::HashBuffer& salt,
+    itsp3::HashBuffer&       hash) override
+  {
+    ++m_hashCount;
+    return m_backend.hash(input, salt, hash);
+  }
+
+  bool check(const char* input, const char* hash) override
+  {
+    ++m_hashCount;
+    return m_backend.check(input, hash);
+  }
+
+  int getHashCount() const noexcept
+  {
+    return m_hashCount.load();
+  }
+
+private:
+  itsp3::BcryptLibraryBackend m_backend{
+    itsp3::BcryptLibraryBackend::s_minimumWorkFactor};
+  std::atomic<int> m_hashCount{0};
+};
+} // anonymous namespace
+
 TEST_CASE("bcrypt_test")
 {
   using namespace std::literals::string_literals;
@@ -46,7 +91,10 @@ TEST_CASE("bcrypt_test")
     {std::string(maxSize, ' '), "pwbA1{4555565555"s},
     {"user"s, largestAcceptablePassword}};
 
-  itsp3::Bcrypt bcrypt{testBinFile};
+  const std::shared_ptr<CountingBackend> backend{
+    std::make_shared<CountingBackend>()};
+
+  itsp3::Bcrypt bcrypt{testBinFile, backend};
 
   // fill the file with the default test records
   for (const auto& p : records) {
@@ -130,6 +178,52 @@ TEST_CASE("bcrypt_test")
     REQUIRE(std::remove(testBinFile) == 0);
   }
 
+  SUBCASE("repeated_lookups_are_served_by_the_hash_cache")
+  {
+    const std::uint64_t hitsBefore{bcrypt.getHashCache().getHitCount()};
+
+    CHECK_UNARY(bcrypt.checkPasswordValidity("Peter", "passwordA1{"));
+    CHECK_UNARY(bcrypt.checkPasswordValidity("Peter", "passwordA1{"));
+
+    CHECK(bcrypt.getHashCache().getHitCount() == hitsBefore + 2U);
+
+    REQUIRE(std::remove(testBinFile) == 0);
+  }
+
+  SUBCASE("the_hash_cache_is_dropped_if_the_file_is_replaced")
+  {
+    static constexpr char replacementBinFile[] = "./test_data_new.bin";
+
+    CHECK_UNARY(bcrypt.checkPasswordValidity("Peter", "passwordA1{"));
+
+    {
+      itsp3::Bcrypt replacement{replacementBinFile, backend};
+      REQUIRE_UNARY(replacement.addUser("Peter", "newpasswordA1{"));
+    }
+
+    REQUIRE(std::rename(replacementBinFile, testBinFile) == 0);
+
+    CHECK_UNARY(bcrypt.checkPasswordValidity("Peter", "newpasswordA1{"));
+    CHECK_UNARY_FALSE(bcrypt.checkPasswordValidity("Peter", "passwordA1{"));
+    CHECK_UNARY_FALSE(bcrypt.checkPasswordValidity("Hannes", "geheimA1{"));
+
+    REQUIRE(std::remove(testBinFile) == 0);
+  }
+
+  SUBCASE("the_hash_cache_is_dropped_if_the_file_shrinks")
+  {
+    CHECK_UNARY(bcrypt.checkPasswordValidity("Peter", "passwordA1{"));
+
+    // rewrite the same file with fewer records.
+    std::ofstream{testBinFile, std::ios::trunc};
+    REQUIRE_UNARY(bcrypt.addUser("Hannes", "newpasswordA1{"));
+
+    CHECK_UNARY_FALSE(bcrypt.checkPasswordValidity("Peter", "passwordA1{"));
+    CHECK_UNARY(bcrypt.checkPasswordValidity("Hannes", "newpasswordA1{"));
+
+    REQUIRE(std::remove(testBinFile) == 0);
+  }
+
   SUBCASE("passwords_for_non_existent_users_are_not_accepted")
   {
     CHECK_UNARY_FALSE(bcrypt.checkPasswordValidity("???", "pwbA1{"));
@@ -138,4 +232,28 @@ TEST_CASE("bcrypt_test")
 
     REQUIRE(std::remove(testBinFile) == 0);
   }
+
+  SUBCASE("uses_the_injected_hashing_backend")
+  {
+    const int hashCountBefore{backend->getHashCount()};
+
+    CHECK_UNARY(bcrypt.checkPasswordValidity("Peter", "passwordA1{"));
+    CHECK_UNARY_FALSE(bcrypt.checkPasswordValidity("???", "pwbA1{"));
+
+    // no hash is calculated for users that don't exist.
+    CHECK(backend->getHashCount() == hashCountBefore + 1);
+
+    REQUIRE(std::remove(testBinFile) == 0);
+  }
+
+  SUBCASE("default_backend_creates_compatible_hashes")
+  {
+    itsp3::Bcrypt defaultBcrypt{testBinFile};
+
+    CHECK_UNARY(defaultBcrypt.checkPasswordValidity("Peter", "passwordA1{"));
+    CHECK_UNARY(defaultBcrypt.addUser("Franz", "meinpasswortbA1{"));
+    CHECK_UNARY(bcrypt.checkPasswordValidity("Franz", "meinpasswortbA1{"));
+
+    REQUIRE(std::remove(testBinFile) == 0);
+  }
 }
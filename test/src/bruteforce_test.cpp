@@ -1,5 +1,5 @@
-#include "alphabets.hpp"  // itsp3::asciiAlphabet
-#include "bruteforce.hpp" // itsp3::bruteforce
+#include "alphabets.hpp"  // itsp3::asciiAlphabet, itsp3::makeAlphabet
+#include "bruteforce.hpp" // itsp3::bruteforce, itsp3::fixedLengthBruteforce
 #include <doctest.h>      // TEST_CASE, CHECK
 #include <string>         // std::string
 #include <string_view>    // std::string_view
@@ -26,4 +26,77 @@ TEST_CASE("bruteforce_test")
   CHECK(
     itsp3::bruteforce(makePasswordChecker("abc"), itsp3::asciiAlphabet)
     == "abc");
+
+  SUBCASE("respects_the_length_bounds")
+  {
+    static constexpr auto alphabet = itsp3::makeAlphabet<'a', 'c'>();
+
+    CHECK(
+      itsp3::bruteforce(makePasswordChecker("ab"), alphabet, 2U, 2U) == "ab");
+
+    // longer than the alphabet.
+    CHECK(
+      itsp3::bruteforce(makePasswordChecker("abbab"), alphabet, 5U, 5U)
+      == "abbab");
+
+    bool hasThrown{false};
+
+    try {
+      itsp3::bruteforce(makePasswordChecker("a"), alphabet, 2U, 3U);
+    }
+    catch (const itsp3::KeyspaceExhaustedException& ex) {
+      hasThrown = true;
+      CHECK(ex.getMinLength() == 2U);
+      CHECK(ex.getMaxLength() == 3U);
+      CHECK(ex.getCandidateCount() == 4U + 8U);
+      CHECK(
+        std::string_view{ex.what()}.find("12 candidates")
+        != std::string_view::npos);
+    }
+
+    CHECK_UNARY(hasThrown);
+
+    CHECK_THROWS_AS(
+      itsp3::bruteforce(makePasswordChecker("abbab"), alphabet, 0U, 4U),
+      itsp3::NoMatchInBruteforceAlgorithmException);
+  }
+
+  SUBCASE("fixed_length_bruteforce")
+  {
+    static constexpr auto alphabet = itsp3::makeAlphabet<'a', 'e'>();
+
+    std::string words{};
+    CHECK(
+      itsp3::fixedLengthBruteforce<alphabet, 2U>(
+        [&words](std::string_view word) {
+          words.append(word.begin(), word.end()) += ' ';
+          return word == "ba";
+        })
+      == "ba");
+
+    // the same order as bruteforce.
+    CHECK(words == "aa ab ac ad ba ");
+
+    CHECK(
+      itsp3::fixedLengthBruteforce<alphabet, 5U>(makePasswordChecker("dcbad"))
+      == "dcbad");
+
+    CHECK(
+      itsp3::fixedLengthBruteforce<alphabet, 0U>(makePasswordChecker(""))
+      == "");
+
+    bool hasThrown{false};
+
+    try {
+      itsp3::fixedLengthBruteforce<alphabet, 3U>(makePasswordChecker("ab"));
+    }
+    catch (const itsp3::KeyspaceExhaustedException& ex) {
+      hasThrown = true;
+      CHECK(ex.getMinLength() == 3U);
+      CHECK(ex.getMaxLength() == 3U);
+      CHECK(ex.getCandidateCount() == 64U);
+    }
+
+    CHECK_UNARY(hasThrown);
+  }
 }
@@ -0,0 +1,238 @@
+#include "alphabets.hpp"       // itsp3::makeAlphabet
+#include "bruteforce.hpp"      // itsp3::bruteforce
+#include "candidate_batch.hpp" // itsp3::CandidateBatch, ...
+#include "crack_target.hpp"    // itsp3::CrackTarget
+#include "hashing_backend.hpp" // itsp3::BcryptLibraryBackend
+#include <ciso646>             // not, or
+#include <cstddef>             // std::size_t
+#include <doctest.h>
+#include <optional>    // std::optional
+#include <string>      // std::string
+#include <string_view> // std::string_view
+#include <vector>      // std::vector
+
+namespace {
+/*!
+ * \brief Module local function to pull all the candidates of a source.
+ * \param source The source.
+ * \param batch The batch to pull the candidates into.
+ * \return The candidates.
+ **/
+template<typename Source>
+std::vector<std::string> collect(Source& source, itsp3::CandidateBatch& batch)
+{
+  std::vector<std::string> candidates{};
+
+  while (source.next(batch)) {
+    CHECK_UNARY_FALSE(batch.empty());
+
+    for (std::string_view candidate : batch) {
+      candidates.emplace_back(candidate);
+    }
+  }
+
+  CHECK_UNARY(batch.empty());
+  return candidates;
+}
+} // anonymous namespace
+
+TEST_CASE("candidate_batch_test")
+{
+  static constexpr auto alphabet = itsp3::makeAlphabet<'a', 'd'>();
+
+  SUBCASE("batch")
+  {
+    itsp3::CandidateBatch batch{3U, 4U};
+    CHECK(batch.getCapacity() == 3U);
+    CHECK(batch.getMaxLength() == 4U);
+    CHECK_UNARY(batch.empty());
+
+    CHECK_UNARY(batch.push("abcd"));
+    CHECK_UNARY_FALSE(batch.push("abcde"));
+    CHECK_UNARY(batch.push(""));
+    CHECK_UNARY(batch.push("xy"));
+    CHECK_UNARY(batch.isFull());
+    REQUIRE(batch.size() == 3U);
+    CHECK(batch[0U] == "abcd");
+    CHECK(batch[1U] == "");
+    CHECK(batch[2U] == "xy");
+    CHECK(batch.data()[2U] == "xy");
+
+    // all the candidates are in the same buffer.
+    CHECK(batch[2U].data() == batch[0U].data() + 2U * 4U);
+
+    batch.clear();
+    CHECK_UNARY(batch.empty());
+    CHECK(batch.begin() == batch.end());
+  }
+
+  SUBCASE("odometer_source_generates_the_words_of_bruteforce")
+  {
+    std::vector<std::string> expected{};
+
+    try {
+      itsp3::bruteforce(
+        [&expected](const std::string& word) {
+          expected.push_back(word);
+          return false;
+        },
+        alphabet,
+        1U,
+        3U);
+    }
+    catch (const itsp3::KeyspaceExhaustedException&) {
+    }
+
+    for (std::size_t capacity : {1U, 4U, 39U, 100U}) {
+      itsp3::OdometerSource source{alphabet, 1U, 3U};
+      itsp3::CandidateBatch batch{capacity, 3U};
+      CHECK(collect(source, batch) == expected);
+    }
+
+    itsp3::OdometerSource empty{alphabet, 2U, 1U};
+    itsp3::CandidateBatch batch{4U, 2U};
+    CHECK_UNARY(collect(empty, batch).empty());
+  }
+
+  SUBCASE("keyspace_range_source")
+  {
+    itsp3::KeyspaceRangeSource source{alphabet, 3U};
+    itsp3::CandidateBatch      batch{4U, 3U};
+    CHECK_UNARY(collect(source, batch).empty());
+
+    // "abc" is at index 5 among the words of length 3.
+    source.seek(3U, itsp3::KeyspaceRange{5U, 12U});
+    REQUIRE_UNARY(source.next(batch));
+    CHECK(source.getIndex() == 9U);
+    CHECK(
+      std::vector<std::string>(batch.begin(), batch.end())
+      == std::vector<std::string>{"abc", "aca", "acb", "acc"});
+
+    source.truncate(100U);
+    source.truncate(10U);
+    CHECK(collect(source, batch) == std::vector<std::string>{"baa"});
+    CHECK(source.getIndex() == 10U);
+
+    // the words already generated are not taken back.
+    source.truncate(3U);
+    CHECK(source.getIndex() == 10U);
+
+    // the last word of a length.
+    source.seek(2U, itsp3::KeyspaceRange{7U, 9U});
+    CHECK(collect(source, batch) == std::vector<std::string>{"cb", "cc"});
+
+    // checks the words in place.
+    source.seek(1U, itsp3::KeyspaceRange{0U, 3U});
+    const auto isB = [](std::string_view word) { return word == "b"; };
+    const std::optional<itsp3::KeyspaceIndex> index{source.find(isB, 2U)};
+    REQUIRE_UNARY(index.has_value());
+    CHECK(*index == 1U);
+    CHECK(source.getIndex() == 2U);
+    CHECK_UNARY_FALSE(source.find(isB, 5U).has_value());
+    CHECK_UNARY(source.isExhausted());
+  }
+
+  SUBCASE("wordlist_source")
+  {
+    itsp3::WordlistSource source{"ab\r\n\nabcdef\ncd\n\nefg"};
+    itsp3::CandidateBatch batch{2U, 4U};
+    CHECK(
+      collect(source, batch) == std::vector<std::string>{"ab", "cd", "efg"});
+  }
+
+  SUBCASE("adapters")
+  {
+    auto source = itsp3::transformCandidates(
+      itsp3::filterCandidates(
+        itsp3::OdometerSource{alphabet, 1U, 2U},
+        [](std::string_view candidate) { return candidate[0U] != 'b'; }),
+      [](std::string_view candidate, std::string& out) {
+        out.assign(candidate.begin(), candidate.end());
+        out += '1';
+      });
+
+    itsp3::CandidateBatch batch{2U, 3U};
+    CHECK(
+      collect(source, batch)
+      == std::vector<std::string>{
+           "a1", "c1", "aa1", "ab1", "ac1", "ca1", "cb1", "cc1"});
+  }
+
+  SUBCASE("find_in_batches")
+  {
+    itsp3::OdometerSource source{alphabet, 0U, 3U};
+    itsp3::CandidateBatch batch{5U, 3U};
+    std::size_t           batchCount{0U};
+
+    const std::optional<std::string> match{itsp3::findInBatches(
+      source, batch, [&batchCount](const itsp3::CandidateBatch& candidates) {
+        ++batchCount;
+        std::optional<std::size_t> index{};
+
+        for (std::size_t i{0U}; i < candidates.size(); ++i) {
+          if (candidates[i] == "ba" or candidates[i] == "bb") {
+            index = i;
+            break;
+          }
+        }
+
+        return index;
+      })};
+
+    REQUIRE_UNARY(match.has_value());
+    CHECK(*match == "ba");
+    CHECK(batchCount == 2U);
+
+    itsp3::OdometerSource rest{alphabet, 4U, 3U};
+    CHECK_UNARY_FALSE(
+      itsp3::findInBatches(rest, batch, [](const itsp3::CandidateBatch&) {
+        return std::optional<std::size_t>{0U};
+      }).has_value());
+  }
+
+  SUBCASE("crack_target_checks_batches")
+  {
+    itsp3::BcryptLibraryBackend backend{
+      itsp3::BcryptLibraryBackend::s_minimumWorkFactor};
+    itsp3::HashBuffer salt{};
+    itsp3::HashBuffer hash{};
+    REQUIRE_UNARY(backend.generateSalt(salt));
+    REQUIRE_UNARY(backend.hash("Petercab", salt, hash));
+
+    const itsp3::CrackTarget target{"Peter", hash.data()};
+
+    itsp3::OdometerSource source{alphabet, 0U, 3U};
+    itsp3::CandidateBatch batch{17U, 3U};
+    std::optional<std::string> match{itsp3::findInBatches(
+      source, batch, [&target](const itsp3::CandidateBatch& candidates) {
+        return target.findIn(candidates);
+      })};
+
+    REQUIRE_UNARY(match.has_value());
+    CHECK(*match == "cab");
+
+    itsp3::CandidateBatch tooLong{2U, BCRYPT_HASHSIZE + 1U};
+    REQUIRE_UNARY(tooLong.push(std::string(BCRYPT_HASHSIZE + 1U, 'c')));
+    REQUIRE_UNARY(tooLong.push("cab"));
+    const std::optional<std::size_t> index{target.findIn(tooLong)};
+    REQUIRE_UNARY(index.has_value());
+    CHECK(*index == 1U);
+
+    // spans several groups of lanes.
+    itsp3::CandidateBatch large{40U, 3U};
+
+    while (not large.isFull()) {
+      large.push(large.size() < 35U ? "abc" : "cab");
+    }
+
+    const std::optional<std::size_t> first{target.findIn(large)};
+    REQUIRE_UNARY(first.has_value());
+    CHECK(*first == 35U);
+
+    // "cab" is too short to satisfy the policy, so it is not checked.
+    itsp3::PasswordPolicy policy{itsp3::PasswordPolicy::none()};
+    CHECK(target.findIn(large, policy) == first);
+    policy.minLength = 4U;
+    CHECK_UNARY_FALSE(target.findIn(large, policy).has_value());
+  }
+}
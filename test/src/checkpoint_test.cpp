@@ -0,0 +1,220 @@
+#include "alphabets.hpp"           // itsp3::makeAlphabet
+#include "checkpoint.hpp"          // itsp3::Checkpoint, itsp3::Checkpointer
+#include "parallel_bruteforce.hpp" // itsp3::parallelBruteforce
+#include "work_stealing.hpp"       // itsp3::WorkStealingScheduler
+#include <ciso646>                 // and, or, not
+#include <cstdio>                  // std::remove
+#include <doctest.h>
+#include <fstream>     // std::ofstream, std::ifstream
+#include <iterator>    // std::istreambuf_iterator
+#include <optional>    // std::optional
+#include <string>      // std::string
+#include <string_view> // std::string_view
+#include <vector>      // std::vector
+
+namespace {
+constexpr char testFilePath[] = "./checkpoint_test.bin";
+
+bool operator==(
+  const itsp3::KeyspaceRange& lhs,
+  const itsp3::KeyspaceRange& rhs)
+{
+  return lhs.begin == rhs.begin and lhs.end == rhs.end;
+}
+
+bool operator==(
+  const std::vector<itsp3::KeyspaceRange>& lhs,
+  const std::vector<itsp3::KeyspaceRange>& rhs)
+{
+  if (lhs.size() != rhs.size()) {
+    return false;
+  }
+
+  for (std::size_t i{0U}; i < lhs.size(); ++i) {
+    if (not(lhs[i] == rhs[i])) {
+      return false;
+    }
+  }
+
+  return true;
+}
+} // anonymous namespace
+
+TEST_CASE("checkpoint_test")
+{
+  std::remove(testFilePath);
+
+  SUBCASE("merges_completed_ranges")
+  {
+    itsp3::Checkpoint checkpoint{"user", "abc"};
+    checkpoint.setWordLength(3U);
+
+    checkpoint.markCompleted({10U, 20U});
+    checkpoint.markCompleted({0U, 5U});
+    checkpoint.markCompleted({5U, 5U}); // empty -> ignored
+    CHECK(
+      checkpoint.getCompletedRanges()
+      == std::vector<itsp3::KeyspaceRange>{{0U, 5U}, {10U, 20U}});
+
+    checkpoint.markCompleted({20U, 22U});
+    checkpoint.markCompleted({4U, 11U});
+    CHECK(
+      checkpoint.getCompletedRanges()
+      == std::vector<itsp3::KeyspaceRange>{{0U, 22U}});
+    CHECK(checkpoint.getCompletedCount() == 22U);
+    CHECK(
+      checkpoint.getRemainingRanges(27U)
+      == std::vector<itsp3::KeyspaceRange>{{22U, 27U}});
+
+    checkpoint.markCompleted({24U, 25U});
+    CHECK(
+      checkpoint.getRemainingRanges(27U)
+      == std::vector<itsp3::KeyspaceRange>{{22U, 24U}, {25U, 27U}});
+
+    // advancing to the next word length forgets the ranges.
+    checkpoint.setWordLength(4U);
+    CHECK(checkpoint.getCompletedRanges().empty());
+    CHECK(
+      checkpoint.getRemainingRanges(81U)
+      == std::vector<itsp3::KeyspaceRange>{{0U, 81U}});
+  }
+
+  SUBCASE("save_and_load")
+  {
+    itsp3::Checkpoint checkpoint{"some user", "0123456789"};
+    checkpoint.setWordLength(9U);
+    checkpoint.markCompleted({7U, 1000U});
+    checkpoint.markCompleted({5000U, 999999999U});
+    checkpoint.save(testFilePath);
+
+    const itsp3::Checkpoint loaded{itsp3::Checkpoint::load(testFilePath)};
+    CHECK(loaded.getTarget() == "some user");
+    CHECK(loaded.getAlphabet() == "0123456789");
+    CHECK(loaded.getWordLength() == 9U);
+    CHECK(loaded.getCompletedRanges() == checkpoint.getCompletedRanges());
+  }
+
+  SUBCASE("load_rejects_invalid_files")
+  {
+    CHECK_THROWS_AS(
+      itsp3::Checkpoint::load(testFilePath), itsp3::CheckpointException);
+
+    {
+      std::ofstream ofs{testFilePath, std::ios_base::binary};
+      ofs << "not a checkpoint";
+    }
+
+    CHECK_THROWS_AS(
+      itsp3::Checkpoint::load(testFilePath), itsp3::CheckpointException);
+
+    // truncated
+    itsp3::Checkpoint checkpoint{"user", "ab"};
+    checkpoint.setWordLength(2U);
+    checkpoint.markCompleted({1U, 3U});
+    checkpoint.save(testFilePath);
+
+    std::string contents{};
+
+    {
+      std::ifstream ifs{testFilePath, std::ios_base::binary};
+      contents.assign(
+        std::istreambuf_iterator<char>{ifs},
+        std::istreambuf_iterator<char>{});
+    }
+
+    {
+      std::ofstream ofs{testFilePath, std::ios_base::binary};
+      ofs << contents.substr(0U, contents.size() - 1U);
+    }
+
+    CHECK_THROWS_AS(
+      itsp3::Checkpoint::load(testFilePath), itsp3::CheckpointException);
+  }
+
+  SUBCASE("scheduler_hands_out_only_the_remaining_ranges")
+  {
+    const std::vector<itsp3::KeyspaceRange> ranges{
+      {3U, 10U}, {20U, 21U}, {40U, 50U}};
+
+    for (std::size_t workerCount : {1U, 2U, 5U}) {
+      itsp3::WorkStealingScheduler scheduler{ranges, workerCount};
+      std::vector<int>             timesHandedOut(50U, 0);
+
+      for (std::size_t worker{0U}; worker < workerCount; ++worker) {
+        while (const std::optional<itsp3::KeyspaceRange> chunk{
+                 scheduler.next(worker, 4U)}) {
+          for (itsp3::KeyspaceIndex i{chunk->begin}; i != chunk->end; ++i) {
+            ++timesHandedOut[static_cast<std::size_t>(i)];
+          }
+        }
+      }
+
+      for (std::size_t i{0U}; i < timesHandedOut.size(); ++i) {
+        const bool isRemaining{
+          (i >= 3U and i < 10U) or i == 20U or (i >= 40U and i < 50U)};
+        CHECK(timesHandedOut[i] == (isRemaining ? 1 : 0));
+      }
+    }
+  }
+
+  SUBCASE("parallel_bruteforce_resumes_from_the_checkpoint")
+  {
+    static constexpr auto alphabet = itsp3::makeAlphabet<'a', 'e'>();
+
+    // "ab" and "ca" match, "ab" is index 1, "ca" is index 8 of length 2.
+    const auto doesMatch = [](std::string_view word) {
+      return word == "ab" or word == "ca";
+    };
+
+    itsp3::Checkpoint checkpoint{"user", "abcd"};
+    checkpoint.setWordLength(2U);
+    checkpoint.markCompleted({0U, 4U});
+
+    itsp3::Checkpointer checkpointer{testFilePath, checkpoint};
+    CHECK(
+      itsp3::parallelBruteforce(doesMatch, alphabet, 2U, &checkpointer)
+      == "ca");
+
+    // the word length was saved when it was begun.
+    CHECK(itsp3::Checkpoint::load(testFilePath).getWordLength() == 2U);
+  }
+
+  SUBCASE("parallel_bruteforce_records_its_progress")
+  {
+    static constexpr auto alphabet = itsp3::makeAlphabet<'a', 'e'>();
+
+    itsp3::Checkpointer checkpointer{
+      testFilePath, itsp3::Checkpoint{"user", "abcd"}};
+
+    // "dddd" is the last word of length 4.
+    CHECK(
+      itsp3::parallelBruteforce(
+        [](std::string_view word) { return word == "dddd"; },
+        alphabet,
+        3U,
+        &checkpointer)
+      == "dddd");
+
+    const itsp3::Checkpoint recorded{checkpointer.getCheckpoint()};
+    CHECK(recorded.getWordLength() == 4U);
+    CHECK(recorded.getCompletedCount() == 255U);
+
+    checkpointer.save();
+    CHECK(itsp3::Checkpoint::load(testFilePath).getCompletedCount() == 255U);
+  }
+
+  SUBCASE("parallel_bruteforce_rejects_other_alphabets")
+  {
+    static constexpr auto alphabet = itsp3::makeAlphabet<'a', 'e'>();
+
+    itsp3::Checkpointer checkpointer{
+      testFilePath, itsp3::Checkpoint{"user", "abc"}};
+
+    CHECK_THROWS_AS(
+      itsp3::parallelBruteforce(
+        [](std::string_view) { return true; }, alphabet, 1U, &checkpointer),
+      itsp3::CheckpointException);
+  }
+
+  std::remove(testFilePath);
+}
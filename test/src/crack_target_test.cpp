@@ -0,0 +1,125 @@
+#include "add_user_result.hpp" // itsp3::AddUserResult
+#include "bcrypt.hpp"          // itsp3::Bcrypt
+#include "crack_target.hpp"    // itsp3::CrackTarget
+#include "hashing_backend.hpp" // itsp3::BcryptLibraryBackend
+#include <cstdio>              // std::remove
+#include <doctest.h>
+#include <memory>   // std::shared_ptr, std::make_shared
+#include <optional> // std::optional
+#include <string>   // std::string
+
+TEST_CASE("crack_target_test")
+{
+  static constexpr char testBinFile[] = "./crack_target_test.bin";
+  std::remove(testBinFile);
+
+  const std::shared_ptr<itsp3::BcryptLibraryBackend> backend{
+    std::make_shared<itsp3::BcryptLibraryBackend>(
+      itsp3::BcryptLibraryBackend::s_minimumWorkFactor)};
+  itsp3::Bcrypt bcrypt{testBinFile, backend};
+
+  REQUIRE_UNARY(bcrypt.addUser("Peter", "dummybA1{"));
+
+  SUBCASE("checks_like_check_password_validity")
+  {
+    const std::optional<itsp3::CrackTarget> target{
+      bcrypt.prepareCrackTarget("Peter")};
+    REQUIRE_UNARY(target.has_value());
+
+    CHECK(target->getUsername() == "Peter");
+    CHECK(
+      target->getCost() == itsp3::BcryptLibraryBackend::s_minimumWorkFactor);
+    CHECK(target->getSalt().size() == itsp3::CrackTarget::s_saltLength);
+
+    for (const char* password :
+         {"dummybA1{", "dummybA1", "dummybA1{{", "", "Peter"}) {
+      CHECK(
+        target->check(password)
+        == bcrypt.checkPasswordValidity("Peter", password));
+    }
+
+    CHECK_UNARY(target->check("dummybA1{"));
+    CHECK_UNARY_FALSE(target->check(std::string(BCRYPT_HASHSIZE + 1U, 'a')));
+  }
+
+  SUBCASE("unknown_users")
+  {
+    CHECK_UNARY_FALSE(bcrypt.prepareCrackTarget("Hannes").has_value());
+    CHECK_UNARY_FALSE(
+      bcrypt.prepareCrackTarget(std::string(BCRYPT_HASHSIZE + 1U, 'a'))
+        .has_value());
+  }
+
+  SUBCASE("rejects_invalid_hashes")
+  {
+    for (const char* hash :
+         {"",
+          "not a hash",
+          "$2a$02$abcdefghijklmnopqrstuuabcdefghijklmnopqrstuvwxyz01234",
+          "$2a$1a$abcdefghijklmnopqrstuuabcdefghijklmnopqrstuvwxyz01234",
+          "$3a$05$abcdefghijklmnopqrstuuabcdefghijklmnopqrstuvwxyz01234",
+          "$2a$05$abcdefghijklmnopqrstuuabcdefghijklmnopqrstuvwxyz0123!",
+          "$2a$05$abcdefghijklmnopqrstuuabcdefghijklmnopqrstuvwxyz012345",
+          // the unused bits of the last character of the digest are set.
+          "$2a$05$abcdefghijklmnopqrstuuabcdefghijklmnopqrstuvwxyz01234"}) {
+      CHECK_THROWS_AS(
+        (itsp3::CrackTarget{"Peter", hash}), itsp3::CrackTargetException);
+    }
+
+    CHECK_NOTHROW((itsp3::CrackTarget{
+      "Peter",
+      "$2a$05$abcdefghijklmnopqrstuuabcdefghijklmnopqrstuvwxyz01232"}));
+  }
+
+  SUBCASE("truncated_passwords")
+  {
+    // bcrypt only uses the first 72 bytes of username + password.
+    const std::string username(BCRYPT_HASHSIZE, 'u');
+    CHECK(itsp3::significantPasswordLength(username.size()) == 8U);
+    CHECK(itsp3::significantPasswordLength(80U) == 0U);
+
+    const itsp3::AddUserResult result{
+      bcrypt.addUser(username, "dummybA1{xyz")};
+    REQUIRE_UNARY(result);
+    REQUIRE_UNARY(result.getWarning().has_value());
+    CHECK(
+      result.getWarning()->find("Only the first 8 characters")
+      != std::string::npos);
+    CHECK_UNARY_FALSE(
+      bcrypt.addUser("Hannes", "dummybA1{").getWarning().has_value());
+
+    const std::optional<itsp3::CrackTarget> target{
+      bcrypt.prepareCrackTarget(username)};
+    REQUIRE_UNARY(target.has_value());
+    CHECK(target->getMaxPasswordLength() == 8U);
+
+    // the prefix of the password has the same hash.
+    CHECK_UNARY(target->check("dummybA1"));
+    CHECK_UNARY(target->check("dummybA1{abc"));
+    CHECK_UNARY_FALSE(target->check("dummybA"));
+
+    const std::optional<itsp3::CrackTarget> peter{
+      bcrypt.prepareCrackTarget("Peter")};
+    REQUIRE_UNARY(peter.has_value());
+    CHECK(peter->getMaxPasswordLength() == BCRYPT_HASHSIZE);
+
+    itsp3::PasswordPolicy policy{itsp3::PasswordPolicy::none()};
+    policy.requiresNumber = true;
+
+    // longer candidates are equivalent to their prefix of length 8, which
+    // is checked even if only the longer ones satisfy the policy.
+    CHECK_UNARY(target->isWorthChecking("dummybAa", policy));
+    CHECK_UNARY_FALSE(target->isWorthChecking("dummybA1{", policy));
+    CHECK_UNARY_FALSE(target->isWorthChecking("dummyba", policy));
+    CHECK_UNARY(target->isWorthChecking("dummyb1", policy));
+    CHECK_UNARY_FALSE(peter->isWorthChecking("dummybAa", policy));
+
+    // the minimum length takes precedence.
+    policy.minLength = 10U;
+    CHECK_UNARY(target->isWorthChecking("dummybAaaa", policy));
+    CHECK_UNARY_FALSE(target->isWorthChecking("dummybAaa", policy));
+    CHECK_UNARY_FALSE(target->isWorthChecking("dummybAaaaa", policy));
+  }
+
+  std::remove(testBinFile);
+}
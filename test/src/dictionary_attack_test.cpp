@@ -0,0 +1,160 @@
+#include "dictionary_attack.hpp" // itsp3::dictionaryAttack
+#include "mapped_file.hpp"       // itsp3::MappedFile
+#include <atomic>                // std::atomic
+#include <chrono>                // std::chrono::milliseconds
+#include <cstddef>               // std::size_t
+#include <cstdio>                // std::remove
+#include <doctest.h>
+#include <fstream>     // std::ofstream
+#include <mutex>       // std::mutex, std::lock_guard
+#include <stdexcept>   // std::runtime_error
+#include <string>      // std::string, std::to_string
+#include <string_view> // std::string_view
+#include <vector>      // std::vector
+
+namespace {
+constexpr char testFilePath[] = "./dictionary_attack_test.txt";
+} // anonymous namespace
+
+TEST_CASE("dictionary_attack_test")
+{
+  std::string wordlist{};
+
+  for (std::size_t i{0U}; i < 5000U; ++i) {
+    wordlist += "word" + std::to_string(i) + (i % 3U == 0U ? "\r\n" : "\n");
+  }
+
+  wordlist += "\n\nlast"; // empty lines and no trailing newline
+
+  SUBCASE("tries_every_word_exactly_once")
+  {
+    for (std::size_t threadCount : {1U, 2U, 7U}) {
+      std::mutex               mutex{};
+      std::vector<std::string> words{};
+
+      itsp3::DictionaryAttackOptions options{};
+      options.threadCount = threadCount;
+
+      bool hasThrown{false};
+
+      try {
+        itsp3::dictionaryAttack(
+          [&mutex, &words](std::string_view word) {
+            std::lock_guard<std::mutex> lock{mutex};
+            words.emplace_back(word);
+            return false;
+          },
+          wordlist,
+          options);
+      }
+      catch (const itsp3::WordlistExhaustedException&) {
+        hasThrown = true;
+      }
+
+      CHECK_UNARY(hasThrown);
+      REQUIRE(words.size() == 5001U);
+
+      std::vector<int> timesTried(5001U, 0);
+
+      for (const std::string& word : words) {
+        if (word == "last") {
+          ++timesTried[5000U];
+        }
+        else {
+          REQUIRE(word.substr(0U, 4U) == "word");
+          ++timesTried[std::stoul(word.substr(4U))];
+        }
+      }
+
+      for (int times : timesTried) {
+        CHECK(times == 1);
+      }
+    }
+  }
+
+  SUBCASE("finds_the_match")
+  {
+    for (const char* password : {"word0", "word3", "word2500", "last"}) {
+      CHECK(
+        itsp3::dictionaryAttack(
+          [password](std::string_view word) { return word == password; },
+          wordlist)
+        == password);
+    }
+
+    CHECK_THROWS_AS(
+      itsp3::dictionaryAttack([](std::string_view) { return true; }, ""),
+      itsp3::WordlistExhaustedException);
+  }
+
+  SUBCASE("reports_the_progress")
+  {
+    std::vector<itsp3::DictionaryProgress> reports{};
+
+    itsp3::DictionaryAttackOptions options{};
+    options.threadCount      = 3U;
+    options.progressInterval = std::chrono::milliseconds{1};
+    options.onProgress = [&reports](const itsp3::DictionaryProgress& progress) {
+      reports.push_back(progress);
+    };
+
+    CHECK_THROWS_AS(
+      itsp3::dictionaryAttack(
+        [](std::string_view) { return false; }, wordlist, options),
+      itsp3::WordlistExhaustedException);
+
+    REQUIRE_UNARY_FALSE(reports.empty());
+
+    for (std::size_t i{1U}; i < reports.size(); ++i) {
+      CHECK(reports[i].byteOffset >= reports[i - 1U].byteOffset);
+    }
+
+    CHECK(reports.back().byteOffset == wordlist.size());
+    CHECK(reports.back().totalBytes == wordlist.size());
+    CHECK(reports.back().candidateCount == 5001U);
+  }
+
+  SUBCASE("rethrows_exceptions_of_the_matcher")
+  {
+    CHECK_THROWS_AS(
+      itsp3::dictionaryAttack(
+        [](std::string_view word) -> bool {
+          if (word == "word42") {
+            throw std::runtime_error{"test"};
+          }
+
+          return false;
+        },
+        wordlist),
+      std::runtime_error);
+  }
+
+  SUBCASE("mapped_file")
+  {
+    {
+      std::ofstream ofs{testFilePath, std::ios_base::binary};
+      ofs << wordlist;
+    }
+
+    {
+      const itsp3::MappedFile file{testFilePath};
+      CHECK(file.getSize() == wordlist.size());
+      CHECK(file.getContents() == wordlist);
+      CHECK(
+        itsp3::dictionaryAttack(
+          [](std::string_view word) { return word == "word4999"; },
+          file.getContents())
+        == "word4999");
+    }
+
+    {
+      std::ofstream ofs{testFilePath, std::ios_base::binary};
+    }
+
+    CHECK(itsp3::MappedFile{testFilePath}.getContents().empty());
+
+    std::remove(testFilePath);
+    CHECK_THROWS_AS(
+      itsp3::MappedFile{testFilePath}, itsp3::MappedFileException);
+  }
+}
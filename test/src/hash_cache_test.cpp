@@ -0,0 +1,117 @@
+#include "hash_cache.hpp" // itsp3::HashCache
+#include <ciso646>        // not
+#include <cstddef>        // std::size_t
+#include <cstdint>        // std::uint64_t
+#include <doctest.h>
+#include <string> // std::string, std::to_string
+#include <thread> // std::thread
+#include <vector> // std::vector
+
+TEST_CASE("hash_cache_test")
+{
+  static const std::string hash(64U, 'h');
+
+  SUBCASE("counts_hits_and_misses")
+  {
+    itsp3::HashCache cache{};
+
+    CHECK_UNARY_FALSE(cache.find("Peter"));
+    cache.insert("Peter", hash);
+    REQUIRE_UNARY(cache.find("Peter"));
+    CHECK(*cache.find("Peter") == hash);
+
+    CHECK(cache.getHitCount() == 2U);
+    CHECK(cache.getMissCount() == 1U);
+    CHECK(cache.getEntryCount() == 1U);
+  }
+
+  SUBCASE("insert_updates_existing_entry")
+  {
+    itsp3::HashCache cache{};
+
+    cache.insert("Peter", "old");
+    cache.insert("Peter", hash);
+
+    REQUIRE_UNARY(cache.find("Peter"));
+    CHECK(*cache.find("Peter") == hash);
+    CHECK(cache.getEntryCount() == 1U);
+  }
+
+  SUBCASE("stays_within_byte_budget")
+  {
+    static constexpr std::size_t byteBudget{4096U};
+    itsp3::HashCache             cache{byteBudget, 1U};
+
+    for (int i{0}; i < 1000; ++i) {
+      cache.insert("user" + std::to_string(i), hash);
+      CHECK(cache.getByteSize() <= byteBudget);
+    }
+
+    CHECK(cache.getEntryCount() < 1000U);
+    CHECK_UNARY(cache.find("user999"));
+    CHECK_UNARY_FALSE(cache.find("user0"));
+  }
+
+  SUBCASE("evicts_least_recently_used_entry")
+  {
+    itsp3::HashCache cache{1U << 20U, 1U};
+
+    // fill the cache until it starts evicting.
+    int count{0};
+    cache.insert("first", hash);
+    cache.insert("second", hash);
+
+    while (cache.getEntryCount() == static_cast<std::size_t>(count) + 2U) {
+      // keep "first" recently used, "second" will be evicted first.
+      REQUIRE_UNARY(cache.find("first"));
+      cache.insert("filler" + std::to_string(count), hash);
+      ++count;
+    }
+
+    CHECK_UNARY(cache.find("first"));
+    CHECK_UNARY_FALSE(cache.find("second"));
+  }
+
+  SUBCASE("zero_byte_budget_disables_cache")
+  {
+    itsp3::HashCache cache{0U};
+
+    cache.insert("Peter", hash);
+
+    CHECK_UNARY_FALSE(cache.find("Peter"));
+    CHECK(cache.getEntryCount() == 0U);
+  }
+
+  SUBCASE("concurrent_lookups")
+  {
+    static constexpr int threadCount{8};
+    static constexpr int lookupsPerThread{10000};
+    itsp3::HashCache     cache{};
+
+    for (int i{0}; i < 64; ++i) {
+      cache.insert("user" + std::to_string(i), hash);
+    }
+
+    std::vector<std::thread> threads{};
+
+    for (int t{0}; t < threadCount; ++t) {
+      threads.emplace_back([&cache, t] {
+        for (int i{0}; i < lookupsPerThread; ++i) {
+          const std::string username{"user" + std::to_string((i + t) % 64)};
+          if (not cache.find(username)) {
+            cache.insert(username, hash);
+          }
+        }
+      });
+    }
+
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+
+    CHECK(
+      cache.getHitCount() + cache.getMissCount()
+      == static_cast<std::uint64_t>(threadCount * lookupsPerThread));
+    CHECK(cache.getMissCount() == 0U);
+  }
+}
@@ -0,0 +1,128 @@
+#include "alphabets.hpp"  // itsp3::asciiAlphabet, itsp3::makeAlphabet
+#include "bruteforce.hpp" // itsp3::bruteforce
+#include "keyspace.hpp"   // itsp3::Keyspace
+#include <cstddef>        // std::size_t
+#include <doctest.h>
+#include <string>      // std::string
+#include <string_view> // std::string_view
+#include <vector>      // std::vector
+
+TEST_CASE("keyspace_test")
+{
+  static constexpr auto alphabet = itsp3::makeAlphabet<'a', 'e'>();
+
+  SUBCASE("size")
+  {
+    CHECK(itsp3::Keyspace<4U>{alphabet, 0U}.size() == 1U);
+    CHECK(itsp3::Keyspace<4U>{alphabet, 3U}.size() == 64U);
+    CHECK(
+      itsp3::Keyspace<4U>{alphabet, 0U, 3U}.size() == 1U + 4U + 16U + 64U);
+    CHECK(itsp3::Keyspace<4U>{alphabet, 2U, 3U}.size() == 16U + 64U);
+
+    const itsp3::Keyspace<4U> keyspace{alphabet, 1U, 3U};
+    CHECK(keyspace.getLengthOffset(1U) == 0U);
+    CHECK(keyspace.getLengthOffset(2U) == 4U);
+    CHECK(keyspace.getLengthOffset(3U) == 20U);
+    CHECK(keyspace.getLengthOffset(4U) == keyspace.size());
+
+    // 128^18 fits, 128^19 does not.
+    CHECK_NOTHROW(itsp3::Keyspace<0x80>(itsp3::asciiAlphabet, 18U));
+    CHECK_THROWS_AS(
+      itsp3::Keyspace<0x80>(itsp3::asciiAlphabet, 19U),
+      itsp3::KeyspaceTooLargeException);
+    CHECK_THROWS_AS(
+      itsp3::Keyspace<0x80>(itsp3::asciiAlphabet, 0U, 0x80U),
+      itsp3::KeyspaceTooLargeException);
+  }
+
+  SUBCASE("enumerates_in_the_order_of_bruteforce")
+  {
+    std::vector<std::string> expected{};
+
+    // collect all the words of lengths [0 .. 3] as generated by bruteforce.
+    bool hasFinished{false};
+    itsp3::bruteforce(
+      [&expected, &hasFinished](const std::string& word) {
+        if (word.size() > 3U) {
+          hasFinished = true;
+          return true;
+        }
+
+        expected.push_back(word);
+        return false;
+      },
+      alphabet);
+    REQUIRE_UNARY(hasFinished);
+
+    const itsp3::Keyspace<4U> keyspace{alphabet, 0U, 3U};
+    REQUIRE(keyspace.size() == expected.size());
+
+    std::size_t i{0U};
+
+    for (const std::string& word : keyspace) {
+      REQUIRE(i < expected.size());
+      CHECK(word == expected[i]);
+      CHECK(keyspace.unrank(i) == expected[i]);
+      CHECK(keyspace.rank(expected[i]) == i);
+      ++i;
+    }
+
+    CHECK(i == expected.size());
+  }
+
+  SUBCASE("ranges")
+  {
+    const itsp3::Keyspace<4U> keyspace{alphabet, 1U, 2U};
+
+    std::string words{};
+
+    for (const std::string& word : keyspace.range(2U, 7U)) {
+      words += word + ' ';
+    }
+
+    CHECK(words == "c d aa ab ac ");
+
+    CHECK(keyspace.range(5U, 5U).begin() == keyspace.range(5U, 5U).end());
+
+    auto it = keyspace.iteratorAt(19U);
+    CHECK(*it == "dd");
+    CHECK(it->size() == 2U);
+    CHECK(it.getIndex() == 19U);
+    ++it;
+    CHECK(it == keyspace.end());
+  }
+
+  SUBCASE("random_access_into_large_keyspaces")
+  {
+    const itsp3::Keyspace<0x80> keyspace{itsp3::asciiAlphabet, 0U, 18U};
+
+    const itsp3::KeyspaceIndex oneTrillion{1000000000000U};
+    const std::string          word{keyspace.unrank(oneTrillion)};
+    CHECK(keyspace.rank(word) == oneTrillion);
+
+    const itsp3::KeyspaceIndex last{keyspace.size() - 1U};
+    CHECK(keyspace.unrank(last) == std::string(18U, '\x7F'));
+    CHECK(keyspace.rank(std::string(18U, '\x7F')) == last);
+
+    // "password" written in base 128, offset by the shorter words.
+    itsp3::KeyspaceIndex expected{0U};
+
+    for (char character : std::string_view{"password"}) {
+      expected = expected * 0x80U + static_cast<unsigned char>(character);
+    }
+
+    CHECK(keyspace.rank("password") == keyspace.getLengthOffset(8U) + expected);
+  }
+
+  SUBCASE("rank_rejects_words_not_in_the_keyspace")
+  {
+    const itsp3::Keyspace<4U> keyspace{alphabet, 1U, 2U};
+
+    CHECK_UNARY(keyspace.contains("ad"));
+    CHECK_UNARY_FALSE(keyspace.contains(""));
+    CHECK_UNARY_FALSE(keyspace.contains("abc"));
+    CHECK_UNARY_FALSE(keyspace.contains("ae"));
+    CHECK_THROWS_AS(keyspace.rank("ae"), itsp3::NotInKeyspaceException);
+    CHECK_THROWS_AS(keyspace.rank("aaa"), itsp3::NotInKeyspaceException);
+  }
+}
@@ -0,0 +1,134 @@
+#include "alphabets.hpp"  // itsp3::makeAlphabet
+#include "bruteforce.hpp" // itsp3::bruteforce
+#include "markov.hpp"     // itsp3::MarkovModel, itsp3::MarkovOdometer
+#include <cstdio>         // std::remove
+#include <doctest.h>
+#include <fstream>     // std::ofstream
+#include <set>         // std::set
+#include <string>      // std::string
+#include <string_view> // std::string_view
+#include <vector>      // std::vector
+
+namespace {
+constexpr char testFilePath[] = "./markov_test.bin";
+} // anonymous namespace
+
+TEST_CASE("markov_test")
+{
+  static constexpr auto alphabet = itsp3::makeAlphabet<'a', 'e'>();
+
+  // 'd' mostly comes first, 'c' mostly follows 'd', 'a' follows 'c'.
+  // 'X' is not in the alphabet, so "ca" counts as a word of its own.
+  const itsp3::MarkovModel model{
+    itsp3::MarkovModel::train(alphabet, "dca\ndca\ndc\nd\nb\ndXca\n")};
+
+  SUBCASE("orders_the_successors_by_frequency")
+  {
+    CHECK(
+      std::string_view{model.successors(itsp3::MarkovModel::s_startState), 4U}
+      == "dbca");
+    CHECK(
+      std::string_view{model.successors(model.stateAfter('d')), 4U}
+      == "cabd");
+    CHECK(
+      std::string_view{model.successors(model.stateAfter('c')), 4U}
+      == "abcd");
+    // 'b' never had a successor -> the order of the alphabet.
+    CHECK(
+      std::string_view{model.successors(model.stateAfter('b')), 4U}
+      == "abcd");
+  }
+
+  SUBCASE("enumerates_the_same_keyspace_most_likely_first")
+  {
+    itsp3::MarkovOdometer odometer{model, 3U};
+    odometer.reset(3U);
+
+    CHECK(odometer.getWord() == "dca");
+
+    std::set<std::string>    words{};
+    std::vector<std::string> inOrder{};
+
+    do {
+      words.insert(odometer.getWord());
+      inOrder.push_back(odometer.getWord());
+    } while (odometer.advance());
+
+    CHECK(words.size() == 64U);
+    CHECK(inOrder.size() == 64U);
+    CHECK(odometer.getWord() == "dca"); // wrapped around
+
+    for (std::size_t i{0U}; i < inOrder.size(); ++i) {
+      itsp3::MarkovOdometer seeker{model, 3U};
+      seeker.seek(3U, i);
+      CHECK(seeker.getWord() == inOrder[i]);
+    }
+
+    odometer.reset(0U);
+    CHECK(odometer.getWord() == "");
+    CHECK_UNARY_FALSE(odometer.advance());
+  }
+
+  SUBCASE("markov_bruteforce_finds_what_bruteforce_finds")
+  {
+    for (const char* password : {"", "a", "dc", "bad", "cccc"}) {
+      const auto doesMatch = [password](std::string_view word) {
+        return word == password;
+      };
+
+      CHECK(
+        itsp3::markovBruteforce(doesMatch, model, 0U, 4U)
+        == itsp3::bruteforce(doesMatch, alphabet, 0U, 4U));
+    }
+
+    // the likely one is found first.
+    std::size_t candidateCount{0U};
+    itsp3::markovBruteforce(
+      [&candidateCount](std::string_view word) {
+        ++candidateCount;
+        return word == "dca";
+      },
+      model,
+      3U,
+      3U);
+    CHECK(candidateCount == 1U);
+
+    CHECK_THROWS_AS(
+      itsp3::markovBruteforce(
+        [](std::string_view) { return false; }, model, 1U, 2U),
+      itsp3::KeyspaceExhaustedException);
+  }
+
+  SUBCASE("save_and_load")
+  {
+    model.save(testFilePath);
+    const itsp3::MarkovModel loaded{itsp3::MarkovModel::load(testFilePath)};
+
+    CHECK(loaded.getAlphabet() == "abcd");
+
+    for (std::size_t state{0U}; state <= 4U; ++state) {
+      CHECK(
+        std::string_view{loaded.successors(state), 4U}
+        == std::string_view{model.successors(state), 4U});
+    }
+
+    {
+      std::ofstream ofs{testFilePath, std::ios_base::binary};
+      ofs << "not a model";
+    }
+
+    CHECK_THROWS_AS(
+      itsp3::MarkovModel::load(testFilePath), itsp3::MarkovModelException);
+    std::remove(testFilePath);
+    CHECK_THROWS_AS(
+      itsp3::MarkovModel::load(testFilePath), itsp3::MarkovModelException);
+  }
+
+  SUBCASE("rejects_invalid_alphabets")
+  {
+    CHECK_THROWS_AS(
+      itsp3::MarkovModel::train("", "abc"), itsp3::MarkovModelException);
+    CHECK_THROWS_AS(
+      itsp3::MarkovModel::train("aba", "abc"), itsp3::MarkovModelException);
+  }
+}
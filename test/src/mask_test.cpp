@@ -0,0 +1,130 @@
+#include "alphabets.hpp"  // itsp3::makeAlphabet
+#include "bruteforce.hpp" // itsp3::KeyspaceExhaustedException
+#include "mask.hpp"       // itsp3::Mask, itsp3::maskAttack
+#include <doctest.h>
+#include <string>      // std::string
+#include <string_view> // std::string_view
+#include <tuple>       // std::make_tuple
+#include <vector>      // std::vector
+
+TEST_CASE("mask_test")
+{
+  SUBCASE("parse")
+  {
+    const itsp3::Mask mask{itsp3::Mask::parse("?u?l?d?s?ax??")};
+    REQUIRE(mask.getLength() == 7U);
+    CHECK(mask.getAlphabet(0U) == "ABCDEFGHIJKLMNOPQRSTUVWXYZ");
+    CHECK(mask.getAlphabet(1U) == "abcdefghijklmnopqrstuvwxyz");
+    CHECK(mask.getAlphabet(2U) == "0123456789");
+    CHECK(mask.getAlphabet(3U).size() == 33U);
+    CHECK(mask.getAlphabet(4U).size() == 26U + 26U + 10U + 33U);
+    CHECK(mask.getAlphabet(5U) == "x");
+    CHECK(mask.getAlphabet(6U) == "?");
+    CHECK(mask.size() == 26U * 26U * 10U * 33U * 95U);
+
+    CHECK_UNARY(mask.matches("Pa5$Zx?"));
+    CHECK_UNARY_FALSE(mask.matches("pa5$Zx?"));
+    CHECK_UNARY_FALSE(mask.matches("Pa5$Zx"));
+
+    CHECK(itsp3::Mask::parse("").getLength() == 0U);
+    CHECK_THROWS_AS(itsp3::Mask::parse("?l?"), itsp3::InvalidMaskException);
+    CHECK_THROWS_AS(itsp3::Mask::parse("?x"), itsp3::InvalidMaskException);
+    CHECK_THROWS_AS(
+      (itsp3::Mask{std::vector<std::string>{"ab", ""}}),
+      itsp3::InvalidMaskException);
+  }
+
+  SUBCASE("prefix")
+  {
+    const itsp3::Mask mask{itsp3::Mask::parse("?dx?u")};
+    const itsp3::Mask prefix{mask.prefix(2U)};
+    REQUIRE(prefix.getLength() == 2U);
+    CHECK(prefix.getAlphabet(0U) == "0123456789");
+    CHECK(prefix.getAlphabet(1U) == "x");
+    CHECK(prefix.size() == 10U);
+
+    CHECK(mask.prefix(3U).getLength() == 3U);
+    CHECK(mask.prefix(10U).getLength() == 3U);
+    CHECK(mask.prefix(0U).getLength() == 0U);
+  }
+
+  SUBCASE("enumerates_only_the_words_of_the_mask")
+  {
+    const itsp3::Mask mask{itsp3::Mask::parse("?d-ab")};
+    CHECK(mask.size() == 10U);
+
+    std::string words{};
+    CHECK_THROWS_AS(
+      itsp3::maskAttack(
+        [&words](const std::string& word) {
+          words += word + ' ';
+          return false;
+        },
+        mask),
+      itsp3::KeyspaceExhaustedException);
+    CHECK(
+      words == "0-ab 1-ab 2-ab 3-ab 4-ab 5-ab 6-ab 7-ab 8-ab 9-ab ");
+  }
+
+  SUBCASE("runtime_and_compile_time_masks_agree")
+  {
+    const auto alphabets = std::make_tuple(
+      itsp3::makeAlphabet<'A', 'D'>(),
+      itsp3::makeAlphabet<'a', 'c'>(),
+      itsp3::makeAlphabet<'0', '4'>());
+    const itsp3::Mask mask{itsp3::Mask::fromAlphabets(alphabets)};
+    CHECK(mask.size() == 3U * 2U * 4U);
+
+    std::string runtimeWords{};
+    std::string compileTimeWords{};
+
+    try {
+      itsp3::maskAttack(
+        [&runtimeWords](const std::string& word) {
+          runtimeWords += word + ' ';
+          return false;
+        },
+        mask);
+    }
+    catch (const itsp3::KeyspaceExhaustedException& ex) {
+      CHECK(ex.getCandidateCount() == 24U);
+      CHECK(ex.getMinLength() == 3U);
+      CHECK(ex.getMaxLength() == 3U);
+    }
+
+    CHECK_THROWS_AS(
+      itsp3::maskAttack(
+        [&compileTimeWords](const std::string& word) {
+          compileTimeWords += word + ' ';
+          return false;
+        },
+        alphabets),
+      itsp3::KeyspaceExhaustedException);
+
+    CHECK(runtimeWords.substr(0U, 16U) == "Aa0 Aa1 Aa2 Aa3 ");
+    CHECK(runtimeWords == compileTimeWords);
+  }
+
+  SUBCASE("finds_the_match")
+  {
+    const auto doesMatch = [](std::string_view word) {
+      return word == "Pass12!";
+    };
+
+    CHECK(
+      itsp3::maskAttack(doesMatch, itsp3::Mask::parse("?uass?d?d?s"))
+      == "Pass12!");
+    CHECK(
+      itsp3::maskAttack(
+        doesMatch,
+        std::make_tuple(
+          itsp3::makeAlphabet<'A', '['>(),
+          itsp3::makeAlphabet<'a', 'b'>(),
+          itsp3::makeAlphabet<'a', '{'>(),
+          itsp3::makeAlphabet<'s', 't'>(),
+          itsp3::makeAlphabet<'0', ':'>(),
+          itsp3::makeAlphabet<'0', ':'>(),
+          itsp3::makeAlphabet<'!', '"'>()))
+      == "Pass12!");
+  }
+}
@@ -0,0 +1,68 @@
+#include "alphabets.hpp" // itsp3::makeAlphabet
+#include "keyspace.hpp"  // itsp3::Keyspace
+#include "odometer.hpp"  // itsp3::Odometer
+#include <cstddef>       // std::size_t
+#include <doctest.h>
+#include <string> // std::string
+
+TEST_CASE("odometer_test")
+{
+  static constexpr auto alphabet = itsp3::makeAlphabet<'a', 'd'>();
+
+  itsp3::Odometer<3U> odometer{alphabet, 4U};
+  CHECK(odometer.getWord() == "");
+  CHECK(odometer.getMaxLength() == 4U);
+
+  SUBCASE("advances_in_the_order_of_bruteforce")
+  {
+    odometer.reset(2U);
+
+    std::string words{};
+
+    do {
+      words += odometer.getWord() + ' ';
+    } while (odometer.advance());
+
+    CHECK(words == "aa ab ac ba bb bc ca cb cc ");
+
+    // wrapped around to the first word.
+    CHECK(odometer.getWord() == "aa");
+  }
+
+  SUBCASE("the_empty_word_is_the_only_word_of_length_0")
+  {
+    odometer.reset(0U);
+    CHECK(odometer.getWord() == "");
+    CHECK_UNARY_FALSE(odometer.advance());
+  }
+
+  SUBCASE("seek_matches_the_keyspace")
+  {
+    const itsp3::Keyspace<3U> keyspace{alphabet, 4U};
+
+    for (itsp3::KeyspaceIndex i{0U}; i < keyspace.size(); ++i) {
+      odometer.seek(4U, i);
+      CHECK(odometer.getWord() == keyspace.unrank(i));
+    }
+
+    // advancing continues from where seek went.
+    odometer.seek(4U, 41U);
+    REQUIRE(odometer.advance());
+    CHECK(odometer.getWord() == keyspace.unrank(42U));
+  }
+
+  SUBCASE("does_not_reallocate")
+  {
+    odometer.reset(4U);
+    const char* const data{odometer.getWord().data()};
+
+    for (std::size_t wordLength : {0U, 3U, 1U, 4U, 2U}) {
+      odometer.reset(wordLength);
+
+      while (odometer.advance()) {
+      }
+
+      CHECK(odometer.getWord().data() == data);
+    }
+  }
+}
@@ -0,0 +1,190 @@
+#include "alphabets.hpp"           // itsp3::asciiAlphabet, itsp3::makeAlphabet
+#include "bruteforce.hpp"          // itsp3::bruteforce
+#include "candidate_batch.hpp"     // itsp3::CandidateBatch
+#include "parallel_bruteforce.hpp" // itsp3::parallelBruteforce, ...
+#include <atomic>                  // std::atomic
+#include <chrono>                  // std::chrono::milliseconds
+#include <ciso646>                 // not
+#include <cstddef>                 // std::size_t
+#include <doctest.h>
+#include <optional>    // std::optional, std::nullopt
+#include <set>         // std::set
+#include <stdexcept>   // std::runtime_error
+#include <string>      // std::string
+#include <string_view> // std::string_view
+#include <thread>      // std::this_thread::sleep_for
+#include <utility>     // std::move
+
+TEST_CASE("parallel_bruteforce_test")
+{
+  // accepts any of the passwords given.
+  auto makePasswordChecker = [](std::set<std::string> passwords) {
+    return [pws = std::move(passwords)](std::string_view input) {
+      return pws.count(std::string{input}) != 0U;
+    };
+  };
+
+  static constexpr auto alphabet = itsp3::makeAlphabet<'a', 'g'>();
+
+  SUBCASE("finds_the_same_password_as_bruteforce")
+  {
+    for (const char* password : {"", "a", "ab", "abc", "fff", "cafe"}) {
+      for (std::size_t threadCount : {1U, 2U, 3U, 8U}) {
+        CHECK(
+          itsp3::parallelBruteforce(
+            makePasswordChecker({password}), alphabet, threadCount)
+          == itsp3::bruteforce(makePasswordChecker({password}), alphabet));
+      }
+    }
+
+    CHECK(
+      itsp3::parallelBruteforce(
+        makePasswordChecker({"abc"}), itsp3::asciiAlphabet, 4U)
+      == "abc");
+  }
+
+  SUBCASE("prefers_the_shortest_and_first_match")
+  {
+    for (std::size_t threadCount : {1U, 2U, 5U, 16U}) {
+      CHECK(
+        itsp3::parallelBruteforce(
+          makePasswordChecker({"fe", "ab", "ba", "aaa"}), alphabet, threadCount)
+        == "ab");
+      CHECK(
+        itsp3::parallelBruteforce(
+          makePasswordChecker({"ffff", "eeee", "fffe"}), alphabet, threadCount)
+        == "eeee");
+    }
+  }
+
+  SUBCASE("batches_find_the_same_password_as_bruteforce")
+  {
+    // the index of the first candidate in a batch that matches.
+    auto makeBatchChecker = [](std::set<std::string> passwords) {
+      return [pws = std::move(passwords)](const itsp3::CandidateBatch& batch)
+               -> std::optional<std::size_t> {
+        for (std::size_t i{0U}; i < batch.size(); ++i) {
+          if (pws.count(std::string{batch[i]}) != 0U) {
+            return i;
+          }
+        }
+
+        return std::nullopt;
+      };
+    };
+
+    itsp3::ParallelBruteforceOptions options{};
+
+    for (std::size_t batchSize : {0U, 1U, 7U, 16U, 1000U}) {
+      for (std::size_t threadCount : {1U, 3U, 8U}) {
+        options.batchSize   = batchSize;
+        options.threadCount = threadCount;
+
+        CHECK(
+          itsp3::parallelBatchBruteforce(
+            makeBatchChecker({"fe", "ab", "ba", "aaa"}), alphabet, options)
+          == "ab");
+        CHECK(
+          itsp3::parallelBatchBruteforce(
+            makeBatchChecker({"ffff", "eeee", "fffe"}), alphabet, options)
+          == "eeee");
+      }
+    }
+  }
+
+  SUBCASE("slow_verifiers_receive_full_batches")
+  {
+    // the chunk sizes are tuned down to what is checked in 50 ms.
+    std::atomic<bool> allFull{true};
+    const auto        slowChecker
+      = [&allFull](
+          const itsp3::CandidateBatch& batch) -> std::optional<std::size_t> {
+      if (not batch.isFull()) {
+        allFull = false;
+      }
+
+      std::this_thread::sleep_for(std::chrono::milliseconds{20});
+
+      for (std::size_t i{0U}; i < batch.size(); ++i) {
+        if (batch[i] == "acf") {
+          return i;
+        }
+      }
+
+      return std::nullopt;
+    };
+
+    itsp3::ParallelBruteforceOptions options{};
+    options.minLength   = 3U;
+    options.maxLength   = 3U;
+    options.threadCount = 2U;
+    options.batchSize   = 8U;
+
+    CHECK(
+      itsp3::parallelBatchBruteforce(slowChecker, alphabet, options)
+      == "acf");
+    CHECK_UNARY(allFull.load());
+  }
+
+  SUBCASE("throws_if_there_is_no_match")
+  {
+    static constexpr auto tinyAlphabet = itsp3::makeAlphabet<'a', 'c'>();
+
+    CHECK_THROWS_AS(
+      itsp3::parallelBruteforce(makePasswordChecker({}), tinyAlphabet, 4U),
+      itsp3::NoMatchInBruteforceAlgorithmException);
+  }
+
+  SUBCASE("rethrows_exceptions_of_the_callable")
+  {
+    auto throwingChecker = [](std::string_view input) -> bool {
+      if (input == "cc") {
+        throw std::runtime_error{"failure"};
+      }
+
+      return false;
+    };
+
+    CHECK_THROWS_AS(
+      itsp3::parallelBruteforce(throwingChecker, alphabet, 4U),
+      std::runtime_error);
+  }
+
+  SUBCASE("respects_the_length_bounds")
+  {
+    itsp3::ParallelBruteforceOptions options{};
+    options.minLength   = 2U;
+    options.maxLength   = 8U;
+    options.threadCount = 3U;
+
+    // "a" is shorter than the minimum length.
+    CHECK(
+      itsp3::parallelBruteforce(
+        makePasswordChecker({"a", "bb", "ccc"}), alphabet, options)
+      == "bb");
+
+    // longer than the alphabet.
+    CHECK(
+      itsp3::parallelBruteforce(
+        makePasswordChecker({"ffffffff"}), alphabet, options)
+      == "ffffffff");
+
+    options.minLength = 3U;
+    options.maxLength = 4U;
+
+    bool hasThrown{false};
+
+    try {
+      itsp3::parallelBruteforce(
+        makePasswordChecker({"aa", "aaaaa"}), alphabet, options);
+    }
+    catch (const itsp3::KeyspaceExhaustedException& ex) {
+      hasThrown = true;
+      CHECK(ex.getMinLength() == 3U);
+      CHECK(ex.getMaxLength() == 4U);
+      CHECK(ex.getCandidateCount() == 6U * 6U * 6U + 6U * 6U * 6U * 6U);
+    }
+
+    CHECK_UNARY(hasThrown);
+  }
+}
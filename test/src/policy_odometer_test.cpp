@@ -0,0 +1,173 @@
+#include "check_password.hpp"  // itsp3::PasswordPolicy
+#include "odometer.hpp"        // itsp3::Odometer
+#include "policy_odometer.hpp" // itsp3::PolicyOdometer, ...
+#include <array>               // std::array
+#include <ciso646>             // not
+#include <cstddef>             // std::size_t
+#include <doctest.h>
+#include <string>      // std::string
+#include <string_view> // std::string_view
+#include <vector>      // std::vector
+
+namespace {
+constexpr std::array<char, 5U> alphabet{{'a', 'b', 'B', '1', '!'}};
+
+/*!
+ * \brief Module local function to generate the words of a length that
+ *        satisfy a policy by filtering the words of the Odometer.
+ * \param policy The policy.
+ * \param username The username.
+ * \param wordLength The word length.
+ * \return The words, in the order of the Odometer.
+ **/
+std::vector<std::string> filteredWords(
+  const itsp3::PasswordPolicy& policy,
+  const std::string&           username,
+  std::size_t                  wordLength)
+{
+  std::vector<std::string>         words{};
+  itsp3::Odometer<alphabet.size()> odometer{alphabet, wordLength};
+  odometer.reset(wordLength);
+
+  do {
+    if (policy.isSatisfiedBy(username, odometer.getWord())) {
+      words.push_back(odometer.getWord());
+    }
+  } while (odometer.advance());
+
+  return words;
+}
+
+/*!
+ * \brief Module local function to generate the words of a length with a
+ *        PolicyOdometer.
+ * \param policy The policy.
+ * \param username The username.
+ * \param wordLength The word length.
+ * \return The words generated.
+ **/
+std::vector<std::string> policyWords(
+  const itsp3::PasswordPolicy& policy,
+  const std::string&           username,
+  std::size_t                  wordLength)
+{
+  std::vector<std::string>               odometerWords{};
+  itsp3::PolicyOdometer<alphabet.size()> odometer{
+    alphabet, policy, username, wordLength};
+
+  if (not odometer.reset(wordLength)) {
+    return odometerWords;
+  }
+
+  do {
+    odometerWords.push_back(odometer.getWord());
+  } while (odometer.advance());
+
+  return odometerWords;
+}
+} // anonymous namespace
+
+TEST_CASE("password_policy_test")
+{
+  const itsp3::PasswordPolicy policy{};
+
+  CHECK_UNARY(policy.isSatisfiedBy("Peter", "abcdE1{}"));
+  CHECK_UNARY_FALSE(policy.isSatisfiedBy("Peter", "abcE1{}"));
+  CHECK_UNARY_FALSE(policy.isSatisfiedBy("Peter", "abcdeF{}"));
+  CHECK_UNARY_FALSE(policy.isSatisfiedBy("abcdE1{}", "abcdE1{}"));
+
+  CHECK_UNARY(itsp3::PasswordPolicy::none().isSatisfiedBy("Peter", ""));
+  CHECK_UNARY(itsp3::PasswordPolicy::none().isSatisfiedBy("Peter", "Peter"));
+
+  // the policy agrees with checkPassword.
+  for (const char* password :
+       {"", "abcdefgh", "ABCDEFG1234{", "abcdE1{}", "Peter", "aB1!aB1!"}) {
+    CHECK(
+      policy.isSatisfiedBy("Peter", password)
+      == (itsp3::checkPassword("Peter", password)
+          == itsp3::PasswordCheckingResult::Ok));
+  }
+}
+
+TEST_CASE("policy_odometer_test")
+{
+  itsp3::PasswordPolicy policy{};
+  policy.minLength = 0U;
+
+  SUBCASE("generates_the_same_words_as_filtering")
+  {
+    for (std::size_t wordLength{0U}; wordLength <= 6U; ++wordLength) {
+      CHECK(
+        policyWords(policy, "Peter", wordLength)
+        == filteredWords(policy, "Peter", wordLength));
+      CHECK(
+        policyWords(itsp3::PasswordPolicy::none(), "Peter", wordLength)
+        == filteredWords(itsp3::PasswordPolicy::none(), "Peter", wordLength));
+    }
+
+    policy.requiresSpecialCharacter = false;
+    policy.requiresNumber           = false;
+
+    for (std::size_t wordLength{0U}; wordLength <= 6U; ++wordLength) {
+      CHECK(
+        policyWords(policy, "Peter", wordLength)
+        == filteredWords(policy, "Peter", wordLength));
+    }
+  }
+
+  SUBCASE("prunes_words_that_cannot_satisfy_the_policy")
+  {
+    // only the 4 classes in some order, 'a' and 'b' being interchangeable.
+    CHECK(policyWords(policy, "Peter", 4U).size() == 2U * 24U);
+    CHECK(policyWords(policy, "Peter", 3U).empty());
+
+    policy.minLength = 5U;
+    CHECK(policyWords(policy, "Peter", 4U).empty());
+    CHECK_UNARY_FALSE(policyWords(policy, "Peter", 5U).empty());
+
+    // the alphabet lacks a class required.
+    const std::array<char, 3U>            lacking{{'a', 'B', '1'}};
+    itsp3::PolicyOdometer<lacking.size()> odometer{
+      lacking, itsp3::PasswordPolicy{}, "Peter", 10U};
+    CHECK_UNARY_FALSE(odometer.reset(10U));
+  }
+
+  SUBCASE("skips_the_username")
+  {
+    const std::vector<std::string> words{policyWords(policy, "aB1!", 4U)};
+
+    CHECK(words.size() == 2U * 24U - 1U);
+    CHECK(words.front() == "aB!1");
+
+    for (const std::string& word : words) {
+      CHECK(word != "aB1!");
+    }
+
+    // the first word is the username above.
+    CHECK(policyWords(policy, "Peter", 4U).front() == "aB1!");
+  }
+
+  SUBCASE("policy_bruteforce_only_tries_acceptable_words")
+  {
+    std::size_t candidateCount{0U};
+
+    CHECK(
+      itsp3::policyBruteforce(
+        [&candidateCount](std::string_view word) {
+          ++candidateCount;
+          return word == "b1!B";
+        },
+        alphabet,
+        policy,
+        "Peter",
+        4U)
+      == "b1!B");
+    // 6 words begin with 'a', then "bB1!", "bB!1", "b1B!".
+    CHECK(candidateCount == 10U);
+
+    CHECK_THROWS_AS(
+      itsp3::policyBruteforce(
+        [](std::string_view) { return false; }, alphabet, policy, "Peter", 5U),
+      itsp3::KeyspaceExhaustedException);
+  }
+}
@@ -0,0 +1,145 @@
+#include "alphabets.hpp"           // itsp3::makeAlphabet
+#include "parallel_bruteforce.hpp" // itsp3::parallelBruteforce
+#include "progress.hpp"            // itsp3::ProgressCounters, ...
+#include <chrono>                  // std::chrono::seconds, ...
+#include <cstdio>                  // std::remove
+#include <doctest.h>
+#include <fstream>     // std::ifstream
+#include <iterator>    // std::istreambuf_iterator
+#include <sstream>     // std::ostringstream
+#include <string>      // std::string
+#include <string_view> // std::string_view
+
+TEST_CASE("progress_test")
+{
+  SUBCASE("sums_up_the_workers")
+  {
+    itsp3::ProgressCounters counters{2U};
+    CHECK(counters.getWorkerCount() == 2U);
+
+    counters.beginWordLength(3U, 1000U, 100U);
+    counters.publish(0U, 50U, 10.0);
+    counters.publish(1U, 30U, 20.0);
+    counters.publish(0U, 20U, 10.0);
+
+    itsp3::ProgressSnapshot snapshot{counters.snapshot()};
+    CHECK(snapshot.wordLength == 3U);
+    CHECK(snapshot.lengthSize == 1000U);
+    CHECK(snapshot.searchedCount == 200U);
+    CHECK(snapshot.candidateCount == 100U);
+    CHECK(snapshot.candidatesPerSecond == 30.0);
+    REQUIRE(snapshot.workers.size() == 2U);
+    CHECK(snapshot.workers[0U].candidateCount == 70U);
+    CHECK(snapshot.workers[1U].candidateCount == 30U);
+    REQUIRE_UNARY(snapshot.eta.has_value());
+    // 800 candidates left at 30 candidates per second.
+    CHECK(
+      std::chrono::duration_cast<std::chrono::seconds>(*snapshot.eta).count()
+      == 26);
+
+    counters.beginWordLength(4U, 10000U, 0U);
+    counters.publish(1U, 5U, 20.0);
+
+    snapshot = counters.snapshot();
+    CHECK(snapshot.wordLength == 4U);
+    CHECK(snapshot.searchedCount == 5U);
+    CHECK(snapshot.candidateCount == 105U);
+  }
+
+  SUBCASE("no_eta_without_throughput")
+  {
+    itsp3::ProgressCounters counters{1U};
+    counters.beginWordLength(2U, 100U, 0U);
+
+    const itsp3::ProgressSnapshot snapshot{counters.snapshot()};
+    CHECK_UNARY_FALSE(snapshot.eta.has_value());
+
+    std::ostringstream oss{};
+    oss << snapshot;
+    CHECK(
+      oss.str() == "length 2: 0.00 % (0 / 100), 0.0 candidates/s, ETA unknown");
+  }
+
+  SUBCASE("prints_the_eta")
+  {
+    itsp3::ProgressSnapshot snapshot{};
+    snapshot.wordLength          = 6U;
+    snapshot.lengthSize          = 16000U;
+    snapshot.searchedCount       = 2000U;
+    snapshot.candidatesPerSecond = 5120.0;
+    snapshot.eta                 = std::chrono::seconds{3723};
+
+    std::ostringstream oss{};
+    oss << snapshot;
+    CHECK(
+      oss.str()
+      == "length 6: 12.50 % (2000 / 16000), 5120.0 candidates/s, "
+         "ETA 1h 2m 3s");
+  }
+
+  SUBCASE("writes_the_stats_file")
+  {
+    static constexpr char statsFile[] = "./progress_test.json";
+    std::remove(statsFile);
+
+    itsp3::ProgressCounters counters{2U};
+    counters.beginWordLength(3U, 1000U, 0U);
+    counters.publish(1U, 42U, 8.0);
+
+    REQUIRE_UNARY(itsp3::writeProgressStats(statsFile, counters.snapshot()));
+
+    std::ifstream     ifs{statsFile};
+    const std::string contents{
+      std::istreambuf_iterator<char>{ifs}, std::istreambuf_iterator<char>{}};
+    CHECK(contents.find("\"wordLength\": 3,") != std::string::npos);
+    CHECK(contents.find("\"lengthSize\": 1000,") != std::string::npos);
+    CHECK(contents.find("\"searchedCount\": 42,") != std::string::npos);
+    CHECK(contents.find("\"candidateCount\": 42,") != std::string::npos);
+    CHECK(
+      contents.find("{\"candidateCount\": 42, \"candidatesPerSecond\": 8}")
+      != std::string::npos);
+    CHECK(contents.back() == '\n');
+
+    std::remove(statsFile);
+  }
+
+  SUBCASE("parallel_bruteforce_publishes_its_progress")
+  {
+    static constexpr auto alphabet = itsp3::makeAlphabet<'a', 'd'>();
+
+    itsp3::ProgressCounters          counters{2U};
+    itsp3::ParallelBruteforceOptions options{};
+    options.maxLength   = 3U;
+    options.threadCount = 2U;
+    options.progress    = &counters;
+
+    CHECK_THROWS_AS(
+      itsp3::parallelBruteforce(
+        [](std::string_view) { return false; }, alphabet, options),
+      itsp3::KeyspaceExhaustedException);
+
+    const itsp3::ProgressSnapshot snapshot{counters.snapshot()};
+    CHECK(snapshot.wordLength == 3U);
+    CHECK(snapshot.lengthSize == 27U);
+    CHECK(snapshot.searchedCount == 27U);
+    CHECK(snapshot.candidateCount == 1U + 3U + 9U + 27U);
+  }
+
+  SUBCASE("reporter_ends_the_progress_line")
+  {
+    itsp3::ProgressCounters counters{1U};
+    counters.beginWordLength(1U, 10U, 0U);
+    std::ostringstream oss{};
+
+    {
+      const itsp3::ProgressReporter reporter{
+        counters, oss, "", std::chrono::milliseconds{1}};
+      counters.publish(0U, 10U, 100.0);
+    }
+
+    const std::string output{oss.str()};
+    CHECK(output.front() == '\r');
+    CHECK(output.back() == '\n');
+    CHECK(output.find("length 1: 100.00 % (10 / 10)") != std::string::npos);
+  }
+}
@@ -0,0 +1,124 @@
+#include "bcrypt.hpp"       // itsp3::Bcrypt
+#include "binary_io.hpp"    // itsp3::openFileForBinaryWriting
+#include "record.hpp"       // itsp3::Record
+#include "record_index.hpp" // itsp3::RecordIndex
+#include <chrono>           // std::chrono::steady_clock, std::chrono::seconds
+#include <cstdio>           // std::remove, std::rename
+#include <doctest.h>
+#include <fstream> // std::fstream
+#include <string>  // std::string, std::to_string
+#include <thread>  // std::this_thread::sleep_for
+
+namespace {
+constexpr char testFilePath[] = "./record_index_test.bin";
+
+void appendRecords(int first, int last, const char* filePath = testFilePath)
+{
+  std::fstream fs{};
+  REQUIRE_UNARY(
+    static_cast<bool>(itsp3::openFileForBinaryWriting(fs, filePath)));
+
+  for (int i{first}; i < last; ++i) {
+    const itsp3::Record record{"user" + std::to_string(i), "hash"};
+    REQUIRE_UNARY(static_cast<bool>(record.write(fs)));
+  }
+}
+} // anonymous namespace
+
+TEST_CASE("record_index_test")
+{
+  SUBCASE("refresh_only_parses_new_records")
+  {
+    itsp3::RecordIndex index{testFilePath};
+
+    CHECK(index.refresh() == 0U);
+
+    appendRecords(0, 10);
+    CHECK(index.refresh() == 10U);
+    const std::uint64_t indexedOffset{index.getIndexedOffset()};
+
+    appendRecords(10, 15);
+    CHECK(index.refresh() == 5U);
+    CHECK(index.getIndexedOffset() > indexedOffset);
+    CHECK(index.refresh() == 0U);
+
+    CHECK(index.getRecordCount() == 15U);
+    REQUIRE_UNARY(index.find("user14"));
+    CHECK(*index.find("user14") == "hash");
+    CHECK_UNARY_FALSE(index.find("user15"));
+
+    REQUIRE(std::remove(testFilePath) == 0);
+  }
+
+  SUBCASE("partial_records_are_indexed_once_complete")
+  {
+    itsp3::RecordIndex index{testFilePath};
+
+    appendRecords(0, 1);
+
+    std::fstream fs{};
+    REQUIRE_UNARY(
+      static_cast<bool>(itsp3::openFileForBinaryWriting(fs, testFilePath)));
+    fs << '\x05' << "use";
+    fs.flush();
+
+    CHECK(index.refresh() == 1U);
+    CHECK_UNARY_FALSE(index.find("userX"));
+
+    fs << "rX" << '\x01' << 'h';
+    fs.flush();
+
+    CHECK(index.refresh() == 1U);
+    CHECK_UNARY(index.find("userX"));
+    fs.close();
+
+    REQUIRE(std::remove(testFilePath) == 0);
+  }
+
+  SUBCASE("a_larger_file_renamed_over_the_file_is_indexed_from_scratch")
+  {
+    static constexpr char replacementFilePath[]
+      = "./record_index_test_new.bin";
+
+    itsp3::RecordIndex index{testFilePath};
+
+    appendRecords(0, 3);
+    CHECK(index.refresh() == 3U);
+
+    appendRecords(100, 110, replacementFilePath);
+    REQUIRE(std::rename(replacementFilePath, testFilePath) == 0);
+
+    CHECK(index.refresh() == 10U);
+    CHECK(index.getRecordCount() == 10U);
+    CHECK_UNARY_FALSE(index.find("user0"));
+    REQUIRE_UNARY(index.find("user109"));
+    CHECK(*index.find("user109") == "hash");
+
+    REQUIRE(std::remove(testFilePath) == 0);
+  }
+
+  SUBCASE("tail_following_picks_up_external_appends")
+  {
+    appendRecords(0, 3);
+
+    itsp3::Bcrypt bcrypt{testFilePath};
+    bcrypt.enableTailFollowing();
+    REQUIRE(bcrypt.getRecordIndex() != nullptr);
+    CHECK(bcrypt.getRecordIndex()->getRecordCount() == 3U);
+
+    // appended as if by another process, the watcher has to notice.
+    appendRecords(3, 6);
+
+    const auto deadline
+      = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+
+    while (bcrypt.getRecordIndex()->getRecordCount() != 6U
+           and std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+
+    CHECK(bcrypt.getRecordIndex()->getRecordCount() == 6U);
+
+    REQUIRE(std::remove(testFilePath) == 0);
+  }
+}
@@ -0,0 +1,188 @@
+#include "bcrypt.hpp"      // itsp3::Bcrypt
+#include "binary_io.hpp"   // itsp3::openFileForBinaryWriting
+#include "hashing_backend.hpp" // itsp3::BcryptLibraryBackend
+#include "record.hpp"      // itsp3::Record
+#include "replication.hpp" // itsp3::ReplicationPrimary, itsp3::ReplicationFollower
+#include <chrono>          // std::chrono::seconds, std::chrono::steady_clock
+#include <cstdint>         // std::uint64_t
+#include <cstdio>          // std::remove, std::rename
+#include <doctest.h>
+#include <fstream>  // std::fstream, std::ifstream
+#include <iterator> // std::istreambuf_iterator
+#include <memory>   // std::unique_ptr, std::make_unique
+#include <string>   // std::string, std::to_string
+#include <thread>   // std::this_thread::sleep_for
+#include <vector>   // std::vector
+
+namespace {
+std::string readFile(const char* path)
+{
+  std::ifstream ifs{path, std::ios_base::in | std::ios_base::binary};
+  return std::string(
+    std::istreambuf_iterator<char>{ifs}, std::istreambuf_iterator<char>{});
+}
+
+std::uint64_t appendRecords(const char* path, int first, int last)
+{
+  std::fstream fs{};
+  REQUIRE_UNARY(static_cast<bool>(itsp3::openFileForBinaryWriting(fs, path)));
+
+  for (int i{first}; i < last; ++i) {
+    const itsp3::Record record{
+      "user" + std::to_string(i), std::string(64U, static_cast<char>(i))};
+    REQUIRE_UNARY(static_cast<bool>(record.write(fs)));
+  }
+
+  fs.close();
+  return readFile(path).size();
+}
+
+bool waitForIdenticalCopy(const char* followerFile, const char* primaryFile)
+{
+  const auto deadline
+    = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+
+  while (readFile(followerFile) != readFile(primaryFile)) {
+    if (std::chrono::steady_clock::now() >= deadline) {
+      return false;
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+  }
+
+  return true;
+}
+} // anonymous namespace
+
+TEST_CASE("replication_test")
+{
+  static constexpr char primaryFile[] = "./replication_primary.bin";
+  static constexpr char socketPath[]  = "./replication_test.sock";
+  static const char* const followerFiles[]
+    = {"./replication_follower0.bin", "./replication_follower1.bin"};
+  static constexpr std::chrono::seconds timeout{10};
+
+  itsp3::ReplicationPrimary primary{primaryFile, socketPath};
+  primary.start();
+
+  SUBCASE("followers_receive_existing_and_appended_records")
+  {
+    const std::uint64_t initialSize{appendRecords(primaryFile, 0, 100)};
+
+    std::vector<std::unique_ptr<itsp3::ReplicationFollower>> followers{};
+
+    for (const char* followerFile : followerFiles) {
+      followers.push_back(
+        std::make_unique<itsp3::ReplicationFollower>(followerFile, socketPath));
+      followers.back()->start();
+    }
+
+    for (const auto& follower : followers) {
+      REQUIRE_UNARY(follower->waitForOffset(initialSize, timeout));
+      CHECK(follower->getLagBytes() == 0U);
+    }
+
+    const std::uint64_t appendedSize{appendRecords(primaryFile, 100, 150)};
+
+    for (const auto& follower : followers) {
+      REQUIRE_UNARY(follower->waitForOffset(appendedSize, timeout));
+      CHECK_UNARY(follower->isConnected());
+    }
+
+    followers.clear();
+
+    for (const char* followerFile : followerFiles) {
+      CHECK(readFile(followerFile) == readFile(primaryFile));
+      REQUIRE(std::remove(followerFile) == 0);
+    }
+
+    REQUIRE(std::remove(primaryFile) == 0);
+  }
+
+  SUBCASE("follower_resumes_from_its_local_copy")
+  {
+    const std::uint64_t initialSize{appendRecords(primaryFile, 0, 10)};
+
+    {
+      itsp3::ReplicationFollower follower{followerFiles[0U], socketPath};
+      follower.start();
+      REQUIRE_UNARY(follower.waitForOffset(initialSize, timeout));
+    }
+
+    const std::uint64_t appendedSize{appendRecords(primaryFile, 10, 20)};
+
+    itsp3::ReplicationFollower follower{followerFiles[0U], socketPath};
+    follower.start();
+    CHECK(follower.getReplicatedOffset() == initialSize);
+    REQUIRE_UNARY(follower.waitForOffset(appendedSize, timeout));
+    follower.stop();
+
+    CHECK(readFile(followerFiles[0U]) == readFile(primaryFile));
+
+    REQUIRE(std::remove(followerFiles[0U]) == 0);
+    REQUIRE(std::remove(primaryFile) == 0);
+  }
+
+  SUBCASE("follower_starts_over_if_the_primary_file_is_replaced")
+  {
+    static constexpr char replacementFile[]
+      = "./replication_primary_new.bin";
+
+    const std::uint64_t initialSize{appendRecords(primaryFile, 0, 10)};
+
+    itsp3::ReplicationFollower follower{followerFiles[0U], socketPath};
+    follower.start();
+    REQUIRE_UNARY(follower.waitForOffset(initialSize, timeout));
+
+    // larger, so that the old offset is within the new file.
+    const std::uint64_t replacementSize{
+      appendRecords(replacementFile, 100, 120)};
+    REQUIRE(std::rename(replacementFile, primaryFile) == 0);
+
+    REQUIRE_UNARY(follower.waitForOffset(replacementSize, timeout));
+    CHECK_UNARY(waitForIdenticalCopy(followerFiles[0U], primaryFile));
+    CHECK_UNARY(follower.isConnected());
+    follower.stop();
+
+    REQUIRE(std::remove(followerFiles[0U]) == 0);
+    REQUIRE(std::remove(primaryFile) == 0);
+  }
+
+  SUBCASE("follower_ahead_of_the_primary_starts_over")
+  {
+    appendRecords(followerFiles[0U], 0, 20);
+    appendRecords(primaryFile, 100, 105);
+
+    itsp3::ReplicationFollower follower{followerFiles[0U], socketPath};
+    follower.start();
+    CHECK_UNARY(waitForIdenticalCopy(followerFiles[0U], primaryFile));
+    CHECK_UNARY(follower.isConnected());
+    follower.stop();
+
+    CHECK(follower.getReplicatedOffset() == readFile(primaryFile).size());
+
+    REQUIRE(std::remove(followerFiles[0U]) == 0);
+    REQUIRE(std::remove(primaryFile) == 0);
+  }
+
+  SUBCASE("follower_serves_password_checks")
+  {
+    itsp3::Bcrypt bcrypt{
+      primaryFile,
+      std::make_shared<itsp3::BcryptLibraryBackend>(
+        itsp3::BcryptLibraryBackend::s_minimumWorkFactor)};
+    REQUIRE_UNARY(bcrypt.addUser("Peter", "passwordA1{"));
+
+    itsp3::ReplicationFollower follower{followerFiles[0U], socketPath};
+    follower.start();
+    REQUIRE_UNARY(follower.waitForOffset(readFile(primaryFile).size(), timeout));
+
+    CHECK_UNARY(follower.checkPasswordValidity("Peter", "passwordA1{"));
+    CHECK_UNARY_FALSE(follower.checkPasswordValidity("Peter", "dummybA1{"));
+    CHECK_UNARY_FALSE(follower.checkPasswordValidity("Hannes", "geheimA1{"));
+    follower.stop();
+
+    REQUIRE(std::remove(followerFiles[0U]) == 0);
+    REQUIRE(std::remove(primaryFile) == 0);
+  }
+}
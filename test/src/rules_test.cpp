@@ -0,0 +1,95 @@
+#include "dictionary_attack.hpp" // itsp3::dictionaryAttack
+#include "rules.hpp"             // itsp3::Rule, itsp3::RuleSet
+#include <atomic>                // std::atomic
+#include <doctest.h>
+#include <string>      // std::string
+#include <string_view> // std::string_view
+
+namespace {
+std::string apply(std::string_view rule, std::string_view word)
+{
+  std::string buffer{};
+  itsp3::Rule::parse(rule).apply(word, buffer);
+  return buffer;
+}
+} // anonymous namespace
+
+TEST_CASE("rules_test")
+{
+  SUBCASE("operations")
+  {
+    CHECK(apply(":", "pAssWord") == "pAssWord");
+    CHECK(apply("", "pAssWord") == "pAssWord");
+    CHECK(apply("l", "pAssWord1") == "password1");
+    CHECK(apply("u", "pAssWord1") == "PASSWORD1");
+    CHECK(apply("c", "pAssWord1") == "Password1");
+    CHECK(apply("C", "pAssWord1") == "pASSWORD1");
+    CHECK(apply("t", "pAssWord1") == "PaSSwORD1");
+    CHECK(apply("T0", "pAssWord") == "PAssWord");
+    CHECK(apply("TA", "pAssWord") == "pAssWord"); // beyond the end
+    CHECK(apply("r", "abc") == "cba");
+    CHECK(apply("d", "abc") == "abcabc");
+    CHECK(apply("$!", "abc") == "abc!");
+    CHECK(apply("^!", "abc") == "!abc");
+    CHECK(apply("[", "abc") == "bc");
+    CHECK(apply("]", "abc") == "ab");
+    CHECK(apply("[", "") == "");
+    CHECK(apply("so0", "foo") == "f00");
+    CHECK(apply("s$s", "a$b$") == "asbs");
+  }
+
+  SUBCASE("operations_are_applied_in_order")
+  {
+    CHECK(apply("c $1 $2 $3 $!", "password") == "Password123!");
+    CHECK(apply("r c", "drowssap") == "Password");
+    CHECK(apply("d ] ]", "ab") == "ab");
+    CHECK(apply("$ ", "ab") == "ab "); // the argument may be a space
+  }
+
+  SUBCASE("rejects_invalid_rules")
+  {
+    CHECK_THROWS_AS(itsp3::Rule::parse("x"), itsp3::RuleParseException);
+    CHECK_THROWS_AS(itsp3::Rule::parse("$"), itsp3::RuleParseException);
+    CHECK_THROWS_AS(itsp3::Rule::parse("sa"), itsp3::RuleParseException);
+    CHECK_THROWS_AS(itsp3::Rule::parse("T!"), itsp3::RuleParseException);
+    CHECK_THROWS_AS(
+      itsp3::RuleSet::parse(":\nc\nq\n"), itsp3::RuleParseException);
+  }
+
+  SUBCASE("rule_set")
+  {
+    const itsp3::RuleSet rules{
+      itsp3::RuleSet::parse("# comment\n:\r\n\nc\nc $1\n")};
+    CHECK(rules.size() == 3U);
+  }
+
+  SUBCASE("dictionary_attack_with_rules")
+  {
+    const itsp3::RuleSet rules{itsp3::RuleSet::parse(":\nc\nc $1\nc $1 $!\n")};
+
+    for (std::size_t threadCount : {1U, 4U}) {
+      itsp3::DictionaryAttackOptions options{};
+      options.threadCount = threadCount;
+      options.rules       = &rules;
+
+      CHECK(
+        itsp3::dictionaryAttack(
+          [](std::string_view word) { return word == "Summer1!"; },
+          "winter\nspring\nsummer\nautumn\n",
+          options)
+        == "Summer1!");
+
+      std::atomic<std::size_t> candidateCount{0U};
+      CHECK_THROWS_AS(
+        itsp3::dictionaryAttack(
+          [&candidateCount](std::string_view) {
+            ++candidateCount;
+            return false;
+          },
+          "winter\nspring\nsummer\nautumn\n",
+          options),
+        itsp3::WordlistExhaustedException);
+      CHECK(candidateCount.load() == 4U * 4U);
+    }
+  }
+}
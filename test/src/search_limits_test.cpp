@@ -0,0 +1,178 @@
+#include "alphabets.hpp"     // itsp3::asciiAlphabet, itsp3::makeAlphabet
+#include "bruteforce.hpp"    // itsp3::limitedBruteforce
+#include "search_limits.hpp" // itsp3::CancellationToken, ...
+#include <chrono>            // std::chrono::seconds
+#include <cstdint>           // std::uint64_t
+#include <doctest.h>
+#include <optional>    // std::nullopt
+#include <sstream>     // std::ostringstream
+#include <string>      // std::string
+#include <string_view> // std::string_view
+#include <vector>      // std::vector
+
+TEST_CASE("search_limits_test")
+{
+  static constexpr auto alphabet = itsp3::makeAlphabet<'a', 'd'>();
+
+  const auto never = [](std::string_view) { return false; };
+
+  itsp3::BruteforceOptions options{};
+  options.maxLength = 3U;
+
+  SUBCASE("exhausts_the_keyspace")
+  {
+    const itsp3::BruteforceResult result{
+      itsp3::limitedBruteforce(never, alphabet, options)};
+    CHECK(result.status == itsp3::BruteforceResult::Status::Exhausted);
+    CHECK(result.candidateCount == 1U + 3U + 9U + 27U);
+    CHECK_UNARY_FALSE(result.match.has_value());
+    CHECK_UNARY_FALSE(result.stopReason.has_value());
+    CHECK_UNARY_FALSE(result.resumePoint.has_value());
+  }
+
+  SUBCASE("finds_the_match")
+  {
+    const itsp3::BruteforceResult result{itsp3::limitedBruteforce(
+      [](std::string_view word) { return word == "ba"; }, alphabet, options)};
+    CHECK(result.status == itsp3::BruteforceResult::Status::Found);
+    REQUIRE_UNARY(result.match.has_value());
+    CHECK(*result.match == "ba");
+    CHECK(result.candidateCount == 1U + 3U + 4U);
+  }
+
+  SUBCASE("stops_at_the_budget_and_resumes")
+  {
+    options.limits.candidateBudget = 6U;
+
+    const itsp3::BruteforceResult stopped{
+      itsp3::limitedBruteforce(never, alphabet, options)};
+    CHECK(stopped.status == itsp3::BruteforceResult::Status::Stopped);
+    REQUIRE_UNARY(stopped.stopReason.has_value());
+    CHECK(*stopped.stopReason == itsp3::StopReason::BudgetExhausted);
+    CHECK(stopped.candidateCount == 6U);
+    REQUIRE_UNARY(stopped.resumePoint.has_value());
+
+    // "", "a", "b", "c", "aa" and "ab" were tried, "ac" is next.
+    CHECK(stopped.resumePoint->wordLength == 2U);
+    CHECK(stopped.resumePoint->index == 2U);
+
+    options.limits.candidateBudget = std::nullopt;
+    options.resumeFrom             = stopped.resumePoint;
+
+    const itsp3::BruteforceResult resumed{itsp3::limitedBruteforce(
+      [](std::string_view word) { return word == "ba"; }, alphabet, options)};
+    CHECK(resumed.status == itsp3::BruteforceResult::Status::Found);
+    REQUIRE_UNARY(resumed.match.has_value());
+    CHECK(*resumed.match == "ba");
+    CHECK(resumed.candidateCount == 2U);
+  }
+
+  SUBCASE("resumed_runs_try_every_word_once")
+  {
+    std::vector<std::string> expected{};
+    itsp3::limitedBruteforce(
+      [&expected](std::string_view word) {
+        expected.emplace_back(word);
+        return false;
+      },
+      alphabet,
+      options);
+
+    std::vector<std::string> words{};
+    const auto               collect = [&words](std::string_view word) {
+      words.emplace_back(word);
+      return false;
+    };
+
+    options.limits.candidateBudget = 7U;
+    itsp3::BruteforceResult result{
+      itsp3::limitedBruteforce(collect, alphabet, options)};
+
+    while (result.status == itsp3::BruteforceResult::Status::Stopped) {
+      options.resumeFrom = result.resumePoint;
+      result             = itsp3::limitedBruteforce(collect, alphabet, options);
+    }
+
+    CHECK(result.status == itsp3::BruteforceResult::Status::Exhausted);
+    CHECK(words == expected);
+  }
+
+  SUBCASE("ignores_resume_points_shorter_than_the_minimum")
+  {
+    options.minLength  = 2U;
+    options.resumeFrom = itsp3::ResumePoint{1U, 2U};
+
+    const itsp3::BruteforceResult result{
+      itsp3::limitedBruteforce(never, alphabet, options)};
+    CHECK(result.candidateCount == 9U + 27U);
+  }
+
+  SUBCASE("zero_budget")
+  {
+    options.minLength              = 1U;
+    options.limits.candidateBudget = 0U;
+
+    const itsp3::BruteforceResult result{
+      itsp3::limitedBruteforce(never, alphabet, options)};
+    CHECK(result.status == itsp3::BruteforceResult::Status::Stopped);
+    CHECK(result.candidateCount == 0U);
+    REQUIRE_UNARY(result.resumePoint.has_value());
+    CHECK(result.resumePoint->wordLength == 1U);
+    CHECK(result.resumePoint->index == 0U);
+  }
+
+  SUBCASE("stops_when_cancelled")
+  {
+    itsp3::CancellationToken token{};
+    CHECK_UNARY_FALSE(token.isCancelled());
+
+    std::uint64_t callCount{0U};
+    options.maxLength           = 4U;
+    options.limits.cancellation = &token;
+
+    const itsp3::BruteforceResult result{itsp3::limitedBruteforce(
+      [&token, &callCount](std::string_view) {
+        if (++callCount == 10U) {
+          token.cancel();
+        }
+
+        return false;
+      },
+      itsp3::asciiAlphabet,
+      options)};
+    CHECK_UNARY(token.isCancelled());
+    CHECK(result.status == itsp3::BruteforceResult::Status::Stopped);
+    REQUIRE_UNARY(result.stopReason.has_value());
+    CHECK(*result.stopReason == itsp3::StopReason::Cancelled);
+    CHECK(result.candidateCount == callCount);
+    CHECK(result.candidateCount >= 10U);
+
+    const itsp3::BruteforceResult again{
+      itsp3::limitedBruteforce(never, alphabet, options)};
+    CHECK(again.status == itsp3::BruteforceResult::Status::Stopped);
+    CHECK(again.candidateCount == 0U);
+  }
+
+  SUBCASE("stops_at_the_deadline")
+  {
+    options.limits.deadline
+      = itsp3::SearchLimits::clock::now() - std::chrono::seconds{1};
+
+    const itsp3::BruteforceResult result{
+      itsp3::limitedBruteforce(never, alphabet, options)};
+    CHECK(result.status == itsp3::BruteforceResult::Status::Stopped);
+    REQUIRE_UNARY(result.stopReason.has_value());
+    CHECK(*result.stopReason == itsp3::StopReason::DeadlineReached);
+    CHECK(result.candidateCount == 0U);
+  }
+
+  SUBCASE("prints_the_stop_reason")
+  {
+    std::ostringstream oss{};
+    oss << itsp3::StopReason::Cancelled << ", "
+        << itsp3::StopReason::DeadlineReached << ", "
+        << itsp3::StopReason::BudgetExhausted;
+    CHECK(
+      oss.str() == "cancelled, deadline reached, candidate budget exhausted");
+  }
+}
@@ -0,0 +1,224 @@
+#include "alphabets.hpp"           // itsp3::makeAlphabet
+#include "bcrypt.hpp"              // itsp3::Bcrypt
+#include "hashing_backend.hpp"     // itsp3::BcryptLibraryBackend
+#include "parallel_bruteforce.hpp" // itsp3::parallelBruteforce, ...
+#include "target_set.hpp"          // itsp3::TargetSet
+#include <cstddef>                 // std::size_t
+#include <cstdio>                  // std::remove
+#include <doctest.h>
+#include <map>         // std::map
+#include <memory>      // std::shared_ptr, std::make_shared
+#include <string>      // std::string
+#include <string_view> // std::string_view
+#include <utility>     // std::move
+#include <vector>      // std::vector
+
+namespace {
+/*!
+ * \brief Module local function to create the CrackTarget of a user.
+ * \param backend The backend to hash with.
+ * \param username The username.
+ * \param password The password of the user.
+ * \return The CrackTarget.
+ **/
+itsp3::CrackTarget makeTarget(
+  const std::shared_ptr<itsp3::BcryptLibraryBackend>& backend,
+  const std::string&                                  username,
+  const std::string&                                  password)
+{
+  itsp3::HashBuffer salt{};
+  itsp3::HashBuffer hash{};
+  REQUIRE_UNARY(backend->generateSalt(salt));
+  REQUIRE_UNARY(backend->hash((username + password).c_str(), salt, hash));
+  return itsp3::CrackTarget{username, hash.data()};
+}
+} // anonymous namespace
+
+TEST_CASE("target_set_test")
+{
+  const std::shared_ptr<itsp3::BcryptLibraryBackend> backend{
+    std::make_shared<itsp3::BcryptLibraryBackend>(
+      itsp3::BcryptLibraryBackend::s_minimumWorkFactor)};
+
+  SUBCASE("cracks_all_the_targets_in_one_run")
+  {
+    static constexpr auto alphabet = itsp3::makeAlphabet<'a', 'd'>();
+
+    std::vector<itsp3::CrackTarget> targets{};
+    targets.push_back(makeTarget(backend, "Peter", "cab"));
+    targets.push_back(makeTarget(backend, "Hannes", "b"));
+    targets.push_back(makeTarget(backend, "Uwe", "ba"));
+
+    std::map<std::string, std::string> cracked{};
+    itsp3::TargetSet                   targetSet{
+      std::move(targets),
+      [&cracked](const itsp3::CrackTarget& target, std::string_view password) {
+        cracked.emplace(target.getUsername(), std::string{password});
+      }};
+
+    CHECK(targetSet.getRemainingCount() == 3U);
+
+    itsp3::ParallelBruteforceOptions options{};
+    options.maxLength   = 3U;
+    options.threadCount = 2U;
+    itsp3::parallelBruteforce(
+      [&targetSet](std::string_view test) { return targetSet.check(test); },
+      alphabet,
+      options);
+
+    CHECK(targetSet.getRemainingCount() == 0U);
+    CHECK(
+      cracked
+      == std::map<std::string, std::string>{
+           {"Peter", "cab"}, {"Hannes", "b"}, {"Uwe", "ba"}});
+
+    for (std::size_t i{0U}; i < targetSet.getTargets().size(); ++i) {
+      CHECK_UNARY(targetSet.isCracked(i));
+    }
+  }
+
+  SUBCASE("cracks_all_the_targets_in_batches")
+  {
+    static constexpr auto alphabet = itsp3::makeAlphabet<'a', 'd'>();
+
+    std::vector<itsp3::CrackTarget> targets{};
+    targets.push_back(makeTarget(backend, "Peter", "cab"));
+    targets.push_back(makeTarget(backend, "Hannes", "b"));
+    targets.push_back(makeTarget(backend, "Uwe", "ba"));
+
+    std::map<std::string, std::string> cracked{};
+    itsp3::TargetSet                   targetSet{
+      std::move(targets),
+      [&cracked](const itsp3::CrackTarget& target, std::string_view password) {
+        cracked.emplace(target.getUsername(), std::string{password});
+      }};
+
+    itsp3::ParallelBruteforceOptions options{};
+    options.maxLength   = 3U;
+    options.threadCount = 2U;
+    options.batchSize   = 8U;
+
+    // stops once all the targets are cracked.
+    CHECK_NOTHROW(itsp3::parallelBatchBruteforce(
+      [&targetSet](const itsp3::CandidateBatch& batch) {
+        return targetSet.checkBatch(batch);
+      },
+      alphabet,
+      options));
+
+    CHECK(targetSet.getRemainingCount() == 0U);
+    CHECK(
+      cracked
+      == std::map<std::string, std::string>{
+           {"Peter", "cab"}, {"Hannes", "b"}, {"Uwe", "ba"}});
+  }
+
+  SUBCASE("reports_the_targets_not_cracked")
+  {
+    static constexpr auto alphabet = itsp3::makeAlphabet<'a', 'c'>();
+
+    std::vector<itsp3::CrackTarget> targets{};
+    targets.push_back(makeTarget(backend, "Peter", "ab"));
+    targets.push_back(makeTarget(backend, "Hannes", "c"));
+
+    std::size_t      crackedCount{0U};
+    itsp3::TargetSet targetSet{
+      std::move(targets),
+      [&crackedCount](const itsp3::CrackTarget&, std::string_view) {
+        ++crackedCount;
+      }};
+
+    itsp3::ParallelBruteforceOptions options{};
+    options.maxLength = 2U;
+
+    CHECK_THROWS_AS(
+      itsp3::parallelBruteforce(
+        [&targetSet](std::string_view test) { return targetSet.check(test); },
+        alphabet,
+        options),
+      itsp3::KeyspaceExhaustedException);
+
+    CHECK(crackedCount == 1U);
+    CHECK(targetSet.getRemainingCount() == 1U);
+    CHECK_UNARY(targetSet.isCracked(0U));
+    CHECK_UNARY_FALSE(targetSet.isCracked(1U));
+  }
+
+  SUBCASE("skips_candidates_the_policy_rejects")
+  {
+    itsp3::PasswordPolicy policy{itsp3::PasswordPolicy::none()};
+    policy.minLength = 3U;
+
+    std::vector<itsp3::CrackTarget> targets{};
+    targets.push_back(makeTarget(backend, "Peter", "ab"));
+
+    itsp3::TargetSet targetSet{std::move(targets), nullptr, policy};
+
+    CHECK_UNARY_FALSE(targetSet.check("ab"));
+    CHECK(targetSet.getRemainingCount() == 1U);
+  }
+
+  SUBCASE("checks_truncated_passwords_once")
+  {
+    itsp3::PasswordPolicy policy{itsp3::PasswordPolicy::none()};
+    policy.requiresNumber = true;
+
+    // only the first 8 characters of the password are used.
+    const std::string username(BCRYPT_HASHSIZE, 'u');
+
+    std::vector<itsp3::CrackTarget> targets{};
+    targets.push_back(makeTarget(backend, username, "abcdefgh1"));
+
+    std::string      password{};
+    itsp3::TargetSet targetSet{
+      std::move(targets),
+      [&password](const itsp3::CrackTarget&, std::string_view candidate) {
+        password = candidate;
+      },
+      policy};
+    CHECK(targetSet.getMaxPasswordLength() == 8U);
+
+    // has the same hash as "abcdefgh", which is the one checked.
+    CHECK_UNARY_FALSE(targetSet.check("abcdefgh1"));
+    CHECK_UNARY(targetSet.check("abcdefgh"));
+    CHECK(password == "abcdefgh");
+
+    std::vector<itsp3::CrackTarget> both{};
+    both.push_back(makeTarget(backend, username, "a"));
+    both.push_back(makeTarget(backend, "Peter", "a"));
+    CHECK(
+      itsp3::TargetSet{std::move(both), nullptr}.getMaxPasswordLength()
+      == BCRYPT_HASHSIZE);
+  }
+
+  SUBCASE("prepares_the_targets_of_the_binary_file")
+  {
+    static constexpr char testBinFile[] = "./target_set_test.bin";
+    std::remove(testBinFile);
+
+    {
+      itsp3::Bcrypt bcrypt{testBinFile, backend};
+      REQUIRE_UNARY(bcrypt.addUser("Peter", "dummybA1{"));
+      REQUIRE_UNARY(bcrypt.addUser("Hannes", "dummybA1{"));
+      REQUIRE_UNARY(bcrypt.addUser("Uwe", "dummybA1{"));
+
+      const std::vector<itsp3::CrackTarget> all{bcrypt.prepareCrackTargets()};
+      REQUIRE(all.size() == 3U);
+      CHECK(all[0U].getUsername() == "Peter");
+      CHECK(all[1U].getUsername() == "Hannes");
+      CHECK(all[2U].getUsername() == "Uwe");
+      CHECK_UNARY(all[1U].check("dummybA1{"));
+
+      const std::vector<itsp3::CrackTarget> filtered{
+        bcrypt.prepareCrackTargets(
+          [](std::string_view username) { return username != "Hannes"; })};
+      REQUIRE(filtered.size() == 2U);
+      CHECK(filtered[0U].getUsername() == "Peter");
+      CHECK(filtered[1U].getUsername() == "Uwe");
+    }
+
+    std::remove(testBinFile);
+    itsp3::Bcrypt bcrypt{testBinFile, backend};
+    CHECK_UNARY(bcrypt.prepareCrackTargets().empty());
+  }
+}
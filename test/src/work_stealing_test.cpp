@@ -0,0 +1,110 @@
+#include "work_stealing.hpp" // itsp3::WorkStealingScheduler, ...
+#include <chrono>            // std::chrono::milliseconds, std::chrono::seconds
+#include <cstddef>           // std::size_t
+#include <cstdint>           // std::uint64_t
+#include <doctest.h>
+#include <optional> // std::optional
+#include <vector>   // std::vector
+
+TEST_CASE("work_stealing_test")
+{
+  SUBCASE("hands_out_every_index_exactly_once")
+  {
+    for (std::size_t workerCount : {1U, 2U, 3U, 7U}) {
+      static constexpr std::size_t wordCount{1000U};
+
+      itsp3::WorkStealingScheduler scheduler{wordCount, workerCount};
+      std::vector<int>             timesHandedOut(wordCount, 0);
+
+      // only the last worker asks for work, so it has to steal from all
+      // the others.
+      while (const std::optional<itsp3::KeyspaceRange> chunk{
+               scheduler.next(workerCount - 1U, 3U)}) {
+        REQUIRE(chunk->begin < chunk->end);
+        REQUIRE(chunk->end - chunk->begin <= 3U);
+
+        for (itsp3::KeyspaceIndex i{chunk->begin}; i != chunk->end; ++i) {
+          ++timesHandedOut[static_cast<std::size_t>(i)];
+        }
+      }
+
+      for (int times : timesHandedOut) {
+        CHECK(times == 1);
+      }
+    }
+  }
+
+  SUBCASE("owners_start_with_their_own_share")
+  {
+    itsp3::WorkStealingScheduler scheduler{10U, 2U};
+
+    const std::optional<itsp3::KeyspaceRange> first{scheduler.next(0U, 2U)};
+    const std::optional<itsp3::KeyspaceRange> second{scheduler.next(1U, 2U)};
+
+    REQUIRE(first.has_value());
+    REQUIRE(second.has_value());
+    CHECK(first->begin == 0U);
+    CHECK(first->end == 2U);
+    CHECK(second->begin == 5U);
+    CHECK(second->end == 7U);
+  }
+
+  SUBCASE("truncate_drops_the_work_beyond_the_index")
+  {
+    itsp3::WorkStealingScheduler scheduler{100U, 4U};
+    scheduler.truncate(30U);
+
+    std::size_t handedOut{0U};
+
+    for (std::size_t worker{0U}; worker < 4U; ++worker) {
+      while (const std::optional<itsp3::KeyspaceRange> chunk{
+               scheduler.next(worker, 7U)}) {
+        CHECK(chunk->end <= 30U);
+        handedOut += static_cast<std::size_t>(chunk->end - chunk->begin);
+      }
+    }
+
+    CHECK(handedOut == 30U);
+  }
+
+  SUBCASE("chunk_size_tuner")
+  {
+    itsp3::ChunkSizeTuner tuner{std::chrono::milliseconds{100}};
+
+    CHECK(tuner.getChunkSize() == 1U);
+    CHECK(tuner.getCandidatesPerSecond() == 0.0);
+
+    // 1000 candidates per second -> 100 candidates per chunk, reached by
+    // doubling.
+    std::uint64_t previous{tuner.getChunkSize()};
+
+    for (int i{0}; i < 10; ++i) {
+      tuner.update(100U, std::chrono::milliseconds{100});
+      CHECK(tuner.getChunkSize() <= 2U * previous);
+      previous = tuner.getChunkSize();
+    }
+
+    CHECK(tuner.getChunkSize() == 100U);
+    CHECK(tuner.getCandidatesPerSecond() > 999.0);
+    CHECK(tuner.getCandidatesPerSecond() < 1001.0);
+
+    // empty measurements are ignored.
+    tuner.update(0U, std::chrono::milliseconds{100});
+    tuner.update(100U, std::chrono::milliseconds{0});
+    CHECK(tuner.getChunkSize() == 100U);
+
+    // chunks of whole granules, even if a granule takes longer than a
+    // chunk should.
+    itsp3::ChunkSizeTuner granular{std::chrono::milliseconds{100}, 16U};
+    CHECK(granular.getChunkSize() == 16U);
+    granular.update(16U, std::chrono::seconds{1});
+    CHECK(granular.getChunkSize() == 16U);
+
+    for (int i{0}; i < 10; ++i) {
+      granular.update(1000U, std::chrono::milliseconds{100});
+      CHECK(granular.getChunkSize() % 16U == 0U);
+    }
+
+    CHECK(granular.getChunkSize() > 16U);
+  }
+}